@@ -0,0 +1,61 @@
+#pragma once
+
+#include "gl.hpp"
+
+namespace gpupro {
+
+	// A set of resource bindings: textures, samplers, uniform and shader
+	// storage buffers. The OGLContext compares a table with the current
+	// bindings and binds each contiguous range of changed slots with a
+	// single multi-bind call (ARB_multi_bind, core since 4.4).
+	//
+	// Textures and buffers describe the complete binding set: slots which
+	// are not set are unbound when the table is applied. Samplers only
+	// override the samplers of the pipeline for the slots set here.
+	//
+	// The table stores GL names. Set a slot again if the object is replaced
+	// (e.g. after a GpuVector grew). Do not mix tables with the bindAs*()
+	// methods of the resources, because the context cannot see those.
+	class BindingTable
+	{
+	public:
+		// 64 textures is very high. It might be that your GPU does not support
+		// that many. Have a look at GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS.
+		static const int MAX_TEXTURES = 64;
+		// The guaranteed minimum for shader storage buffers is only 8.
+		// OGLContext::setBindings() rejects bindings above
+		// GL_MAX_UNIFORM_BUFFER_BINDINGS and GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS.
+		static const int MAX_BUFFERS = 32;
+
+		// Set a slot or clear it with nullptr.
+		void setTexture(GLuint _unit, class Texture* _texture);
+		void setSampler(GLuint _unit, class SamplerState* _sampler);
+		// _offset, _size: range in bytes. The default size binds everything
+		// behind _offset.
+		void setUniformBuffer(GLuint _bindingIndex, class Buffer* _buffer, GLintptr _offset = 0, GLsizeiptr _size = GLsizeiptr(-1));
+		void setShaderStorageBuffer(GLuint _bindingIndex, class Buffer* _buffer, GLintptr _offset = 0, GLsizeiptr _size = GLsizeiptr(-1));
+
+		// Remove all bindings.
+		void clear();
+	private:
+		friend class OGLContext;
+
+		struct BufferRanges
+		{
+			GLuint ids[MAX_BUFFERS] = {0};
+			GLintptr offsets[MAX_BUFFERS] = {0};
+			GLsizeiptr sizes[MAX_BUFFERS] = {0};
+			GLuint64 mask = 0;
+		};
+
+		static void setBuffer(BufferRanges& _ranges, GLuint _bindingIndex, class Buffer* _buffer, GLintptr _offset, GLsizeiptr _size);
+
+		GLuint m_textures[MAX_TEXTURES] = {0};
+		GLuint64 m_textureMask = 0;
+		GLuint m_samplers[MAX_TEXTURES] = {0};
+		GLuint64 m_samplerMask = 0;
+		BufferRanges m_uniformBuffers;
+		BufferRanges m_storageBuffers;
+	};
+
+} // namespace gpupro
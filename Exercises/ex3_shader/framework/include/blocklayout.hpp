@@ -0,0 +1,227 @@
+#pragma once
+
+#include "gl.hpp"
+
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstring>
+
+namespace gpupro {
+
+	// Computes the memory layout of uniform (std140) and shader storage
+	// (std430) blocks at compile time. A block is declared by the C++
+	// equivalents of its GLSL member types in the same order. E.g. the block
+	//	layout(std140) uniform ubo { mat4 a; vec3 b; float c; vec4 d[8]; };
+	// is described by
+	//	typedef BlockLayout<BlockStandard::STD140, glm::mat4, glm::vec3, float, glm::vec4[8]> Block;
+	//
+	// Two ways to fill a buffer:
+	// * A C++ struct which mirrors the block is uploaded with a single copy.
+	//   GPUPRO_STATIC_ASSERT_BLOCK_MEMBER/SIZE check the struct against the
+	//   layout, so a wrong member (e.g. bool instead of GLuint, a vec3 which
+	//   needs 16 byte alignment or an array with a 16 byte stride) does not
+	//   compile. Use Padded<> for array elements which need padding.
+	// * Layout::pack() writes separate values to their offsets, e.g. into
+	//   mapped memory. Members with the same representation in C++ and GLSL
+	//   are copied at once, padded arrays and matrices per element/column.
+	//
+	// GLSL bool is 4 bytes: use GLuint in mirror structs (pack() converts
+	// bool). Nested structs are not supported, flatten them into the block.
+	enum class BlockStandard
+	{
+		STD140,		///< Uniform blocks: arrays and structs are aligned to 16 bytes
+		STD430		///< Shader storage blocks: tighter arrays
+	};
+
+	// Pads an array element in a mirror struct, e.g. Padded<float, 16>
+	// for a float[] in a std140 block.
+	template<typename T, size_t Size>
+	struct Padded
+	{
+		static_assert(Size > sizeof(T), "No padding required, use T directly.");
+
+		T value;
+		unsigned char padding[Size - sizeof(T)];
+
+		Padded& operator = (const T& _value) { value = _value; return *this; }
+		operator const T& () const { return value; }
+	};
+
+	// Alignment and size of a GLSL type (given as its C++ equivalent) in a
+	// block and a function to write it there. IS_TIGHT is true if the C++
+	// object has exactly the GLSL representation.
+	template<typename T, BlockStandard S>
+	struct BlockTypeTraits;
+
+	namespace details {
+		constexpr size_t alignUp(size_t _value, size_t _alignment) { return (_value + _alignment - 1) / _alignment * _alignment; }
+		constexpr size_t maxOf(size_t _a, size_t _b) { return _a > _b ? _a : _b; }
+
+		// Scalars and vectors look the same in C++ and GLSL.
+		template<typename T, size_t Alignment>
+		struct TightBlockType
+		{
+			static const size_t ALIGNMENT = Alignment;
+			static const size_t SIZE = sizeof(T);
+			static const bool IS_TIGHT = true;
+			static void write(const T& _value, unsigned char* _dst) { memcpy(_dst, &_value, sizeof(T)); }
+		};
+
+		// Column major matrices are arrays of C column vectors with R
+		// components each.
+		template<typename M, size_t C, size_t R, typename Scalar, BlockStandard S>
+		struct MatrixBlockType
+		{
+			static const size_t COLUMN_SIZE = R * sizeof(Scalar);
+			// Vectors with 3 components are aligned like 4 components. std140
+			// rounds the alignment of array elements up to 16 bytes.
+			static const size_t COLUMN_STRIDE = S == BlockStandard::STD140
+				? alignUp((R == 3 ? 4 : R) * sizeof(Scalar), 16)
+				: (R == 3 ? 4 : R) * sizeof(Scalar);
+			static const size_t ALIGNMENT = COLUMN_STRIDE;
+			static const size_t SIZE = C * COLUMN_STRIDE;
+			static const bool IS_TIGHT = COLUMN_STRIDE == COLUMN_SIZE && sizeof(M) == SIZE;
+			static void write(const M& _value, unsigned char* _dst)
+			{
+				if(IS_TIGHT)
+					memcpy(_dst, &_value, SIZE);
+				else for(size_t c = 0; c < C; ++c)
+					memcpy(_dst + c * COLUMN_STRIDE, &_value[static_cast<glm::length_t>(c)], COLUMN_SIZE);
+			}
+		};
+
+		// Offsets of the remaining members Ts, starting at Offset.
+		template<BlockStandard S, size_t Offset, typename... Ts>
+		struct BlockMembers
+		{
+			static const size_t END = Offset;
+			static const size_t ALIGNMENT = 1;
+			static void pack(unsigned char*) {}
+		};
+
+		template<BlockStandard S, size_t Offset, typename T, typename... Rest>
+		struct BlockMembers<S, Offset, T, Rest...>
+		{
+			typedef BlockTypeTraits<T, S> Traits;
+			static const size_t OFFSET = alignUp(Offset, Traits::ALIGNMENT);
+			static const size_t SIZE = Traits::SIZE;
+			typedef BlockMembers<S, OFFSET + SIZE, Rest...> Next;
+			static const size_t END = Next::END;
+			static const size_t ALIGNMENT = maxOf(Traits::ALIGNMENT, Next::ALIGNMENT);
+
+			static void pack(unsigned char* _dst, const T& _value, const Rest&... _rest)
+			{
+				Traits::write(_value, _dst + OFFSET);
+				Next::pack(_dst, _rest...);
+			}
+		};
+
+		template<size_t I, typename Members>
+		struct MemberAt
+		{
+			typedef typename MemberAt<I - 1, typename Members::Next>::type type;
+		};
+		template<typename Members>
+		struct MemberAt<0, Members>
+		{
+			typedef Members type;
+		};
+	}
+
+	template<BlockStandard S> struct BlockTypeTraits<float, S> : details::TightBlockType<float, 4> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::vec2, S> : details::TightBlockType<glm::vec2, 8> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::vec3, S> : details::TightBlockType<glm::vec3, 16> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::vec4, S> : details::TightBlockType<glm::vec4, 16> {};
+	template<BlockStandard S> struct BlockTypeTraits<GLint, S> : details::TightBlockType<GLint, 4> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::ivec2, S> : details::TightBlockType<glm::ivec2, 8> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::ivec3, S> : details::TightBlockType<glm::ivec3, 16> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::ivec4, S> : details::TightBlockType<glm::ivec4, 16> {};
+	template<BlockStandard S> struct BlockTypeTraits<GLuint, S> : details::TightBlockType<GLuint, 4> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::uvec2, S> : details::TightBlockType<glm::uvec2, 8> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::uvec3, S> : details::TightBlockType<glm::uvec3, 16> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::uvec4, S> : details::TightBlockType<glm::uvec4, 16> {};
+	template<BlockStandard S> struct BlockTypeTraits<double, S> : details::TightBlockType<double, 8> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::dvec2, S> : details::TightBlockType<glm::dvec2, 16> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::dvec3, S> : details::TightBlockType<glm::dvec3, 32> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::dvec4, S> : details::TightBlockType<glm::dvec4, 32> {};
+
+	// GLSL bool has 4 bytes.
+	template<BlockStandard S>
+	struct BlockTypeTraits<bool, S>
+	{
+		static const size_t ALIGNMENT = 4;
+		static const size_t SIZE = 4;
+		static const bool IS_TIGHT = false;
+		static void write(bool _value, unsigned char* _dst)
+		{
+			GLuint value = _value ? 1 : 0;
+			memcpy(_dst, &value, sizeof(value));
+		}
+	};
+
+	// glm::matCxR has C columns and R rows like GLSL.
+	template<BlockStandard S> struct BlockTypeTraits<glm::mat2, S> : details::MatrixBlockType<glm::mat2, 2, 2, float, S> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::mat3, S> : details::MatrixBlockType<glm::mat3, 3, 3, float, S> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::mat4, S> : details::MatrixBlockType<glm::mat4, 4, 4, float, S> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::mat2x3, S> : details::MatrixBlockType<glm::mat2x3, 2, 3, float, S> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::mat2x4, S> : details::MatrixBlockType<glm::mat2x4, 2, 4, float, S> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::mat3x2, S> : details::MatrixBlockType<glm::mat3x2, 3, 2, float, S> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::mat3x4, S> : details::MatrixBlockType<glm::mat3x4, 3, 4, float, S> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::mat4x2, S> : details::MatrixBlockType<glm::mat4x2, 4, 2, float, S> {};
+	template<BlockStandard S> struct BlockTypeTraits<glm::mat4x3, S> : details::MatrixBlockType<glm::mat4x3, 4, 3, float, S> {};
+
+	// Arrays: std140 rounds the element alignment up to 16 bytes. The
+	// stride is the element size rounded up to the alignment.
+	template<typename T, size_t N, BlockStandard S>
+	struct BlockTypeTraits<T[N], S>
+	{
+		typedef BlockTypeTraits<T, S> Element;
+		static const size_t ALIGNMENT = S == BlockStandard::STD140 ? details::alignUp(Element::ALIGNMENT, 16) : Element::ALIGNMENT;
+		static const size_t STRIDE = details::alignUp(Element::SIZE, ALIGNMENT);
+		static const size_t SIZE = N * STRIDE;
+		static const bool IS_TIGHT = Element::IS_TIGHT && STRIDE == sizeof(T);
+		static void write(const T (&_value)[N], unsigned char* _dst)
+		{
+			if(IS_TIGHT)
+				memcpy(_dst, _value, SIZE);
+			else for(size_t i = 0; i < N; ++i)
+				Element::write(_value[i], _dst + i * STRIDE);
+		}
+	};
+
+	template<BlockStandard S, typename... Members>
+	class BlockLayout
+	{
+		typedef details::BlockMembers<S, 0, Members...> Root;
+	public:
+		static const size_t NUM_MEMBERS = sizeof...(Members);
+		// Blocks are aligned like structs: std140 rounds up to 16 bytes.
+		static const size_t ALIGNMENT = S == BlockStandard::STD140 ? details::alignUp(Root::ALIGNMENT, 16) : Root::ALIGNMENT;
+		// Buffer size for one instance of the block.
+		static const size_t SIZE = details::alignUp(Root::END, ALIGNMENT);
+
+		template<size_t I>
+		static constexpr size_t offset() { return details::MemberAt<I, Root>::type::OFFSET; }
+		template<size_t I>
+		static constexpr size_t size() { return details::MemberAt<I, Root>::type::SIZE; }
+
+		// Write all members to _dst (at least SIZE bytes). Padding bytes
+		// are not touched.
+		static void pack(void* _dst, const Members&... _values)
+		{
+			Root::pack(static_cast<unsigned char*>(_dst), _values...);
+		}
+	};
+
+	// Compile time checks of a C++ struct which mirrors a BlockLayout. The
+	// Index-th member of the layout must be at the offset of Struct::member
+	// and have the same size.
+	#define GPUPRO_STATIC_ASSERT_BLOCK_MEMBER(Layout, Index, Struct, member)						\
+		static_assert(offsetof(Struct, member) == Layout::offset<Index>(),							\
+			#Struct "::" #member " is not at the offset of member " #Index " in " #Layout ".");	\
+		static_assert(sizeof(Struct::member) == Layout::size<Index>(),								\
+			#Struct "::" #member " does not have the size of member " #Index " in " #Layout ".")
+	#define GPUPRO_STATIC_ASSERT_BLOCK_SIZE(Layout, Struct)											\
+		static_assert(sizeof(Struct) == Layout::SIZE, "The size of " #Struct " differs from " #Layout ".")
+
+} // namespace gpupro
@@ -1,9 +1,34 @@
 #pragma once
 
 #include "gl.hpp"
+#include <vector>
+#include <cassert>
+#include <cstdint>
 
 namespace gpupro {
 
+	// A set of disjoint, sorted byte ranges [begin, end).
+	// Overlapping and adjacent ranges are merged on insertion.
+	class IntervalSet
+	{
+	public:
+		struct Range
+		{
+			GLintptr begin;
+			GLintptr end;
+		};
+
+		void insert(GLintptr _begin, GLintptr _end);
+		void clear() { m_ranges.clear(); }
+		bool empty() const { return m_ranges.empty(); }
+		// Sum of the sizes of all ranges.
+		GLintptr coveredSize() const;
+
+		const std::vector<Range>& ranges() const { return m_ranges; }
+	private:
+		std::vector<Range> m_ranges;
+	};
+
 	// A buffer is a pure memory block on GPU side.
 	class Buffer
 	{
@@ -29,7 +54,73 @@ namespace gpupro {
 		{
 			// Allow glBufferSubData updates for this buffer.
 			SUB_DATA_UPDATE = GL_DYNAMIC_STORAGE_BIT,
-			// There will be more usages later...
+			// Allow map() with MapAccess::READ.
+			MAP_READ = GL_MAP_READ_BIT,
+			// Allow map() with MapAccess::WRITE.
+			MAP_WRITE = GL_MAP_WRITE_BIT,
+			// Allow the buffer to stay mapped while it is used by the GPU.
+			MAP_PERSISTENT = GL_MAP_PERSISTENT_BIT,
+			// Persistent mappings are coherent without explicit flushes/barriers.
+			MAP_COHERENT = GL_MAP_COHERENT_BIT,
+			// Hint: prefer memory on the CPU side.
+			CLIENT_STORAGE = GL_CLIENT_STORAGE_BIT,
+		};
+
+		// Access flags for map(). Combine them with |.
+		enum MapAccess
+		{
+			READ = GL_MAP_READ_BIT,
+			WRITE = GL_MAP_WRITE_BIT,
+			// Requires Usage::MAP_PERSISTENT.
+			PERSISTENT = GL_MAP_PERSISTENT_BIT,
+			// Requires Usage::MAP_COHERENT.
+			COHERENT = GL_MAP_COHERENT_BIT,
+			// The old content of the range may be discarded (write only).
+			INVALIDATE_RANGE = GL_MAP_INVALIDATE_RANGE_BIT,
+			// The old content of the entire buffer may be discarded (write only).
+			INVALIDATE_BUFFER = GL_MAP_INVALIDATE_BUFFER_BIT,
+			// Do not wait for pending GPU operations on the buffer. You must
+			// make sure yourself that the range is not in use.
+			UNSYNCHRONIZED = GL_MAP_UNSYNCHRONIZED_BIT,
+			// Changes are only visible after MappedRange::flush() (write only).
+			EXPLICIT_FLUSH = GL_MAP_FLUSH_EXPLICIT_BIT,
+		};
+
+		// A mapped part of a buffer. The range is unmapped on destruction.
+		// It must not outlive the buffer it was mapped from.
+		class MappedRange
+		{
+		public:
+			MappedRange() : m_bufferID(0), m_data(nullptr), m_size(0), m_access(MapAccess(0)) {}
+			~MappedRange();
+			// Move but not copy-able
+			MappedRange(MappedRange&& _rhs);
+			MappedRange(const MappedRange&) = delete;
+			MappedRange& operator = (MappedRange&& _rhs);
+			MappedRange& operator = (const MappedRange&) = delete;
+
+			// Make writes in a sub-range visible to the GPU.
+			// Requires MapAccess::EXPLICIT_FLUSH.
+			// _offset: relative to the begin of the mapped range in bytes.
+			// _size: -1 flushes everything from _offset to the end.
+			void flush(GLintptr _offset = 0, GLsizeiptr _size = GLsizeiptr(-1));
+			// Unmap before destruction. The pointer becomes invalid.
+			void unmap();
+
+			void* data() const { return m_data; }
+			template<typename T> T* as() const { return static_cast<T*>(m_data); }
+			GLsizeiptr size() const { return m_size; }
+			// False if the mapping failed.
+			explicit operator bool() const { return m_data != nullptr; }
+		private:
+			friend class Buffer;
+			MappedRange(GLuint _bufferID, void* _data, GLsizeiptr _size, MapAccess _access) :
+				m_bufferID(_bufferID), m_data(_data), m_size(_size), m_access(_access) {}
+
+			GLuint m_bufferID;
+			void* m_data;
+			GLsizeiptr m_size;
+			MapAccess m_access;
 		};
 
 		// Create a raw buffer for data. Buffers created with this method
@@ -54,6 +145,10 @@ namespace gpupro {
 		//		This gives the offset in byte to the begin of the range.
 		// _size: size of the range in bytes. -1 binds the entire buffer.
 		void bindAsUniformBuffer(GLuint _bindingIndex, GLintptr _offset = 0, GLsizeiptr _size = GLsizeiptr(-1));
+		// Bind as shader storage buffer (random read write access)
+		// _bindingIndex: binding slot of the storage buffer
+		// _offset, _size: range in bytes (see bindAsUniformBuffer).
+		void bindAsShaderStorageBuffer(GLuint _bindingIndex, GLintptr _offset = 0, GLsizeiptr _size = GLsizeiptr(-1));
 
 		// Upload a small chunk of data to a specific position.
 		// Requires Usage::SUB_DATA_UPDATE.
@@ -63,15 +158,87 @@ namespace gpupro {
 		// Set the entire buffer content to zero.
 		void clear();
 
+		// Get direct CPU access to a range of the buffer.
+		// The access flags are validated against the usage bits of the
+		// buffer. On errors an empty range is returned.
+		// _offset, _size: range in bytes. -1 maps everything from _offset.
+		MappedRange map(MapAccess _access, GLintptr _offset = 0, GLsizeiptr _size = GLsizeiptr(-1));
+
+		// Copy a range from another buffer on GPU side (no CPU round-trip).
+		// All parameters are in bytes.
+		void copyFrom(Buffer& _source, GLintptr _srcOffset, GLintptr _dstOffset, GLsizeiptr _size);
+
+		// Create a CPU side copy of the buffer which collects writes until
+		// the next flushShadow(). Use this for dynamic buffers which get many
+		// small updates per frame. Requires Usage::SUB_DATA_UPDATE.
+		// _fullUpdateThreshold: if more than this fraction of the buffer is
+		//		dirty, the entire buffer is replaced in a single upload.
+		// _initialData: initial content of the shadow (the same as passed to
+		//		the constructor). Zero initialized if nullptr.
+		void enableShadow(float _fullUpdateThreshold = 0.5f, const GLvoid* _initialData = nullptr);
+		bool hasShadow() const { return !m_shadow.empty(); }
+
+		// Write into the shadow copy. Nothing is send to the GPU before
+		// flushShadow() is called.
+		void write(GLintptr _offset, GLsizei _size, const GLvoid* _data);
+		// Typed write access: set element _index (in units of the element size).
+		// T must not be larger than the element size.
+		template<typename T>
+		void write(GLuint _index, const T& _value)
+		{
+			writeElement(_index, static_cast<GLsizei>(sizeof(T)), &_value);
+		}
+		// Read access to the shadow copy. Requires a shadow copy, an index
+		// below numElements() and a T not larger than the element size.
+		template<typename T>
+		const T& read(GLuint _index) const
+		{
+			assert(hasShadow() && "Buffer::read requires a shadow copy.");
+			assert(_index < numElements() && "Buffer::read out of range.");
+			assert(sizeof(T) <= m_elementSize && "Buffer::read with a type larger than the elements.");
+			return *reinterpret_cast<const T*>(m_shadow.data() + static_cast<size_t>(_index) * m_elementSize);
+		}
+
+		// Upload all dirty ranges of the shadow copy. Call this once per frame
+		// before the buffer is used.
+		void flushShadow();
+
+		// Statistics of the shadow copy since enableShadow().
+		struct ShadowStats
+		{
+			uint64_t numWrites = 0;			///< Number of write() calls.
+			uint64_t numUploads = 0;		///< Number of glBufferSubData calls issued by flushShadow().
+			uint64_t bytesWritten = 0;		///< Sum of all write() sizes.
+			uint64_t bytesUploaded = 0;		///< Bytes really transferred.
+			// Driver calls saved compared to calling subDataUpdate() for each write.
+			int64_t callsSaved() const { return int64_t(numWrites) - int64_t(numUploads); }
+			// Bytes saved compared to calling subDataUpdate() for each write.
+			// Negative if full uploads transferred more than was written.
+			int64_t bytesSaved() const { return int64_t(bytesWritten) - int64_t(bytesUploaded); }
+		};
+		const ShadowStats& shadowStats() const { return m_shadowStats; }
+
 		GLuint numElements() const { return m_size / m_elementSize; }
+		GLuint elementSize() const { return m_elementSize; }
+		GLsizei size() const { return m_size; }
 
 		GLuint glID() { return m_id; }
 	private:
+		void writeElement(GLuint _index, GLsizei _size, const GLvoid* _data);
+
 		GLuint m_id;
 		Type m_type;
 		GLsizei m_size;
 		GLuint m_elementSize;
 		Usage m_usage;
+
+		std::vector<unsigned char> m_shadow;
+		IntervalSet m_dirtyRanges;
+		float m_fullUpdateThreshold;
+		ShadowStats m_shadowStats;
 	};
 
+	inline Buffer::Usage operator | (Buffer::Usage _a, Buffer::Usage _b) { return Buffer::Usage(int(_a) | int(_b)); }
+	inline Buffer::MapAccess operator | (Buffer::MapAccess _a, Buffer::MapAccess _b) { return Buffer::MapAccess(int(_a) | int(_b)); }
+
 } // namespace gpupro
\ No newline at end of file
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "gl.hpp"
+#include "model.hpp"
+#include <vector>
+#include <mutex>
+#include <memory>
+
+namespace gpupro {
+
+	class BindingTable;
+	class CompiledPipeline;
+
+	// A command buffer records rendering commands into linear memory
+	// without calling OpenGL. Therefore, it can be filled on any thread.
+	// OGLContext::execute() replays the commands on the GL thread.
+	//
+	// A single command buffer must only be recorded by one thread at a
+	// time. Use one buffer per worker thread and submit them in the
+	// desired order.
+	//
+	// Only references are recorded (except for uniform data). All
+	// pipelines, tables and buffers must stay alive until execution.
+	class CommandBuffer
+	{
+	public:
+		// Alignment of uniform slices. 256 is the largest
+		// GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT of current desktop GPUs.
+		// The value cannot be queried from a worker thread.
+		static const GLsizeiptr UNIFORM_ALIGNMENT = 256;
+
+		CommandBuffer();
+		~CommandBuffer();
+		// Move but not copy-able
+		CommandBuffer(CommandBuffer&& _rhs);
+		CommandBuffer(const CommandBuffer&) = delete;
+		CommandBuffer& operator = (CommandBuffer&& _rhs);
+		CommandBuffer& operator = (const CommandBuffer&) = delete;
+
+		void setState(const CompiledPipeline& _pipeline);
+		void setBindings(const BindingTable& _table);
+		// _offset: Offset in number of elements (see Buffer::bindAsVertexBuffer).
+		void bindVertexBuffer(GLuint _bindingIndex, Buffer& _buffer, GLuint _offset = 0);
+		// The index type is derived from the element size of the buffer.
+		void bindIndexBuffer(Buffer& _buffer);
+
+		// Copy _size bytes into the command buffer. On execution all copied
+		// data is uploaded with a single call and the slice is bound as
+		// uniform buffer _bindingIndex.
+		void setUniforms(GLuint _bindingIndex, const void* _data, GLsizeiptr _size);
+		template<typename T>
+		void setUniforms(GLuint _bindingIndex, const T& _data)
+		{
+			setUniforms(_bindingIndex, &_data, sizeof(T));
+		}
+
+		// Draw with the current index buffer (glDrawElements* family).
+		void drawIndexed(Model::DrawPrimitiveType _primType, GLuint _indexCount, GLuint _firstIndex = 0,
+			GLint _baseVertex = 0, GLuint _instanceCount = 1, GLuint _baseInstance = 0);
+		// Draw without index buffer (glDrawArrays* family).
+		void draw(Model::DrawPrimitiveType _primType, GLuint _vertexCount, GLuint _firstVertex = 0,
+			GLuint _instanceCount = 1, GLuint _baseInstance = 0);
+
+		// Remove all commands. The memory is kept for the next recording.
+		void reset();
+
+		bool empty() const { return m_commands.empty(); }
+		// Size of the recorded commands in bytes, without the uniform data.
+		size_t size() const { return m_commands.size() * sizeof(m_commands[0]); }
+	private:
+		friend class OGLContext;
+
+		enum class CommandType : GLuint
+		{
+			SET_STATE,
+			SET_BINDINGS,
+			BIND_VERTEX_BUFFER,
+			BIND_INDEX_BUFFER,
+			SET_UNIFORMS,
+			DRAW_INDEXED,
+			DRAW,
+		};
+
+		// Each command is a type followed by its arguments. All commands
+		// are padded to multiples of 8 byte.
+		struct BindVertexBufferCmd { GLuint bindingIndex; GLuint buffer; GLintptr offset; GLsizei stride; };
+		struct BindIndexBufferCmd { GLuint buffer; GLenum indexType; GLuint indexSize; };
+		struct SetUniformsCmd { GLuint bindingIndex; GLintptr offset; GLsizeiptr size; };
+		struct DrawIndexedCmd { GLenum primType; GLuint indexCount; GLuint firstIndex; GLint baseVertex; GLuint instanceCount; GLuint baseInstance; };
+		struct DrawCmd { GLenum primType; GLuint vertexCount; GLuint firstVertex; GLuint instanceCount; GLuint baseInstance; };
+
+		template<typename T>
+		void push(CommandType _type, const T& _args);
+
+		std::vector<GLuint64> m_commands;
+		std::vector<unsigned char> m_uniformData;
+		// Created on the GL thread during the first execution with uniforms.
+		std::unique_ptr<Buffer> m_uniformBuffer;
+	};
+
+	// Collects command buffers from several threads. The GL thread executes
+	// them in the order of submission with OGLContext::execute().
+	class CommandQueue
+	{
+	public:
+		// Thread safe. The buffer must not be changed until it was executed.
+		void submit(CommandBuffer& _commands);
+	private:
+		friend class OGLContext;
+		std::mutex m_mutex;
+		std::vector<CommandBuffer*> m_submitted;
+	};
+
+} // namespace gpupro
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "pipeline.hpp"
+#include "commandbuffer.hpp"
+#include "deletionqueue.hpp"
 
 namespace gpupro {
 
@@ -12,7 +14,7 @@ namespace gpupro {
 	// other modern APIs like DX and Vulkan.
 	//
 	// Using this context class is only possible after successful window
-	// creation.
+	// creation (except for the NULL_RECORDING backend).
 	class OGLContext
 	{
 	public:
@@ -24,21 +26,75 @@ namespace gpupro {
 			HIGH		 = 3	///< Report errors only
 		};
 
+		enum class Backend
+		{
+			DRIVER,			///< Load the functions of the current window's context
+			NULL_RECORDING	///< Record all calls without a GPU (see NullGL)
+		};
+
 		// The constructor enables the Debug extension (former KHR_DEBUG,
 		// core since 4.3).
-		OGLContext(DebugSeverity _dbgLevel);
+		OGLContext(DebugSeverity _dbgLevel, Backend _backend = Backend::DRIVER);
+		// Waits for the GPU and deletes all objects from the deletion queue.
+		~OGLContext();
+
+		// Mark the end of a frame. Call this once per frame (e.g. before
+		// presenting). Objects destroyed in this frame are deleted on GPU
+		// side as soon as the GPU finished the frame. This also marks the
+		// frame boundary of a running GLTrace capture.
+		void endFrame();
 
+		// Switch to a precompiled pipeline. Only the GL calls for states
+		// which differ from the current state are issued.
+		void setState(const CompiledPipeline& _pipeline);
+		// Compiles the pipeline on the fly. Prefer to create CompiledPipeline
+		// objects once outside the render loop.
 		void setState(Pipeline& _pipeline);
 		void setState(ComputePipeline& _pipeline);
+
+		// Enable the write masks which clears of _buffers (GL_COLOR_BUFFER_BIT,
+		// GL_DEPTH_BUFFER_BIT, GL_STENCIL_BUFFER_BIT) depend on and disable
+		// rasterizer discard. The rest of the current state is kept.
+		void prepareClear(GLbitfield _buffers);
+
+		// Bind all resources of the table. Only contiguous ranges of changed
+		// slots are rebound (one multi-bind call per range and type).
+		// Buffer slots above the limits of the driver are rejected.
+		// Pipelines with a BindingTable call this implicitly.
+		void setBindings(const BindingTable& _table);
+
+		// Replay recorded commands. This must be called on the GL thread.
+		void execute(CommandBuffer& _commands);
+		// Execute all command buffers submitted so far in the order of
+		// submission and remove them from the queue.
+		void execute(CommandQueue& _queue);
 	private:
+		// _table: optional, its samplers override _samplers.
+		void setSamplers(const GLuint* _samplers, GLuint64 _mask, const BindingTable* _table);
+		// _supportedSlots: mask of the binding indices the driver supports.
+		void setBuffers(GLenum _target, GLuint64 _supportedSlots, BindingTable::BufferRanges& _current, const BindingTable::BufferRanges& _new);
+		void setProgram(GLuint _program);
+		// Forget the cached names of objects which were deleted since the
+		// last check.
+		void checkDeletedObjects();
+
+		// The keys of the currently set pipeline. ~0 marks an unknown state.
 		struct {
-			RasterizerState rasterizer;
-			DepthStencilState depthStencil;
-			BlendState blendState;
-			// 64 textures is very high. It might be that your GPU does not support
-			// that many. Have a look at GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS.
-			SamplerState* samplerState[64] = {nullptr};
+			GLuint64 keys[CompiledPipeline::NUM_SLOTS];
 		} m_currentState;
+		// DeletionQueue::generation() of each object type at the last check.
+		GLuint m_deletionGenerations[static_cast<int>(DeletionQueue::ObjectType::NUM_TYPES)];
+		// All currently bound samplers, textures and buffers.
+		BindingTable m_currentBindings;
+		// Buffer binding indices below GL_MAX_UNIFORM_BUFFER_BINDINGS and
+		// GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS, queried once.
+		GLuint64 m_uniformBufferSlots;
+		GLuint64 m_storageBufferSlots;
+		// Bound for pipelines without a vertex format, since the core
+		// profile does not allow to draw with VAO 0.
+		std::shared_ptr<VertexFormat> m_emptyVertexFormat;
+		// Receives the stages of pipelines with separable programs.
+		GLuint m_programPipeline;
 	};
 
 } // namespace gpupro
\ No newline at end of file
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "gl.hpp"
+
+namespace gpupro {
+
+	// Deleting an object which is still used by queued GPU commands can stall
+	// the driver. The deletion queue delays the glDelete* calls of all
+	// framework objects until the frame which released them is finished.
+	//
+	// Deferred deletion is active after the first OGLContext::endFrame().
+	// Before that (e.g. during loading) objects are deleted immediately.
+	class DeletionQueue
+	{
+	public:
+		enum class ObjectType
+		{
+			BUFFER,
+			TEXTURE,
+			PROGRAM,
+			QUERY,
+			VERTEX_ARRAY,
+			SAMPLER,
+			FRAMEBUFFER,
+			NUM_TYPES
+		};
+
+		// Called by the destructors of the resource classes. 0 is ignored.
+		static void release(ObjectType _type, GLuint _id);
+
+		// Close the current frame: insert a fence for all objects released
+		// since the last call and delete the objects of all finished frames.
+		// This is called by OGLContext::endFrame().
+		static void endFrame();
+
+		// Wait for the GPU and delete everything (e.g. on shutdown).
+		static void flush();
+
+		// Number of objects waiting for deletion.
+		static size_t numPending();
+
+		// Incremented whenever an object of the type is really deleted. Its
+		// name can be reused by new objects afterwards, so caches of names
+		// (e.g. the bindings of the OGLContext) must not trust it any longer.
+		static GLuint generation(ObjectType _type);
+		// True if _id was deleted after the given generation() of its type.
+		// Also true if too many objects were deleted since then to tell.
+		static bool wasDeleted(ObjectType _type, GLuint _id, GLuint _generation);
+	};
+
+} // namespace gpupro
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "gl.hpp"
+#include <functional>
+#include <vector>
+
+namespace gpupro {
+
+	class OGLContext;
+	class CompiledPipeline;
+	class BindingTable;
+
+	// Collects the draws of a frame and executes them sorted by a 64 bit key
+	// instead of submission order. Keys group draws with the same pipeline
+	// and material, so fewer state changes are necessary. Consecutive draws
+	// with the same pipeline skip setState(), consecutive draws with the
+	// same pipeline and binding table skip setBindings() as well.
+	//
+	// There are two buckets. SOLID draws are sorted by layer, pipeline,
+	// material and front-to-back depth. BLENDED draws are sorted by layer
+	// and back-to-front depth, pipeline and material only break ties. The
+	// solid bucket is executed first.
+	class DrawQueue
+	{
+	public:
+		enum class Bucket
+		{
+			SOLID,
+			BLENDED
+		};
+
+		struct Stats
+		{
+			GLuint numDraws = 0;
+			GLuint pipelineSwitches = 0;
+			GLuint bindingSwitches = 0;
+			// Switches which would have happened in submission order minus the
+			// real number of switches.
+			GLuint pipelineSwitchesAvoided = 0;
+			GLuint bindingSwitchesAvoided = 0;
+		};
+
+		// _numThreads: Number of threads used for sorting large queues.
+		//		0 uses all hardware threads.
+		explicit DrawQueue(GLuint _numThreads = 0);
+
+		// Submit a draw. The pipeline and the binding table must stay alive
+		// until execute().
+		// _layer: 0 to 15. Higher layers are drawn later (e.g. sky, HUD).
+		// _bindings: optional.
+		// _depth: Normalized view space depth in [0,1] (e.g. distance / far plane).
+		// _draw: Binds the geometry and draws. Called during execute(). It
+		//		must not change the pipeline or the binding table.
+		void submit(Bucket _bucket, GLuint _layer, const CompiledPipeline& _pipeline, const BindingTable* _bindings,
+			float _depth, std::function<void()> _draw);
+		// Submit with a custom key. Draws are executed in ascending key order.
+		void submit(Bucket _bucket, GLuint64 _key, const CompiledPipeline& _pipeline, const BindingTable* _bindings,
+			std::function<void()> _draw);
+
+		// Key layouts (most significant first):
+		// solid:   layer 4 | pipeline 16 | material 20 | depth 24
+		// blended: layer 4 | inverted depth 24 | pipeline 16 | material 20
+		static GLuint64 makeSolidKey(GLuint _layer, GLuint _pipelineId, GLuint _materialId, float _depth);
+		static GLuint64 makeBlendedKey(GLuint _layer, float _depth, GLuint _pipelineId, GLuint _materialId);
+
+		// Sort both buckets, execute all draws and clear the queue.
+		void execute(OGLContext& _context);
+
+		// Statistics of the last execute().
+		const Stats& stats() const { return m_stats; }
+	private:
+		struct Draw
+		{
+			const CompiledPipeline* pipeline;
+			const BindingTable* bindings;
+			std::function<void()> draw;
+		};
+
+		struct SortEntry
+		{
+			GLuint64 key;
+			GLuint index;
+		};
+
+		void sort(std::vector<SortEntry>& _entries);
+
+		GLuint m_numThreads;
+		std::vector<Draw> m_draws;
+		std::vector<SortEntry> m_buckets[2];
+		std::vector<SortEntry> m_sortBuffer;
+		Stats m_stats;
+	};
+
+} // namespace gpupro
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "gl.hpp"
+
+namespace gpupro {
+
+	// A fence is a marker in the command stream. It becomes signaled when
+	// the GPU finished all commands issued before the fence.
+	class Fence
+	{
+	public:
+		// Insert a new fence after all commands issued so far.
+		Fence();
+		~Fence();
+		// Move but not copy-able
+		Fence(Fence&& _rhs);
+		Fence(const Fence&) = delete;
+		Fence& operator = (Fence&& _rhs);
+		Fence& operator = (const Fence&) = delete;
+
+		// Check without blocking if the GPU reached the fence.
+		bool signaled() const;
+
+		// Block the CPU until the fence is signaled or the timeout expired.
+		// The commands before the fence are flushed, so this cannot deadlock.
+		// _timeoutNs: maximum time to wait in nanoseconds.
+		// Returns true if the fence is signaled.
+		bool wait(GLuint64 _timeoutNs = ~GLuint64(0));
+
+		// Let the GPU wait for the fence before executing further commands.
+		// This does not block the CPU. Only useful with multiple contexts.
+		void waitGPU();
+
+		GLsync glID() { return m_sync; }
+	private:
+		GLsync m_sync;
+	};
+
+} // namespace gpupro
@@ -5,3 +5,17 @@
 #endif
 
 #include <glad/glad.h>
+
+namespace gpupro {
+
+	// Direct state access (core since 4.5) allows to edit objects without
+	// binding them first. If the context does not support it, the framework
+	// falls back to the classic bind-to-edit path.
+	inline bool hasDSA() { return GLAD_GL_VERSION_4_5 != 0; }
+
+	// Shaders and programs can be compiled in driver threads and their
+	// completion can be polled without blocking (GL_COMPLETION_STATUS_KHR).
+	// The ARB and KHR extensions are identical.
+	inline bool hasParallelShaderCompile() { return GLAD_GL_KHR_parallel_shader_compile || GLAD_GL_ARB_parallel_shader_compile; }
+
+} // namespace gpupro
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "gl.hpp"
+
+namespace gpupro {
+
+	// One enumerator per glad function (generated list in glfunctions.inl).
+	// The enumerators have the names of the glad pointers, so
+	// GLFunction::glDrawElements works through glad's macros.
+	enum class GLFunction
+	{
+	#define GL_FUNCTION(name, type, params) name,
+	#include "glfunctions.inl"
+	#undef GL_FUNCTION
+		NUM_FUNCTIONS
+	};
+
+	// Name of the GL function without the glad_ prefix, e.g. "glEnable".
+	const char* glFunctionName(GLFunction _function);
+
+	// Classes of the return value and the parameters, derived from the
+	// parameter names in glad.h. One character for the return value
+	// followed by one per parameter:
+	//	-	plain value
+	//	b t s f r v q x P p h	object name(s) of buffers, textures, samplers,
+	//			framebuffers, renderbuffers, vertex arrays, queries, transform
+	//			feedbacks, program pipelines, programs and shaders
+	//	y	sync object		m	mapped pointer (return only)
+	//	#	element count for arrays	a	array of plain values
+	//	l	string/data length	z	data size in bytes
+	//	W H D	image width, height, depth	F T	pixel format and type
+	//	c	string	S	array of strings
+	//	d	data (the size depends on the function)
+	//	o	offset into a bound buffer (indices, indirect commands)
+	//	n	function pointer (callback)
+	//	*	output
+	const char* glFunctionParameters(GLFunction _function);
+
+} // namespace gpupro
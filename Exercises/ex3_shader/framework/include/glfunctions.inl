@@ -0,0 +1,707 @@
+// Generated by tools/glfunctions.py from glad.h (do not edit).
+
+GL_FUNCTION(glad_glCullFace, PFNGLCULLFACEPROC, "--")
+GL_FUNCTION(glad_glFrontFace, PFNGLFRONTFACEPROC, "--")
+GL_FUNCTION(glad_glHint, PFNGLHINTPROC, "---")
+GL_FUNCTION(glad_glLineWidth, PFNGLLINEWIDTHPROC, "--")
+GL_FUNCTION(glad_glPointSize, PFNGLPOINTSIZEPROC, "--")
+GL_FUNCTION(glad_glPolygonMode, PFNGLPOLYGONMODEPROC, "---")
+GL_FUNCTION(glad_glScissor, PFNGLSCISSORPROC, "---WH")
+GL_FUNCTION(glad_glTexParameterf, PFNGLTEXPARAMETERFPROC, "----")
+GL_FUNCTION(glad_glTexParameterfv, PFNGLTEXPARAMETERFVPROC, "---d")
+GL_FUNCTION(glad_glTexParameteri, PFNGLTEXPARAMETERIPROC, "----")
+GL_FUNCTION(glad_glTexParameteriv, PFNGLTEXPARAMETERIVPROC, "---d")
+GL_FUNCTION(glad_glTexImage1D, PFNGLTEXIMAGE1DPROC, "----W-FTd")
+GL_FUNCTION(glad_glTexImage2D, PFNGLTEXIMAGE2DPROC, "----WH-FTd")
+GL_FUNCTION(glad_glDrawBuffer, PFNGLDRAWBUFFERPROC, "--")
+GL_FUNCTION(glad_glClear, PFNGLCLEARPROC, "--")
+GL_FUNCTION(glad_glClearColor, PFNGLCLEARCOLORPROC, "-----")
+GL_FUNCTION(glad_glClearStencil, PFNGLCLEARSTENCILPROC, "--")
+GL_FUNCTION(glad_glClearDepth, PFNGLCLEARDEPTHPROC, "--")
+GL_FUNCTION(glad_glStencilMask, PFNGLSTENCILMASKPROC, "--")
+GL_FUNCTION(glad_glColorMask, PFNGLCOLORMASKPROC, "-----")
+GL_FUNCTION(glad_glDepthMask, PFNGLDEPTHMASKPROC, "--")
+GL_FUNCTION(glad_glDisable, PFNGLDISABLEPROC, "--")
+GL_FUNCTION(glad_glEnable, PFNGLENABLEPROC, "--")
+GL_FUNCTION(glad_glFinish, PFNGLFINISHPROC, "-")
+GL_FUNCTION(glad_glFlush, PFNGLFLUSHPROC, "-")
+GL_FUNCTION(glad_glBlendFunc, PFNGLBLENDFUNCPROC, "---")
+GL_FUNCTION(glad_glLogicOp, PFNGLLOGICOPPROC, "--")
+GL_FUNCTION(glad_glStencilFunc, PFNGLSTENCILFUNCPROC, "----")
+GL_FUNCTION(glad_glStencilOp, PFNGLSTENCILOPPROC, "----")
+GL_FUNCTION(glad_glDepthFunc, PFNGLDEPTHFUNCPROC, "--")
+GL_FUNCTION(glad_glPixelStoref, PFNGLPIXELSTOREFPROC, "---")
+GL_FUNCTION(glad_glPixelStorei, PFNGLPIXELSTOREIPROC, "---")
+GL_FUNCTION(glad_glReadBuffer, PFNGLREADBUFFERPROC, "--")
+GL_FUNCTION(glad_glReadPixels, PFNGLREADPIXELSPROC, "---WHFT*")
+GL_FUNCTION(glad_glGetBooleanv, PFNGLGETBOOLEANVPROC, "--*")
+GL_FUNCTION(glad_glGetDoublev, PFNGLGETDOUBLEVPROC, "--*")
+GL_FUNCTION(glad_glGetError, PFNGLGETERRORPROC, "-")
+GL_FUNCTION(glad_glGetFloatv, PFNGLGETFLOATVPROC, "--*")
+GL_FUNCTION(glad_glGetIntegerv, PFNGLGETINTEGERVPROC, "--*")
+GL_FUNCTION(glad_glGetString, PFNGLGETSTRINGPROC, "--")
+GL_FUNCTION(glad_glGetTexImage, PFNGLGETTEXIMAGEPROC, "---FT*")
+GL_FUNCTION(glad_glGetTexParameterfv, PFNGLGETTEXPARAMETERFVPROC, "---*")
+GL_FUNCTION(glad_glGetTexParameteriv, PFNGLGETTEXPARAMETERIVPROC, "---*")
+GL_FUNCTION(glad_glGetTexLevelParameterfv, PFNGLGETTEXLEVELPARAMETERFVPROC, "----*")
+GL_FUNCTION(glad_glGetTexLevelParameteriv, PFNGLGETTEXLEVELPARAMETERIVPROC, "----*")
+GL_FUNCTION(glad_glIsEnabled, PFNGLISENABLEDPROC, "--")
+GL_FUNCTION(glad_glDepthRange, PFNGLDEPTHRANGEPROC, "---")
+GL_FUNCTION(glad_glViewport, PFNGLVIEWPORTPROC, "---WH")
+GL_FUNCTION(glad_glDrawArrays, PFNGLDRAWARRAYSPROC, "---#")
+GL_FUNCTION(glad_glDrawElements, PFNGLDRAWELEMENTSPROC, "--#To")
+GL_FUNCTION(glad_glPolygonOffset, PFNGLPOLYGONOFFSETPROC, "---")
+GL_FUNCTION(glad_glCopyTexImage1D, PFNGLCOPYTEXIMAGE1DPROC, "------W-")
+GL_FUNCTION(glad_glCopyTexImage2D, PFNGLCOPYTEXIMAGE2DPROC, "------WH-")
+GL_FUNCTION(glad_glCopyTexSubImage1D, PFNGLCOPYTEXSUBIMAGE1DPROC, "------W")
+GL_FUNCTION(glad_glCopyTexSubImage2D, PFNGLCOPYTEXSUBIMAGE2DPROC, "-------WH")
+GL_FUNCTION(glad_glTexSubImage1D, PFNGLTEXSUBIMAGE1DPROC, "----WFTd")
+GL_FUNCTION(glad_glTexSubImage2D, PFNGLTEXSUBIMAGE2DPROC, "-----WHFTd")
+GL_FUNCTION(glad_glBindTexture, PFNGLBINDTEXTUREPROC, "--t")
+GL_FUNCTION(glad_glDeleteTextures, PFNGLDELETETEXTURESPROC, "-#t")
+GL_FUNCTION(glad_glGenTextures, PFNGLGENTEXTURESPROC, "-#t")
+GL_FUNCTION(glad_glIsTexture, PFNGLISTEXTUREPROC, "-t")
+GL_FUNCTION(glad_glDrawRangeElements, PFNGLDRAWRANGEELEMENTSPROC, "----#To")
+GL_FUNCTION(glad_glTexImage3D, PFNGLTEXIMAGE3DPROC, "----WHD-FTd")
+GL_FUNCTION(glad_glTexSubImage3D, PFNGLTEXSUBIMAGE3DPROC, "------WHDFTd")
+GL_FUNCTION(glad_glCopyTexSubImage3D, PFNGLCOPYTEXSUBIMAGE3DPROC, "--------WH")
+GL_FUNCTION(glad_glActiveTexture, PFNGLACTIVETEXTUREPROC, "--")
+GL_FUNCTION(glad_glSampleCoverage, PFNGLSAMPLECOVERAGEPROC, "---")
+GL_FUNCTION(glad_glCompressedTexImage3D, PFNGLCOMPRESSEDTEXIMAGE3DPROC, "----WHD-zd")
+GL_FUNCTION(glad_glCompressedTexImage2D, PFNGLCOMPRESSEDTEXIMAGE2DPROC, "----WH-zd")
+GL_FUNCTION(glad_glCompressedTexImage1D, PFNGLCOMPRESSEDTEXIMAGE1DPROC, "----W-zd")
+GL_FUNCTION(glad_glCompressedTexSubImage3D, PFNGLCOMPRESSEDTEXSUBIMAGE3DPROC, "------WHDFzd")
+GL_FUNCTION(glad_glCompressedTexSubImage2D, PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC, "-----WHFzd")
+GL_FUNCTION(glad_glCompressedTexSubImage1D, PFNGLCOMPRESSEDTEXSUBIMAGE1DPROC, "----WFzd")
+GL_FUNCTION(glad_glGetCompressedTexImage, PFNGLGETCOMPRESSEDTEXIMAGEPROC, "---*")
+GL_FUNCTION(glad_glBlendFuncSeparate, PFNGLBLENDFUNCSEPARATEPROC, "-----")
+GL_FUNCTION(glad_glMultiDrawArrays, PFNGLMULTIDRAWARRAYSPROC, "--dd-")
+GL_FUNCTION(glad_glMultiDrawElements, PFNGLMULTIDRAWELEMENTSPROC, "--dTo-")
+GL_FUNCTION(glad_glPointParameterf, PFNGLPOINTPARAMETERFPROC, "---")
+GL_FUNCTION(glad_glPointParameterfv, PFNGLPOINTPARAMETERFVPROC, "--d")
+GL_FUNCTION(glad_glPointParameteri, PFNGLPOINTPARAMETERIPROC, "---")
+GL_FUNCTION(glad_glPointParameteriv, PFNGLPOINTPARAMETERIVPROC, "--d")
+GL_FUNCTION(glad_glBlendColor, PFNGLBLENDCOLORPROC, "-----")
+GL_FUNCTION(glad_glBlendEquation, PFNGLBLENDEQUATIONPROC, "--")
+GL_FUNCTION(glad_glGenQueries, PFNGLGENQUERIESPROC, "-#q")
+GL_FUNCTION(glad_glDeleteQueries, PFNGLDELETEQUERIESPROC, "-#q")
+GL_FUNCTION(glad_glIsQuery, PFNGLISQUERYPROC, "-q")
+GL_FUNCTION(glad_glBeginQuery, PFNGLBEGINQUERYPROC, "--q")
+GL_FUNCTION(glad_glEndQuery, PFNGLENDQUERYPROC, "--")
+GL_FUNCTION(glad_glGetQueryiv, PFNGLGETQUERYIVPROC, "---*")
+GL_FUNCTION(glad_glGetQueryObjectiv, PFNGLGETQUERYOBJECTIVPROC, "-q-*")
+GL_FUNCTION(glad_glGetQueryObjectuiv, PFNGLGETQUERYOBJECTUIVPROC, "-q-*")
+GL_FUNCTION(glad_glBindBuffer, PFNGLBINDBUFFERPROC, "--b")
+GL_FUNCTION(glad_glDeleteBuffers, PFNGLDELETEBUFFERSPROC, "-#b")
+GL_FUNCTION(glad_glGenBuffers, PFNGLGENBUFFERSPROC, "-#b")
+GL_FUNCTION(glad_glIsBuffer, PFNGLISBUFFERPROC, "-b")
+GL_FUNCTION(glad_glBufferData, PFNGLBUFFERDATAPROC, "--zd-")
+GL_FUNCTION(glad_glBufferSubData, PFNGLBUFFERSUBDATAPROC, "---zd")
+GL_FUNCTION(glad_glGetBufferSubData, PFNGLGETBUFFERSUBDATAPROC, "---z*")
+GL_FUNCTION(glad_glMapBuffer, PFNGLMAPBUFFERPROC, "m--")
+GL_FUNCTION(glad_glUnmapBuffer, PFNGLUNMAPBUFFERPROC, "--")
+GL_FUNCTION(glad_glGetBufferParameteriv, PFNGLGETBUFFERPARAMETERIVPROC, "---*")
+GL_FUNCTION(glad_glGetBufferPointerv, PFNGLGETBUFFERPOINTERVPROC, "---*")
+GL_FUNCTION(glad_glBlendEquationSeparate, PFNGLBLENDEQUATIONSEPARATEPROC, "---")
+GL_FUNCTION(glad_glDrawBuffers, PFNGLDRAWBUFFERSPROC, "-#a")
+GL_FUNCTION(glad_glStencilOpSeparate, PFNGLSTENCILOPSEPARATEPROC, "-----")
+GL_FUNCTION(glad_glStencilFuncSeparate, PFNGLSTENCILFUNCSEPARATEPROC, "-----")
+GL_FUNCTION(glad_glStencilMaskSeparate, PFNGLSTENCILMASKSEPARATEPROC, "---")
+GL_FUNCTION(glad_glAttachShader, PFNGLATTACHSHADERPROC, "-ph")
+GL_FUNCTION(glad_glBindAttribLocation, PFNGLBINDATTRIBLOCATIONPROC, "-p-c")
+GL_FUNCTION(glad_glCompileShader, PFNGLCOMPILESHADERPROC, "-h")
+GL_FUNCTION(glad_glCreateProgram, PFNGLCREATEPROGRAMPROC, "p")
+GL_FUNCTION(glad_glCreateShader, PFNGLCREATESHADERPROC, "hT")
+GL_FUNCTION(glad_glDeleteProgram, PFNGLDELETEPROGRAMPROC, "-p")
+GL_FUNCTION(glad_glDeleteShader, PFNGLDELETESHADERPROC, "-h")
+GL_FUNCTION(glad_glDetachShader, PFNGLDETACHSHADERPROC, "-ph")
+GL_FUNCTION(glad_glDisableVertexAttribArray, PFNGLDISABLEVERTEXATTRIBARRAYPROC, "--")
+GL_FUNCTION(glad_glEnableVertexAttribArray, PFNGLENABLEVERTEXATTRIBARRAYPROC, "--")
+GL_FUNCTION(glad_glGetActiveAttrib, PFNGLGETACTIVEATTRIBPROC, "-p-z****")
+GL_FUNCTION(glad_glGetActiveUniform, PFNGLGETACTIVEUNIFORMPROC, "-p-z****")
+GL_FUNCTION(glad_glGetAttachedShaders, PFNGLGETATTACHEDSHADERSPROC, "-p-*h")
+GL_FUNCTION(glad_glGetAttribLocation, PFNGLGETATTRIBLOCATIONPROC, "-pc")
+GL_FUNCTION(glad_glGetProgramiv, PFNGLGETPROGRAMIVPROC, "-p-*")
+GL_FUNCTION(glad_glGetProgramInfoLog, PFNGLGETPROGRAMINFOLOGPROC, "-pz**")
+GL_FUNCTION(glad_glGetShaderiv, PFNGLGETSHADERIVPROC, "-h-*")
+GL_FUNCTION(glad_glGetShaderInfoLog, PFNGLGETSHADERINFOLOGPROC, "-hz**")
+GL_FUNCTION(glad_glGetShaderSource, PFNGLGETSHADERSOURCEPROC, "-hz**")
+GL_FUNCTION(glad_glGetUniformLocation, PFNGLGETUNIFORMLOCATIONPROC, "-pc")
+GL_FUNCTION(glad_glGetUniformfv, PFNGLGETUNIFORMFVPROC, "-p-*")
+GL_FUNCTION(glad_glGetUniformiv, PFNGLGETUNIFORMIVPROC, "-p-*")
+GL_FUNCTION(glad_glGetVertexAttribdv, PFNGLGETVERTEXATTRIBDVPROC, "---*")
+GL_FUNCTION(glad_glGetVertexAttribfv, PFNGLGETVERTEXATTRIBFVPROC, "---*")
+GL_FUNCTION(glad_glGetVertexAttribiv, PFNGLGETVERTEXATTRIBIVPROC, "---*")
+GL_FUNCTION(glad_glGetVertexAttribPointerv, PFNGLGETVERTEXATTRIBPOINTERVPROC, "---*")
+GL_FUNCTION(glad_glIsProgram, PFNGLISPROGRAMPROC, "-p")
+GL_FUNCTION(glad_glIsShader, PFNGLISSHADERPROC, "-h")
+GL_FUNCTION(glad_glLinkProgram, PFNGLLINKPROGRAMPROC, "-p")
+GL_FUNCTION(glad_glShaderSource, PFNGLSHADERSOURCEPROC, "-h#Sa")
+GL_FUNCTION(glad_glUseProgram, PFNGLUSEPROGRAMPROC, "-p")
+GL_FUNCTION(glad_glUniform1f, PFNGLUNIFORM1FPROC, "---")
+GL_FUNCTION(glad_glUniform2f, PFNGLUNIFORM2FPROC, "----")
+GL_FUNCTION(glad_glUniform3f, PFNGLUNIFORM3FPROC, "-----")
+GL_FUNCTION(glad_glUniform4f, PFNGLUNIFORM4FPROC, "------")
+GL_FUNCTION(glad_glUniform1i, PFNGLUNIFORM1IPROC, "---")
+GL_FUNCTION(glad_glUniform2i, PFNGLUNIFORM2IPROC, "----")
+GL_FUNCTION(glad_glUniform3i, PFNGLUNIFORM3IPROC, "-----")
+GL_FUNCTION(glad_glUniform4i, PFNGLUNIFORM4IPROC, "------")
+GL_FUNCTION(glad_glUniform1fv, PFNGLUNIFORM1FVPROC, "--#d")
+GL_FUNCTION(glad_glUniform2fv, PFNGLUNIFORM2FVPROC, "--#d")
+GL_FUNCTION(glad_glUniform3fv, PFNGLUNIFORM3FVPROC, "--#d")
+GL_FUNCTION(glad_glUniform4fv, PFNGLUNIFORM4FVPROC, "--#d")
+GL_FUNCTION(glad_glUniform1iv, PFNGLUNIFORM1IVPROC, "--#d")
+GL_FUNCTION(glad_glUniform2iv, PFNGLUNIFORM2IVPROC, "--#d")
+GL_FUNCTION(glad_glUniform3iv, PFNGLUNIFORM3IVPROC, "--#d")
+GL_FUNCTION(glad_glUniform4iv, PFNGLUNIFORM4IVPROC, "--#d")
+GL_FUNCTION(glad_glUniformMatrix2fv, PFNGLUNIFORMMATRIX2FVPROC, "--#-d")
+GL_FUNCTION(glad_glUniformMatrix3fv, PFNGLUNIFORMMATRIX3FVPROC, "--#-d")
+GL_FUNCTION(glad_glUniformMatrix4fv, PFNGLUNIFORMMATRIX4FVPROC, "--#-d")
+GL_FUNCTION(glad_glValidateProgram, PFNGLVALIDATEPROGRAMPROC, "-p")
+GL_FUNCTION(glad_glVertexAttrib1d, PFNGLVERTEXATTRIB1DPROC, "---")
+GL_FUNCTION(glad_glVertexAttrib1dv, PFNGLVERTEXATTRIB1DVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib1f, PFNGLVERTEXATTRIB1FPROC, "---")
+GL_FUNCTION(glad_glVertexAttrib1fv, PFNGLVERTEXATTRIB1FVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib1s, PFNGLVERTEXATTRIB1SPROC, "---")
+GL_FUNCTION(glad_glVertexAttrib1sv, PFNGLVERTEXATTRIB1SVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib2d, PFNGLVERTEXATTRIB2DPROC, "----")
+GL_FUNCTION(glad_glVertexAttrib2dv, PFNGLVERTEXATTRIB2DVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib2f, PFNGLVERTEXATTRIB2FPROC, "----")
+GL_FUNCTION(glad_glVertexAttrib2fv, PFNGLVERTEXATTRIB2FVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib2s, PFNGLVERTEXATTRIB2SPROC, "----")
+GL_FUNCTION(glad_glVertexAttrib2sv, PFNGLVERTEXATTRIB2SVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib3d, PFNGLVERTEXATTRIB3DPROC, "-----")
+GL_FUNCTION(glad_glVertexAttrib3dv, PFNGLVERTEXATTRIB3DVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib3f, PFNGLVERTEXATTRIB3FPROC, "-----")
+GL_FUNCTION(glad_glVertexAttrib3fv, PFNGLVERTEXATTRIB3FVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib3s, PFNGLVERTEXATTRIB3SPROC, "-----")
+GL_FUNCTION(glad_glVertexAttrib3sv, PFNGLVERTEXATTRIB3SVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib4Nbv, PFNGLVERTEXATTRIB4NBVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib4Niv, PFNGLVERTEXATTRIB4NIVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib4Nsv, PFNGLVERTEXATTRIB4NSVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib4Nub, PFNGLVERTEXATTRIB4NUBPROC, "------")
+GL_FUNCTION(glad_glVertexAttrib4Nubv, PFNGLVERTEXATTRIB4NUBVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib4Nuiv, PFNGLVERTEXATTRIB4NUIVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib4Nusv, PFNGLVERTEXATTRIB4NUSVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib4bv, PFNGLVERTEXATTRIB4BVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib4d, PFNGLVERTEXATTRIB4DPROC, "------")
+GL_FUNCTION(glad_glVertexAttrib4dv, PFNGLVERTEXATTRIB4DVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib4f, PFNGLVERTEXATTRIB4FPROC, "------")
+GL_FUNCTION(glad_glVertexAttrib4fv, PFNGLVERTEXATTRIB4FVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib4iv, PFNGLVERTEXATTRIB4IVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib4s, PFNGLVERTEXATTRIB4SPROC, "------")
+GL_FUNCTION(glad_glVertexAttrib4sv, PFNGLVERTEXATTRIB4SVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib4ubv, PFNGLVERTEXATTRIB4UBVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib4uiv, PFNGLVERTEXATTRIB4UIVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttrib4usv, PFNGLVERTEXATTRIB4USVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribPointer, PFNGLVERTEXATTRIBPOINTERPROC, "---T--o")
+GL_FUNCTION(glad_glUniformMatrix2x3fv, PFNGLUNIFORMMATRIX2X3FVPROC, "--#-d")
+GL_FUNCTION(glad_glUniformMatrix3x2fv, PFNGLUNIFORMMATRIX3X2FVPROC, "--#-d")
+GL_FUNCTION(glad_glUniformMatrix2x4fv, PFNGLUNIFORMMATRIX2X4FVPROC, "--#-d")
+GL_FUNCTION(glad_glUniformMatrix4x2fv, PFNGLUNIFORMMATRIX4X2FVPROC, "--#-d")
+GL_FUNCTION(glad_glUniformMatrix3x4fv, PFNGLUNIFORMMATRIX3X4FVPROC, "--#-d")
+GL_FUNCTION(glad_glUniformMatrix4x3fv, PFNGLUNIFORMMATRIX4X3FVPROC, "--#-d")
+GL_FUNCTION(glad_glColorMaski, PFNGLCOLORMASKIPROC, "------")
+GL_FUNCTION(glad_glGetBooleani_v, PFNGLGETBOOLEANI_VPROC, "---*")
+GL_FUNCTION(glad_glGetIntegeri_v, PFNGLGETINTEGERI_VPROC, "---*")
+GL_FUNCTION(glad_glEnablei, PFNGLENABLEIPROC, "---")
+GL_FUNCTION(glad_glDisablei, PFNGLDISABLEIPROC, "---")
+GL_FUNCTION(glad_glIsEnabledi, PFNGLISENABLEDIPROC, "---")
+GL_FUNCTION(glad_glBeginTransformFeedback, PFNGLBEGINTRANSFORMFEEDBACKPROC, "--")
+GL_FUNCTION(glad_glEndTransformFeedback, PFNGLENDTRANSFORMFEEDBACKPROC, "-")
+GL_FUNCTION(glad_glBindBufferRange, PFNGLBINDBUFFERRANGEPROC, "---b-z")
+GL_FUNCTION(glad_glBindBufferBase, PFNGLBINDBUFFERBASEPROC, "---b")
+GL_FUNCTION(glad_glTransformFeedbackVaryings, PFNGLTRANSFORMFEEDBACKVARYINGSPROC, "-p#S-")
+GL_FUNCTION(glad_glGetTransformFeedbackVarying, PFNGLGETTRANSFORMFEEDBACKVARYINGPROC, "-p-z****")
+GL_FUNCTION(glad_glClampColor, PFNGLCLAMPCOLORPROC, "---")
+GL_FUNCTION(glad_glBeginConditionalRender, PFNGLBEGINCONDITIONALRENDERPROC, "---")
+GL_FUNCTION(glad_glEndConditionalRender, PFNGLENDCONDITIONALRENDERPROC, "-")
+GL_FUNCTION(glad_glVertexAttribIPointer, PFNGLVERTEXATTRIBIPOINTERPROC, "---T-o")
+GL_FUNCTION(glad_glGetVertexAttribIiv, PFNGLGETVERTEXATTRIBIIVPROC, "---*")
+GL_FUNCTION(glad_glGetVertexAttribIuiv, PFNGLGETVERTEXATTRIBIUIVPROC, "---*")
+GL_FUNCTION(glad_glVertexAttribI1i, PFNGLVERTEXATTRIBI1IPROC, "---")
+GL_FUNCTION(glad_glVertexAttribI2i, PFNGLVERTEXATTRIBI2IPROC, "----")
+GL_FUNCTION(glad_glVertexAttribI3i, PFNGLVERTEXATTRIBI3IPROC, "-----")
+GL_FUNCTION(glad_glVertexAttribI4i, PFNGLVERTEXATTRIBI4IPROC, "------")
+GL_FUNCTION(glad_glVertexAttribI1ui, PFNGLVERTEXATTRIBI1UIPROC, "---")
+GL_FUNCTION(glad_glVertexAttribI2ui, PFNGLVERTEXATTRIBI2UIPROC, "----")
+GL_FUNCTION(glad_glVertexAttribI3ui, PFNGLVERTEXATTRIBI3UIPROC, "-----")
+GL_FUNCTION(glad_glVertexAttribI4ui, PFNGLVERTEXATTRIBI4UIPROC, "------")
+GL_FUNCTION(glad_glVertexAttribI1iv, PFNGLVERTEXATTRIBI1IVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribI2iv, PFNGLVERTEXATTRIBI2IVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribI3iv, PFNGLVERTEXATTRIBI3IVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribI4iv, PFNGLVERTEXATTRIBI4IVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribI1uiv, PFNGLVERTEXATTRIBI1UIVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribI2uiv, PFNGLVERTEXATTRIBI2UIVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribI3uiv, PFNGLVERTEXATTRIBI3UIVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribI4uiv, PFNGLVERTEXATTRIBI4UIVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribI4bv, PFNGLVERTEXATTRIBI4BVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribI4sv, PFNGLVERTEXATTRIBI4SVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribI4ubv, PFNGLVERTEXATTRIBI4UBVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribI4usv, PFNGLVERTEXATTRIBI4USVPROC, "--d")
+GL_FUNCTION(glad_glGetUniformuiv, PFNGLGETUNIFORMUIVPROC, "-p-*")
+GL_FUNCTION(glad_glBindFragDataLocation, PFNGLBINDFRAGDATALOCATIONPROC, "-p-c")
+GL_FUNCTION(glad_glGetFragDataLocation, PFNGLGETFRAGDATALOCATIONPROC, "-pc")
+GL_FUNCTION(glad_glUniform1ui, PFNGLUNIFORM1UIPROC, "---")
+GL_FUNCTION(glad_glUniform2ui, PFNGLUNIFORM2UIPROC, "----")
+GL_FUNCTION(glad_glUniform3ui, PFNGLUNIFORM3UIPROC, "-----")
+GL_FUNCTION(glad_glUniform4ui, PFNGLUNIFORM4UIPROC, "------")
+GL_FUNCTION(glad_glUniform1uiv, PFNGLUNIFORM1UIVPROC, "--#d")
+GL_FUNCTION(glad_glUniform2uiv, PFNGLUNIFORM2UIVPROC, "--#d")
+GL_FUNCTION(glad_glUniform3uiv, PFNGLUNIFORM3UIVPROC, "--#d")
+GL_FUNCTION(glad_glUniform4uiv, PFNGLUNIFORM4UIVPROC, "--#d")
+GL_FUNCTION(glad_glTexParameterIiv, PFNGLTEXPARAMETERIIVPROC, "---d")
+GL_FUNCTION(glad_glTexParameterIuiv, PFNGLTEXPARAMETERIUIVPROC, "---d")
+GL_FUNCTION(glad_glGetTexParameterIiv, PFNGLGETTEXPARAMETERIIVPROC, "---*")
+GL_FUNCTION(glad_glGetTexParameterIuiv, PFNGLGETTEXPARAMETERIUIVPROC, "---*")
+GL_FUNCTION(glad_glClearBufferiv, PFNGLCLEARBUFFERIVPROC, "---d")
+GL_FUNCTION(glad_glClearBufferuiv, PFNGLCLEARBUFFERUIVPROC, "---d")
+GL_FUNCTION(glad_glClearBufferfv, PFNGLCLEARBUFFERFVPROC, "---d")
+GL_FUNCTION(glad_glClearBufferfi, PFNGLCLEARBUFFERFIPROC, "-----")
+GL_FUNCTION(glad_glGetStringi, PFNGLGETSTRINGIPROC, "---")
+GL_FUNCTION(glad_glIsRenderbuffer, PFNGLISRENDERBUFFERPROC, "-r")
+GL_FUNCTION(glad_glBindRenderbuffer, PFNGLBINDRENDERBUFFERPROC, "--r")
+GL_FUNCTION(glad_glDeleteRenderbuffers, PFNGLDELETERENDERBUFFERSPROC, "-#r")
+GL_FUNCTION(glad_glGenRenderbuffers, PFNGLGENRENDERBUFFERSPROC, "-#r")
+GL_FUNCTION(glad_glRenderbufferStorage, PFNGLRENDERBUFFERSTORAGEPROC, "---WH")
+GL_FUNCTION(glad_glGetRenderbufferParameteriv, PFNGLGETRENDERBUFFERPARAMETERIVPROC, "---*")
+GL_FUNCTION(glad_glIsFramebuffer, PFNGLISFRAMEBUFFERPROC, "-f")
+GL_FUNCTION(glad_glBindFramebuffer, PFNGLBINDFRAMEBUFFERPROC, "--f")
+GL_FUNCTION(glad_glDeleteFramebuffers, PFNGLDELETEFRAMEBUFFERSPROC, "-#f")
+GL_FUNCTION(glad_glGenFramebuffers, PFNGLGENFRAMEBUFFERSPROC, "-#f")
+GL_FUNCTION(glad_glCheckFramebufferStatus, PFNGLCHECKFRAMEBUFFERSTATUSPROC, "--")
+GL_FUNCTION(glad_glFramebufferTexture1D, PFNGLFRAMEBUFFERTEXTURE1DPROC, "----t-")
+GL_FUNCTION(glad_glFramebufferTexture2D, PFNGLFRAMEBUFFERTEXTURE2DPROC, "----t-")
+GL_FUNCTION(glad_glFramebufferTexture3D, PFNGLFRAMEBUFFERTEXTURE3DPROC, "----t--")
+GL_FUNCTION(glad_glFramebufferRenderbuffer, PFNGLFRAMEBUFFERRENDERBUFFERPROC, "----r")
+GL_FUNCTION(glad_glGetFramebufferAttachmentParameteriv, PFNGLGETFRAMEBUFFERATTACHMENTPARAMETERIVPROC, "----*")
+GL_FUNCTION(glad_glGenerateMipmap, PFNGLGENERATEMIPMAPPROC, "--")
+GL_FUNCTION(glad_glBlitFramebuffer, PFNGLBLITFRAMEBUFFERPROC, "-----------")
+GL_FUNCTION(glad_glRenderbufferStorageMultisample, PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC, "----WH")
+GL_FUNCTION(glad_glFramebufferTextureLayer, PFNGLFRAMEBUFFERTEXTURELAYERPROC, "---t--")
+GL_FUNCTION(glad_glMapBufferRange, PFNGLMAPBUFFERRANGEPROC, "m----")
+GL_FUNCTION(glad_glFlushMappedBufferRange, PFNGLFLUSHMAPPEDBUFFERRANGEPROC, "----")
+GL_FUNCTION(glad_glBindVertexArray, PFNGLBINDVERTEXARRAYPROC, "-v")
+GL_FUNCTION(glad_glDeleteVertexArrays, PFNGLDELETEVERTEXARRAYSPROC, "-#v")
+GL_FUNCTION(glad_glGenVertexArrays, PFNGLGENVERTEXARRAYSPROC, "-#v")
+GL_FUNCTION(glad_glIsVertexArray, PFNGLISVERTEXARRAYPROC, "-v")
+GL_FUNCTION(glad_glDrawArraysInstanced, PFNGLDRAWARRAYSINSTANCEDPROC, "---#-")
+GL_FUNCTION(glad_glDrawElementsInstanced, PFNGLDRAWELEMENTSINSTANCEDPROC, "--#To-")
+GL_FUNCTION(glad_glTexBuffer, PFNGLTEXBUFFERPROC, "---b")
+GL_FUNCTION(glad_glPrimitiveRestartIndex, PFNGLPRIMITIVERESTARTINDEXPROC, "--")
+GL_FUNCTION(glad_glCopyBufferSubData, PFNGLCOPYBUFFERSUBDATAPROC, "-----z")
+GL_FUNCTION(glad_glGetUniformIndices, PFNGLGETUNIFORMINDICESPROC, "-p-S*")
+GL_FUNCTION(glad_glGetActiveUniformsiv, PFNGLGETACTIVEUNIFORMSIVPROC, "-p-d-*")
+GL_FUNCTION(glad_glGetActiveUniformName, PFNGLGETACTIVEUNIFORMNAMEPROC, "-p-z**")
+GL_FUNCTION(glad_glGetUniformBlockIndex, PFNGLGETUNIFORMBLOCKINDEXPROC, "-pc")
+GL_FUNCTION(glad_glGetActiveUniformBlockiv, PFNGLGETACTIVEUNIFORMBLOCKIVPROC, "-p--*")
+GL_FUNCTION(glad_glGetActiveUniformBlockName, PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC, "-p-z**")
+GL_FUNCTION(glad_glUniformBlockBinding, PFNGLUNIFORMBLOCKBINDINGPROC, "-p--")
+GL_FUNCTION(glad_glDrawElementsBaseVertex, PFNGLDRAWELEMENTSBASEVERTEXPROC, "--#To-")
+GL_FUNCTION(glad_glDrawRangeElementsBaseVertex, PFNGLDRAWRANGEELEMENTSBASEVERTEXPROC, "----#To-")
+GL_FUNCTION(glad_glDrawElementsInstancedBaseVertex, PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXPROC, "--#To--")
+GL_FUNCTION(glad_glMultiDrawElementsBaseVertex, PFNGLMULTIDRAWELEMENTSBASEVERTEXPROC, "--dTo-d")
+GL_FUNCTION(glad_glProvokingVertex, PFNGLPROVOKINGVERTEXPROC, "--")
+GL_FUNCTION(glad_glFenceSync, PFNGLFENCESYNCPROC, "y--")
+GL_FUNCTION(glad_glIsSync, PFNGLISSYNCPROC, "-y")
+GL_FUNCTION(glad_glDeleteSync, PFNGLDELETESYNCPROC, "-y")
+GL_FUNCTION(glad_glClientWaitSync, PFNGLCLIENTWAITSYNCPROC, "-y--")
+GL_FUNCTION(glad_glWaitSync, PFNGLWAITSYNCPROC, "-y--")
+GL_FUNCTION(glad_glGetInteger64v, PFNGLGETINTEGER64VPROC, "--*")
+GL_FUNCTION(glad_glGetSynciv, PFNGLGETSYNCIVPROC, "-y-z**")
+GL_FUNCTION(glad_glGetInteger64i_v, PFNGLGETINTEGER64I_VPROC, "---*")
+GL_FUNCTION(glad_glGetBufferParameteri64v, PFNGLGETBUFFERPARAMETERI64VPROC, "---*")
+GL_FUNCTION(glad_glFramebufferTexture, PFNGLFRAMEBUFFERTEXTUREPROC, "---t-")
+GL_FUNCTION(glad_glTexImage2DMultisample, PFNGLTEXIMAGE2DMULTISAMPLEPROC, "----WH-")
+GL_FUNCTION(glad_glTexImage3DMultisample, PFNGLTEXIMAGE3DMULTISAMPLEPROC, "----WHD-")
+GL_FUNCTION(glad_glGetMultisamplefv, PFNGLGETMULTISAMPLEFVPROC, "---*")
+GL_FUNCTION(glad_glSampleMaski, PFNGLSAMPLEMASKIPROC, "---")
+GL_FUNCTION(glad_glBindFragDataLocationIndexed, PFNGLBINDFRAGDATALOCATIONINDEXEDPROC, "-p--c")
+GL_FUNCTION(glad_glGetFragDataIndex, PFNGLGETFRAGDATAINDEXPROC, "-pc")
+GL_FUNCTION(glad_glGenSamplers, PFNGLGENSAMPLERSPROC, "-#s")
+GL_FUNCTION(glad_glDeleteSamplers, PFNGLDELETESAMPLERSPROC, "-#s")
+GL_FUNCTION(glad_glIsSampler, PFNGLISSAMPLERPROC, "-s")
+GL_FUNCTION(glad_glBindSampler, PFNGLBINDSAMPLERPROC, "--s")
+GL_FUNCTION(glad_glSamplerParameteri, PFNGLSAMPLERPARAMETERIPROC, "-s--")
+GL_FUNCTION(glad_glSamplerParameteriv, PFNGLSAMPLERPARAMETERIVPROC, "-s-d")
+GL_FUNCTION(glad_glSamplerParameterf, PFNGLSAMPLERPARAMETERFPROC, "-s--")
+GL_FUNCTION(glad_glSamplerParameterfv, PFNGLSAMPLERPARAMETERFVPROC, "-s-d")
+GL_FUNCTION(glad_glSamplerParameterIiv, PFNGLSAMPLERPARAMETERIIVPROC, "-s-d")
+GL_FUNCTION(glad_glSamplerParameterIuiv, PFNGLSAMPLERPARAMETERIUIVPROC, "-s-d")
+GL_FUNCTION(glad_glGetSamplerParameteriv, PFNGLGETSAMPLERPARAMETERIVPROC, "-s-*")
+GL_FUNCTION(glad_glGetSamplerParameterIiv, PFNGLGETSAMPLERPARAMETERIIVPROC, "-s-*")
+GL_FUNCTION(glad_glGetSamplerParameterfv, PFNGLGETSAMPLERPARAMETERFVPROC, "-s-*")
+GL_FUNCTION(glad_glGetSamplerParameterIuiv, PFNGLGETSAMPLERPARAMETERIUIVPROC, "-s-*")
+GL_FUNCTION(glad_glQueryCounter, PFNGLQUERYCOUNTERPROC, "-q-")
+GL_FUNCTION(glad_glGetQueryObjecti64v, PFNGLGETQUERYOBJECTI64VPROC, "-q-*")
+GL_FUNCTION(glad_glGetQueryObjectui64v, PFNGLGETQUERYOBJECTUI64VPROC, "-q-*")
+GL_FUNCTION(glad_glVertexAttribDivisor, PFNGLVERTEXATTRIBDIVISORPROC, "---")
+GL_FUNCTION(glad_glVertexAttribP1ui, PFNGLVERTEXATTRIBP1UIPROC, "--T--")
+GL_FUNCTION(glad_glVertexAttribP1uiv, PFNGLVERTEXATTRIBP1UIVPROC, "--T-d")
+GL_FUNCTION(glad_glVertexAttribP2ui, PFNGLVERTEXATTRIBP2UIPROC, "--T--")
+GL_FUNCTION(glad_glVertexAttribP2uiv, PFNGLVERTEXATTRIBP2UIVPROC, "--T-d")
+GL_FUNCTION(glad_glVertexAttribP3ui, PFNGLVERTEXATTRIBP3UIPROC, "--T--")
+GL_FUNCTION(glad_glVertexAttribP3uiv, PFNGLVERTEXATTRIBP3UIVPROC, "--T-d")
+GL_FUNCTION(glad_glVertexAttribP4ui, PFNGLVERTEXATTRIBP4UIPROC, "--T--")
+GL_FUNCTION(glad_glVertexAttribP4uiv, PFNGLVERTEXATTRIBP4UIVPROC, "--T-d")
+GL_FUNCTION(glad_glVertexP2ui, PFNGLVERTEXP2UIPROC, "-T-")
+GL_FUNCTION(glad_glVertexP2uiv, PFNGLVERTEXP2UIVPROC, "-Td")
+GL_FUNCTION(glad_glVertexP3ui, PFNGLVERTEXP3UIPROC, "-T-")
+GL_FUNCTION(glad_glVertexP3uiv, PFNGLVERTEXP3UIVPROC, "-Td")
+GL_FUNCTION(glad_glVertexP4ui, PFNGLVERTEXP4UIPROC, "-T-")
+GL_FUNCTION(glad_glVertexP4uiv, PFNGLVERTEXP4UIVPROC, "-Td")
+GL_FUNCTION(glad_glTexCoordP1ui, PFNGLTEXCOORDP1UIPROC, "-T-")
+GL_FUNCTION(glad_glTexCoordP1uiv, PFNGLTEXCOORDP1UIVPROC, "-Td")
+GL_FUNCTION(glad_glTexCoordP2ui, PFNGLTEXCOORDP2UIPROC, "-T-")
+GL_FUNCTION(glad_glTexCoordP2uiv, PFNGLTEXCOORDP2UIVPROC, "-Td")
+GL_FUNCTION(glad_glTexCoordP3ui, PFNGLTEXCOORDP3UIPROC, "-T-")
+GL_FUNCTION(glad_glTexCoordP3uiv, PFNGLTEXCOORDP3UIVPROC, "-Td")
+GL_FUNCTION(glad_glTexCoordP4ui, PFNGLTEXCOORDP4UIPROC, "-T-")
+GL_FUNCTION(glad_glTexCoordP4uiv, PFNGLTEXCOORDP4UIVPROC, "-Td")
+GL_FUNCTION(glad_glMultiTexCoordP1ui, PFNGLMULTITEXCOORDP1UIPROC, "--T-")
+GL_FUNCTION(glad_glMultiTexCoordP1uiv, PFNGLMULTITEXCOORDP1UIVPROC, "--Td")
+GL_FUNCTION(glad_glMultiTexCoordP2ui, PFNGLMULTITEXCOORDP2UIPROC, "--T-")
+GL_FUNCTION(glad_glMultiTexCoordP2uiv, PFNGLMULTITEXCOORDP2UIVPROC, "--Td")
+GL_FUNCTION(glad_glMultiTexCoordP3ui, PFNGLMULTITEXCOORDP3UIPROC, "--T-")
+GL_FUNCTION(glad_glMultiTexCoordP3uiv, PFNGLMULTITEXCOORDP3UIVPROC, "--Td")
+GL_FUNCTION(glad_glMultiTexCoordP4ui, PFNGLMULTITEXCOORDP4UIPROC, "--T-")
+GL_FUNCTION(glad_glMultiTexCoordP4uiv, PFNGLMULTITEXCOORDP4UIVPROC, "--Td")
+GL_FUNCTION(glad_glNormalP3ui, PFNGLNORMALP3UIPROC, "-T-")
+GL_FUNCTION(glad_glNormalP3uiv, PFNGLNORMALP3UIVPROC, "-Td")
+GL_FUNCTION(glad_glColorP3ui, PFNGLCOLORP3UIPROC, "-T-")
+GL_FUNCTION(glad_glColorP3uiv, PFNGLCOLORP3UIVPROC, "-Td")
+GL_FUNCTION(glad_glColorP4ui, PFNGLCOLORP4UIPROC, "-T-")
+GL_FUNCTION(glad_glColorP4uiv, PFNGLCOLORP4UIVPROC, "-Td")
+GL_FUNCTION(glad_glSecondaryColorP3ui, PFNGLSECONDARYCOLORP3UIPROC, "-T-")
+GL_FUNCTION(glad_glSecondaryColorP3uiv, PFNGLSECONDARYCOLORP3UIVPROC, "-Td")
+GL_FUNCTION(glad_glMinSampleShading, PFNGLMINSAMPLESHADINGPROC, "--")
+GL_FUNCTION(glad_glBlendEquationi, PFNGLBLENDEQUATIONIPROC, "---")
+GL_FUNCTION(glad_glBlendEquationSeparatei, PFNGLBLENDEQUATIONSEPARATEIPROC, "----")
+GL_FUNCTION(glad_glBlendFunci, PFNGLBLENDFUNCIPROC, "----")
+GL_FUNCTION(glad_glBlendFuncSeparatei, PFNGLBLENDFUNCSEPARATEIPROC, "------")
+GL_FUNCTION(glad_glDrawArraysIndirect, PFNGLDRAWARRAYSINDIRECTPROC, "--o")
+GL_FUNCTION(glad_glDrawElementsIndirect, PFNGLDRAWELEMENTSINDIRECTPROC, "--To")
+GL_FUNCTION(glad_glUniform1d, PFNGLUNIFORM1DPROC, "---")
+GL_FUNCTION(glad_glUniform2d, PFNGLUNIFORM2DPROC, "----")
+GL_FUNCTION(glad_glUniform3d, PFNGLUNIFORM3DPROC, "-----")
+GL_FUNCTION(glad_glUniform4d, PFNGLUNIFORM4DPROC, "------")
+GL_FUNCTION(glad_glUniform1dv, PFNGLUNIFORM1DVPROC, "--#d")
+GL_FUNCTION(glad_glUniform2dv, PFNGLUNIFORM2DVPROC, "--#d")
+GL_FUNCTION(glad_glUniform3dv, PFNGLUNIFORM3DVPROC, "--#d")
+GL_FUNCTION(glad_glUniform4dv, PFNGLUNIFORM4DVPROC, "--#d")
+GL_FUNCTION(glad_glUniformMatrix2dv, PFNGLUNIFORMMATRIX2DVPROC, "--#-d")
+GL_FUNCTION(glad_glUniformMatrix3dv, PFNGLUNIFORMMATRIX3DVPROC, "--#-d")
+GL_FUNCTION(glad_glUniformMatrix4dv, PFNGLUNIFORMMATRIX4DVPROC, "--#-d")
+GL_FUNCTION(glad_glUniformMatrix2x3dv, PFNGLUNIFORMMATRIX2X3DVPROC, "--#-d")
+GL_FUNCTION(glad_glUniformMatrix2x4dv, PFNGLUNIFORMMATRIX2X4DVPROC, "--#-d")
+GL_FUNCTION(glad_glUniformMatrix3x2dv, PFNGLUNIFORMMATRIX3X2DVPROC, "--#-d")
+GL_FUNCTION(glad_glUniformMatrix3x4dv, PFNGLUNIFORMMATRIX3X4DVPROC, "--#-d")
+GL_FUNCTION(glad_glUniformMatrix4x2dv, PFNGLUNIFORMMATRIX4X2DVPROC, "--#-d")
+GL_FUNCTION(glad_glUniformMatrix4x3dv, PFNGLUNIFORMMATRIX4X3DVPROC, "--#-d")
+GL_FUNCTION(glad_glGetUniformdv, PFNGLGETUNIFORMDVPROC, "-p-*")
+GL_FUNCTION(glad_glGetSubroutineUniformLocation, PFNGLGETSUBROUTINEUNIFORMLOCATIONPROC, "-p-c")
+GL_FUNCTION(glad_glGetSubroutineIndex, PFNGLGETSUBROUTINEINDEXPROC, "-p-c")
+GL_FUNCTION(glad_glGetActiveSubroutineUniformiv, PFNGLGETACTIVESUBROUTINEUNIFORMIVPROC, "-p---*")
+GL_FUNCTION(glad_glGetActiveSubroutineUniformName, PFNGLGETACTIVESUBROUTINEUNIFORMNAMEPROC, "-p---**")
+GL_FUNCTION(glad_glGetActiveSubroutineName, PFNGLGETACTIVESUBROUTINENAMEPROC, "-p---**")
+GL_FUNCTION(glad_glUniformSubroutinesuiv, PFNGLUNIFORMSUBROUTINESUIVPROC, "--#d")
+GL_FUNCTION(glad_glGetUniformSubroutineuiv, PFNGLGETUNIFORMSUBROUTINEUIVPROC, "---*")
+GL_FUNCTION(glad_glGetProgramStageiv, PFNGLGETPROGRAMSTAGEIVPROC, "-p--*")
+GL_FUNCTION(glad_glPatchParameteri, PFNGLPATCHPARAMETERIPROC, "---")
+GL_FUNCTION(glad_glPatchParameterfv, PFNGLPATCHPARAMETERFVPROC, "--d")
+GL_FUNCTION(glad_glBindTransformFeedback, PFNGLBINDTRANSFORMFEEDBACKPROC, "--x")
+GL_FUNCTION(glad_glDeleteTransformFeedbacks, PFNGLDELETETRANSFORMFEEDBACKSPROC, "-#x")
+GL_FUNCTION(glad_glGenTransformFeedbacks, PFNGLGENTRANSFORMFEEDBACKSPROC, "-#x")
+GL_FUNCTION(glad_glIsTransformFeedback, PFNGLISTRANSFORMFEEDBACKPROC, "-x")
+GL_FUNCTION(glad_glPauseTransformFeedback, PFNGLPAUSETRANSFORMFEEDBACKPROC, "-")
+GL_FUNCTION(glad_glResumeTransformFeedback, PFNGLRESUMETRANSFORMFEEDBACKPROC, "-")
+GL_FUNCTION(glad_glDrawTransformFeedback, PFNGLDRAWTRANSFORMFEEDBACKPROC, "--x")
+GL_FUNCTION(glad_glDrawTransformFeedbackStream, PFNGLDRAWTRANSFORMFEEDBACKSTREAMPROC, "--x-")
+GL_FUNCTION(glad_glBeginQueryIndexed, PFNGLBEGINQUERYINDEXEDPROC, "---q")
+GL_FUNCTION(glad_glEndQueryIndexed, PFNGLENDQUERYINDEXEDPROC, "---")
+GL_FUNCTION(glad_glGetQueryIndexediv, PFNGLGETQUERYINDEXEDIVPROC, "----*")
+GL_FUNCTION(glad_glReleaseShaderCompiler, PFNGLRELEASESHADERCOMPILERPROC, "-")
+GL_FUNCTION(glad_glShaderBinary, PFNGLSHADERBINARYPROC, "-#h-dl")
+GL_FUNCTION(glad_glGetShaderPrecisionFormat, PFNGLGETSHADERPRECISIONFORMATPROC, "---**")
+GL_FUNCTION(glad_glDepthRangef, PFNGLDEPTHRANGEFPROC, "---")
+GL_FUNCTION(glad_glClearDepthf, PFNGLCLEARDEPTHFPROC, "--")
+GL_FUNCTION(glad_glGetProgramBinary, PFNGLGETPROGRAMBINARYPROC, "-pz***")
+GL_FUNCTION(glad_glProgramBinary, PFNGLPROGRAMBINARYPROC, "-p-dl")
+GL_FUNCTION(glad_glProgramParameteri, PFNGLPROGRAMPARAMETERIPROC, "-p--")
+GL_FUNCTION(glad_glUseProgramStages, PFNGLUSEPROGRAMSTAGESPROC, "-P-p")
+GL_FUNCTION(glad_glActiveShaderProgram, PFNGLACTIVESHADERPROGRAMPROC, "-Pp")
+GL_FUNCTION(glad_glCreateShaderProgramv, PFNGLCREATESHADERPROGRAMVPROC, "pT#S")
+GL_FUNCTION(glad_glBindProgramPipeline, PFNGLBINDPROGRAMPIPELINEPROC, "-P")
+GL_FUNCTION(glad_glDeleteProgramPipelines, PFNGLDELETEPROGRAMPIPELINESPROC, "-#P")
+GL_FUNCTION(glad_glGenProgramPipelines, PFNGLGENPROGRAMPIPELINESPROC, "-#P")
+GL_FUNCTION(glad_glIsProgramPipeline, PFNGLISPROGRAMPIPELINEPROC, "-P")
+GL_FUNCTION(glad_glGetProgramPipelineiv, PFNGLGETPROGRAMPIPELINEIVPROC, "-P-*")
+GL_FUNCTION(glad_glProgramUniform1i, PFNGLPROGRAMUNIFORM1IPROC, "-p--")
+GL_FUNCTION(glad_glProgramUniform1iv, PFNGLPROGRAMUNIFORM1IVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniform1f, PFNGLPROGRAMUNIFORM1FPROC, "-p--")
+GL_FUNCTION(glad_glProgramUniform1fv, PFNGLPROGRAMUNIFORM1FVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniform1d, PFNGLPROGRAMUNIFORM1DPROC, "-p--")
+GL_FUNCTION(glad_glProgramUniform1dv, PFNGLPROGRAMUNIFORM1DVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniform1ui, PFNGLPROGRAMUNIFORM1UIPROC, "-p--")
+GL_FUNCTION(glad_glProgramUniform1uiv, PFNGLPROGRAMUNIFORM1UIVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniform2i, PFNGLPROGRAMUNIFORM2IPROC, "-p---")
+GL_FUNCTION(glad_glProgramUniform2iv, PFNGLPROGRAMUNIFORM2IVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniform2f, PFNGLPROGRAMUNIFORM2FPROC, "-p---")
+GL_FUNCTION(glad_glProgramUniform2fv, PFNGLPROGRAMUNIFORM2FVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniform2d, PFNGLPROGRAMUNIFORM2DPROC, "-p---")
+GL_FUNCTION(glad_glProgramUniform2dv, PFNGLPROGRAMUNIFORM2DVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniform2ui, PFNGLPROGRAMUNIFORM2UIPROC, "-p---")
+GL_FUNCTION(glad_glProgramUniform2uiv, PFNGLPROGRAMUNIFORM2UIVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniform3i, PFNGLPROGRAMUNIFORM3IPROC, "-p----")
+GL_FUNCTION(glad_glProgramUniform3iv, PFNGLPROGRAMUNIFORM3IVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniform3f, PFNGLPROGRAMUNIFORM3FPROC, "-p----")
+GL_FUNCTION(glad_glProgramUniform3fv, PFNGLPROGRAMUNIFORM3FVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniform3d, PFNGLPROGRAMUNIFORM3DPROC, "-p----")
+GL_FUNCTION(glad_glProgramUniform3dv, PFNGLPROGRAMUNIFORM3DVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniform3ui, PFNGLPROGRAMUNIFORM3UIPROC, "-p----")
+GL_FUNCTION(glad_glProgramUniform3uiv, PFNGLPROGRAMUNIFORM3UIVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniform4i, PFNGLPROGRAMUNIFORM4IPROC, "-p-----")
+GL_FUNCTION(glad_glProgramUniform4iv, PFNGLPROGRAMUNIFORM4IVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniform4f, PFNGLPROGRAMUNIFORM4FPROC, "-p-----")
+GL_FUNCTION(glad_glProgramUniform4fv, PFNGLPROGRAMUNIFORM4FVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniform4d, PFNGLPROGRAMUNIFORM4DPROC, "-p-----")
+GL_FUNCTION(glad_glProgramUniform4dv, PFNGLPROGRAMUNIFORM4DVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniform4ui, PFNGLPROGRAMUNIFORM4UIPROC, "-p-----")
+GL_FUNCTION(glad_glProgramUniform4uiv, PFNGLPROGRAMUNIFORM4UIVPROC, "-p-#d")
+GL_FUNCTION(glad_glProgramUniformMatrix2fv, PFNGLPROGRAMUNIFORMMATRIX2FVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix3fv, PFNGLPROGRAMUNIFORMMATRIX3FVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix4fv, PFNGLPROGRAMUNIFORMMATRIX4FVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix2dv, PFNGLPROGRAMUNIFORMMATRIX2DVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix3dv, PFNGLPROGRAMUNIFORMMATRIX3DVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix4dv, PFNGLPROGRAMUNIFORMMATRIX4DVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix2x3fv, PFNGLPROGRAMUNIFORMMATRIX2X3FVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix3x2fv, PFNGLPROGRAMUNIFORMMATRIX3X2FVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix2x4fv, PFNGLPROGRAMUNIFORMMATRIX2X4FVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix4x2fv, PFNGLPROGRAMUNIFORMMATRIX4X2FVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix3x4fv, PFNGLPROGRAMUNIFORMMATRIX3X4FVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix4x3fv, PFNGLPROGRAMUNIFORMMATRIX4X3FVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix2x3dv, PFNGLPROGRAMUNIFORMMATRIX2X3DVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix3x2dv, PFNGLPROGRAMUNIFORMMATRIX3X2DVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix2x4dv, PFNGLPROGRAMUNIFORMMATRIX2X4DVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix4x2dv, PFNGLPROGRAMUNIFORMMATRIX4X2DVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix3x4dv, PFNGLPROGRAMUNIFORMMATRIX3X4DVPROC, "-p-#-d")
+GL_FUNCTION(glad_glProgramUniformMatrix4x3dv, PFNGLPROGRAMUNIFORMMATRIX4X3DVPROC, "-p-#-d")
+GL_FUNCTION(glad_glValidateProgramPipeline, PFNGLVALIDATEPROGRAMPIPELINEPROC, "-P")
+GL_FUNCTION(glad_glGetProgramPipelineInfoLog, PFNGLGETPROGRAMPIPELINEINFOLOGPROC, "-Pz**")
+GL_FUNCTION(glad_glVertexAttribL1d, PFNGLVERTEXATTRIBL1DPROC, "---")
+GL_FUNCTION(glad_glVertexAttribL2d, PFNGLVERTEXATTRIBL2DPROC, "----")
+GL_FUNCTION(glad_glVertexAttribL3d, PFNGLVERTEXATTRIBL3DPROC, "-----")
+GL_FUNCTION(glad_glVertexAttribL4d, PFNGLVERTEXATTRIBL4DPROC, "------")
+GL_FUNCTION(glad_glVertexAttribL1dv, PFNGLVERTEXATTRIBL1DVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribL2dv, PFNGLVERTEXATTRIBL2DVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribL3dv, PFNGLVERTEXATTRIBL3DVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribL4dv, PFNGLVERTEXATTRIBL4DVPROC, "--d")
+GL_FUNCTION(glad_glVertexAttribLPointer, PFNGLVERTEXATTRIBLPOINTERPROC, "---T-o")
+GL_FUNCTION(glad_glGetVertexAttribLdv, PFNGLGETVERTEXATTRIBLDVPROC, "---*")
+GL_FUNCTION(glad_glViewportArrayv, PFNGLVIEWPORTARRAYVPROC, "--#a")
+GL_FUNCTION(glad_glViewportIndexedf, PFNGLVIEWPORTINDEXEDFPROC, "------")
+GL_FUNCTION(glad_glViewportIndexedfv, PFNGLVIEWPORTINDEXEDFVPROC, "--d")
+GL_FUNCTION(glad_glScissorArrayv, PFNGLSCISSORARRAYVPROC, "--#a")
+GL_FUNCTION(glad_glScissorIndexed, PFNGLSCISSORINDEXEDPROC, "----WH")
+GL_FUNCTION(glad_glScissorIndexedv, PFNGLSCISSORINDEXEDVPROC, "--d")
+GL_FUNCTION(glad_glDepthRangeArrayv, PFNGLDEPTHRANGEARRAYVPROC, "--#a")
+GL_FUNCTION(glad_glDepthRangeIndexed, PFNGLDEPTHRANGEINDEXEDPROC, "----")
+GL_FUNCTION(glad_glGetFloati_v, PFNGLGETFLOATI_VPROC, "---*")
+GL_FUNCTION(glad_glGetDoublei_v, PFNGLGETDOUBLEI_VPROC, "---*")
+GL_FUNCTION(glad_glDrawArraysInstancedBaseInstance, PFNGLDRAWARRAYSINSTANCEDBASEINSTANCEPROC, "---#--")
+GL_FUNCTION(glad_glDrawElementsInstancedBaseInstance, PFNGLDRAWELEMENTSINSTANCEDBASEINSTANCEPROC, "--#To--")
+GL_FUNCTION(glad_glDrawElementsInstancedBaseVertexBaseInstance, PFNGLDRAWELEMENTSINSTANCEDBASEVERTEXBASEINSTANCEPROC, "--#To---")
+GL_FUNCTION(glad_glGetInternalformativ, PFNGLGETINTERNALFORMATIVPROC, "----z*")
+GL_FUNCTION(glad_glGetActiveAtomicCounterBufferiv, PFNGLGETACTIVEATOMICCOUNTERBUFFERIVPROC, "-p--*")
+GL_FUNCTION(glad_glBindImageTexture, PFNGLBINDIMAGETEXTUREPROC, "--t----F")
+GL_FUNCTION(glad_glMemoryBarrier, PFNGLMEMORYBARRIERPROC, "--")
+GL_FUNCTION(glad_glTexStorage1D, PFNGLTEXSTORAGE1DPROC, "----W")
+GL_FUNCTION(glad_glTexStorage2D, PFNGLTEXSTORAGE2DPROC, "----WH")
+GL_FUNCTION(glad_glTexStorage3D, PFNGLTEXSTORAGE3DPROC, "----WHD")
+GL_FUNCTION(glad_glDrawTransformFeedbackInstanced, PFNGLDRAWTRANSFORMFEEDBACKINSTANCEDPROC, "--x-")
+GL_FUNCTION(glad_glDrawTransformFeedbackStreamInstanced, PFNGLDRAWTRANSFORMFEEDBACKSTREAMINSTANCEDPROC, "--x--")
+GL_FUNCTION(glad_glClearBufferData, PFNGLCLEARBUFFERDATAPROC, "---FTd")
+GL_FUNCTION(glad_glClearBufferSubData, PFNGLCLEARBUFFERSUBDATAPROC, "----zFTd")
+GL_FUNCTION(glad_glDispatchCompute, PFNGLDISPATCHCOMPUTEPROC, "----")
+GL_FUNCTION(glad_glDispatchComputeIndirect, PFNGLDISPATCHCOMPUTEINDIRECTPROC, "--")
+GL_FUNCTION(glad_glCopyImageSubData, PFNGLCOPYIMAGESUBDATAPROC, "----------------")
+GL_FUNCTION(glad_glFramebufferParameteri, PFNGLFRAMEBUFFERPARAMETERIPROC, "----")
+GL_FUNCTION(glad_glGetFramebufferParameteriv, PFNGLGETFRAMEBUFFERPARAMETERIVPROC, "---*")
+GL_FUNCTION(glad_glGetInternalformati64v, PFNGLGETINTERNALFORMATI64VPROC, "----z*")
+GL_FUNCTION(glad_glInvalidateTexSubImage, PFNGLINVALIDATETEXSUBIMAGEPROC, "-t----WHD")
+GL_FUNCTION(glad_glInvalidateTexImage, PFNGLINVALIDATETEXIMAGEPROC, "-t-")
+GL_FUNCTION(glad_glInvalidateBufferSubData, PFNGLINVALIDATEBUFFERSUBDATAPROC, "-b--")
+GL_FUNCTION(glad_glInvalidateBufferData, PFNGLINVALIDATEBUFFERDATAPROC, "-b")
+GL_FUNCTION(glad_glInvalidateFramebuffer, PFNGLINVALIDATEFRAMEBUFFERPROC, "--#a")
+GL_FUNCTION(glad_glInvalidateSubFramebuffer, PFNGLINVALIDATESUBFRAMEBUFFERPROC, "--#a--WH")
+GL_FUNCTION(glad_glMultiDrawArraysIndirect, PFNGLMULTIDRAWARRAYSINDIRECTPROC, "--o--")
+GL_FUNCTION(glad_glMultiDrawElementsIndirect, PFNGLMULTIDRAWELEMENTSINDIRECTPROC, "--To--")
+GL_FUNCTION(glad_glGetProgramInterfaceiv, PFNGLGETPROGRAMINTERFACEIVPROC, "-p--*")
+GL_FUNCTION(glad_glGetProgramResourceIndex, PFNGLGETPROGRAMRESOURCEINDEXPROC, "-p-c")
+GL_FUNCTION(glad_glGetProgramResourceName, PFNGLGETPROGRAMRESOURCENAMEPROC, "-p--z**")
+GL_FUNCTION(glad_glGetProgramResourceiv, PFNGLGETPROGRAMRESOURCEIVPROC, "-p--#az**")
+GL_FUNCTION(glad_glGetProgramResourceLocation, PFNGLGETPROGRAMRESOURCELOCATIONPROC, "-p-c")
+GL_FUNCTION(glad_glGetProgramResourceLocationIndex, PFNGLGETPROGRAMRESOURCELOCATIONINDEXPROC, "-p-c")
+GL_FUNCTION(glad_glShaderStorageBlockBinding, PFNGLSHADERSTORAGEBLOCKBINDINGPROC, "-p--")
+GL_FUNCTION(glad_glTexBufferRange, PFNGLTEXBUFFERRANGEPROC, "---b-z")
+GL_FUNCTION(glad_glTexStorage2DMultisample, PFNGLTEXSTORAGE2DMULTISAMPLEPROC, "----WH-")
+GL_FUNCTION(glad_glTexStorage3DMultisample, PFNGLTEXSTORAGE3DMULTISAMPLEPROC, "----WHD-")
+GL_FUNCTION(glad_glTextureView, PFNGLTEXTUREVIEWPROC, "-t-t-----")
+GL_FUNCTION(glad_glBindVertexBuffer, PFNGLBINDVERTEXBUFFERPROC, "--b--")
+GL_FUNCTION(glad_glVertexAttribFormat, PFNGLVERTEXATTRIBFORMATPROC, "---T--")
+GL_FUNCTION(glad_glVertexAttribIFormat, PFNGLVERTEXATTRIBIFORMATPROC, "---T-")
+GL_FUNCTION(glad_glVertexAttribLFormat, PFNGLVERTEXATTRIBLFORMATPROC, "---T-")
+GL_FUNCTION(glad_glVertexAttribBinding, PFNGLVERTEXATTRIBBINDINGPROC, "---")
+GL_FUNCTION(glad_glVertexBindingDivisor, PFNGLVERTEXBINDINGDIVISORPROC, "---")
+GL_FUNCTION(glad_glDebugMessageControl, PFNGLDEBUGMESSAGECONTROLPROC, "--T-#a-")
+GL_FUNCTION(glad_glDebugMessageInsert, PFNGLDEBUGMESSAGEINSERTPROC, "--T--lc")
+GL_FUNCTION(glad_glDebugMessageCallback, PFNGLDEBUGMESSAGECALLBACKPROC, "-nd")
+GL_FUNCTION(glad_glGetDebugMessageLog, PFNGLGETDEBUGMESSAGELOGPROC, "--z******")
+GL_FUNCTION(glad_glPushDebugGroup, PFNGLPUSHDEBUGGROUPPROC, "---lc")
+GL_FUNCTION(glad_glPopDebugGroup, PFNGLPOPDEBUGGROUPPROC, "-")
+GL_FUNCTION(glad_glObjectLabel, PFNGLOBJECTLABELPROC, "---lc")
+GL_FUNCTION(glad_glGetObjectLabel, PFNGLGETOBJECTLABELPROC, "---z**")
+GL_FUNCTION(glad_glObjectPtrLabel, PFNGLOBJECTPTRLABELPROC, "-dlc")
+GL_FUNCTION(glad_glGetObjectPtrLabel, PFNGLGETOBJECTPTRLABELPROC, "-dz**")
+GL_FUNCTION(glad_glBufferStorage, PFNGLBUFFERSTORAGEPROC, "--zd-")
+GL_FUNCTION(glad_glClearTexImage, PFNGLCLEARTEXIMAGEPROC, "-t-FTd")
+GL_FUNCTION(glad_glClearTexSubImage, PFNGLCLEARTEXSUBIMAGEPROC, "-t----WHDFTd")
+GL_FUNCTION(glad_glBindBuffersBase, PFNGLBINDBUFFERSBASEPROC, "---#b")
+GL_FUNCTION(glad_glBindBuffersRange, PFNGLBINDBUFFERSRANGEPROC, "---#baa")
+GL_FUNCTION(glad_glBindTextures, PFNGLBINDTEXTURESPROC, "--#t")
+GL_FUNCTION(glad_glBindSamplers, PFNGLBINDSAMPLERSPROC, "--#s")
+GL_FUNCTION(glad_glBindImageTextures, PFNGLBINDIMAGETEXTURESPROC, "--#t")
+GL_FUNCTION(glad_glBindVertexBuffers, PFNGLBINDVERTEXBUFFERSPROC, "--#baa")
+GL_FUNCTION(glad_glClipControl, PFNGLCLIPCONTROLPROC, "---")
+GL_FUNCTION(glad_glCreateTransformFeedbacks, PFNGLCREATETRANSFORMFEEDBACKSPROC, "-#x")
+GL_FUNCTION(glad_glTransformFeedbackBufferBase, PFNGLTRANSFORMFEEDBACKBUFFERBASEPROC, "-x-b")
+GL_FUNCTION(glad_glTransformFeedbackBufferRange, PFNGLTRANSFORMFEEDBACKBUFFERRANGEPROC, "-x-b-z")
+GL_FUNCTION(glad_glGetTransformFeedbackiv, PFNGLGETTRANSFORMFEEDBACKIVPROC, "-x-*")
+GL_FUNCTION(glad_glGetTransformFeedbacki_v, PFNGLGETTRANSFORMFEEDBACKI_VPROC, "-x--*")
+GL_FUNCTION(glad_glGetTransformFeedbacki64_v, PFNGLGETTRANSFORMFEEDBACKI64_VPROC, "-x--*")
+GL_FUNCTION(glad_glCreateBuffers, PFNGLCREATEBUFFERSPROC, "-#b")
+GL_FUNCTION(glad_glNamedBufferStorage, PFNGLNAMEDBUFFERSTORAGEPROC, "-bzd-")
+GL_FUNCTION(glad_glNamedBufferData, PFNGLNAMEDBUFFERDATAPROC, "-bzd-")
+GL_FUNCTION(glad_glNamedBufferSubData, PFNGLNAMEDBUFFERSUBDATAPROC, "-b-zd")
+GL_FUNCTION(glad_glCopyNamedBufferSubData, PFNGLCOPYNAMEDBUFFERSUBDATAPROC, "-bb--z")
+GL_FUNCTION(glad_glClearNamedBufferData, PFNGLCLEARNAMEDBUFFERDATAPROC, "-b-FTd")
+GL_FUNCTION(glad_glClearNamedBufferSubData, PFNGLCLEARNAMEDBUFFERSUBDATAPROC, "-b--zFTd")
+GL_FUNCTION(glad_glMapNamedBuffer, PFNGLMAPNAMEDBUFFERPROC, "mb-")
+GL_FUNCTION(glad_glMapNamedBufferRange, PFNGLMAPNAMEDBUFFERRANGEPROC, "mb---")
+GL_FUNCTION(glad_glUnmapNamedBuffer, PFNGLUNMAPNAMEDBUFFERPROC, "-b")
+GL_FUNCTION(glad_glFlushMappedNamedBufferRange, PFNGLFLUSHMAPPEDNAMEDBUFFERRANGEPROC, "-b--")
+GL_FUNCTION(glad_glGetNamedBufferParameteriv, PFNGLGETNAMEDBUFFERPARAMETERIVPROC, "-b-*")
+GL_FUNCTION(glad_glGetNamedBufferParameteri64v, PFNGLGETNAMEDBUFFERPARAMETERI64VPROC, "-b-*")
+GL_FUNCTION(glad_glGetNamedBufferPointerv, PFNGLGETNAMEDBUFFERPOINTERVPROC, "-b-*")
+GL_FUNCTION(glad_glGetNamedBufferSubData, PFNGLGETNAMEDBUFFERSUBDATAPROC, "-b-z*")
+GL_FUNCTION(glad_glCreateFramebuffers, PFNGLCREATEFRAMEBUFFERSPROC, "-#f")
+GL_FUNCTION(glad_glNamedFramebufferRenderbuffer, PFNGLNAMEDFRAMEBUFFERRENDERBUFFERPROC, "-f--r")
+GL_FUNCTION(glad_glNamedFramebufferParameteri, PFNGLNAMEDFRAMEBUFFERPARAMETERIPROC, "-f--")
+GL_FUNCTION(glad_glNamedFramebufferTexture, PFNGLNAMEDFRAMEBUFFERTEXTUREPROC, "-f-t-")
+GL_FUNCTION(glad_glNamedFramebufferTextureLayer, PFNGLNAMEDFRAMEBUFFERTEXTURELAYERPROC, "-f-t--")
+GL_FUNCTION(glad_glNamedFramebufferDrawBuffer, PFNGLNAMEDFRAMEBUFFERDRAWBUFFERPROC, "-f-")
+GL_FUNCTION(glad_glNamedFramebufferDrawBuffers, PFNGLNAMEDFRAMEBUFFERDRAWBUFFERSPROC, "-f#a")
+GL_FUNCTION(glad_glNamedFramebufferReadBuffer, PFNGLNAMEDFRAMEBUFFERREADBUFFERPROC, "-f-")
+GL_FUNCTION(glad_glInvalidateNamedFramebufferData, PFNGLINVALIDATENAMEDFRAMEBUFFERDATAPROC, "-f#a")
+GL_FUNCTION(glad_glInvalidateNamedFramebufferSubData, PFNGLINVALIDATENAMEDFRAMEBUFFERSUBDATAPROC, "-f#a--WH")
+GL_FUNCTION(glad_glClearNamedFramebufferiv, PFNGLCLEARNAMEDFRAMEBUFFERIVPROC, "-f--d")
+GL_FUNCTION(glad_glClearNamedFramebufferuiv, PFNGLCLEARNAMEDFRAMEBUFFERUIVPROC, "-f--d")
+GL_FUNCTION(glad_glClearNamedFramebufferfv, PFNGLCLEARNAMEDFRAMEBUFFERFVPROC, "-f--d")
+GL_FUNCTION(glad_glClearNamedFramebufferfi, PFNGLCLEARNAMEDFRAMEBUFFERFIPROC, "-f----")
+GL_FUNCTION(glad_glBlitNamedFramebuffer, PFNGLBLITNAMEDFRAMEBUFFERPROC, "-ff----------")
+GL_FUNCTION(glad_glCheckNamedFramebufferStatus, PFNGLCHECKNAMEDFRAMEBUFFERSTATUSPROC, "-f-")
+GL_FUNCTION(glad_glGetNamedFramebufferParameteriv, PFNGLGETNAMEDFRAMEBUFFERPARAMETERIVPROC, "-f-*")
+GL_FUNCTION(glad_glGetNamedFramebufferAttachmentParameteriv, PFNGLGETNAMEDFRAMEBUFFERATTACHMENTPARAMETERIVPROC, "-f--*")
+GL_FUNCTION(glad_glCreateRenderbuffers, PFNGLCREATERENDERBUFFERSPROC, "-#r")
+GL_FUNCTION(glad_glNamedRenderbufferStorage, PFNGLNAMEDRENDERBUFFERSTORAGEPROC, "-r-WH")
+GL_FUNCTION(glad_glNamedRenderbufferStorageMultisample, PFNGLNAMEDRENDERBUFFERSTORAGEMULTISAMPLEPROC, "-r--WH")
+GL_FUNCTION(glad_glGetNamedRenderbufferParameteriv, PFNGLGETNAMEDRENDERBUFFERPARAMETERIVPROC, "-r-*")
+GL_FUNCTION(glad_glCreateTextures, PFNGLCREATETEXTURESPROC, "--#t")
+GL_FUNCTION(glad_glTextureBuffer, PFNGLTEXTUREBUFFERPROC, "-t-b")
+GL_FUNCTION(glad_glTextureBufferRange, PFNGLTEXTUREBUFFERRANGEPROC, "-t-b-z")
+GL_FUNCTION(glad_glTextureStorage1D, PFNGLTEXTURESTORAGE1DPROC, "-t--W")
+GL_FUNCTION(glad_glTextureStorage2D, PFNGLTEXTURESTORAGE2DPROC, "-t--WH")
+GL_FUNCTION(glad_glTextureStorage3D, PFNGLTEXTURESTORAGE3DPROC, "-t--WHD")
+GL_FUNCTION(glad_glTextureStorage2DMultisample, PFNGLTEXTURESTORAGE2DMULTISAMPLEPROC, "-t--WH-")
+GL_FUNCTION(glad_glTextureStorage3DMultisample, PFNGLTEXTURESTORAGE3DMULTISAMPLEPROC, "-t--WHD-")
+GL_FUNCTION(glad_glTextureSubImage1D, PFNGLTEXTURESUBIMAGE1DPROC, "-t--WFTd")
+GL_FUNCTION(glad_glTextureSubImage2D, PFNGLTEXTURESUBIMAGE2DPROC, "-t---WHFTd")
+GL_FUNCTION(glad_glTextureSubImage3D, PFNGLTEXTURESUBIMAGE3DPROC, "-t----WHDFTd")
+GL_FUNCTION(glad_glCompressedTextureSubImage1D, PFNGLCOMPRESSEDTEXTURESUBIMAGE1DPROC, "-t--WFzd")
+GL_FUNCTION(glad_glCompressedTextureSubImage2D, PFNGLCOMPRESSEDTEXTURESUBIMAGE2DPROC, "-t---WHFzd")
+GL_FUNCTION(glad_glCompressedTextureSubImage3D, PFNGLCOMPRESSEDTEXTURESUBIMAGE3DPROC, "-t----WHDFzd")
+GL_FUNCTION(glad_glCopyTextureSubImage1D, PFNGLCOPYTEXTURESUBIMAGE1DPROC, "-t----W")
+GL_FUNCTION(glad_glCopyTextureSubImage2D, PFNGLCOPYTEXTURESUBIMAGE2DPROC, "-t-----WH")
+GL_FUNCTION(glad_glCopyTextureSubImage3D, PFNGLCOPYTEXTURESUBIMAGE3DPROC, "-t------WH")
+GL_FUNCTION(glad_glTextureParameterf, PFNGLTEXTUREPARAMETERFPROC, "-t--")
+GL_FUNCTION(glad_glTextureParameterfv, PFNGLTEXTUREPARAMETERFVPROC, "-t-d")
+GL_FUNCTION(glad_glTextureParameteri, PFNGLTEXTUREPARAMETERIPROC, "-t--")
+GL_FUNCTION(glad_glTextureParameterIiv, PFNGLTEXTUREPARAMETERIIVPROC, "-t-d")
+GL_FUNCTION(glad_glTextureParameterIuiv, PFNGLTEXTUREPARAMETERIUIVPROC, "-t-d")
+GL_FUNCTION(glad_glTextureParameteriv, PFNGLTEXTUREPARAMETERIVPROC, "-t-d")
+GL_FUNCTION(glad_glGenerateTextureMipmap, PFNGLGENERATETEXTUREMIPMAPPROC, "-t")
+GL_FUNCTION(glad_glBindTextureUnit, PFNGLBINDTEXTUREUNITPROC, "--t")
+GL_FUNCTION(glad_glGetTextureImage, PFNGLGETTEXTUREIMAGEPROC, "-t-FTz*")
+GL_FUNCTION(glad_glGetCompressedTextureImage, PFNGLGETCOMPRESSEDTEXTUREIMAGEPROC, "-t-z*")
+GL_FUNCTION(glad_glGetTextureLevelParameterfv, PFNGLGETTEXTURELEVELPARAMETERFVPROC, "-t--*")
+GL_FUNCTION(glad_glGetTextureLevelParameteriv, PFNGLGETTEXTURELEVELPARAMETERIVPROC, "-t--*")
+GL_FUNCTION(glad_glGetTextureParameterfv, PFNGLGETTEXTUREPARAMETERFVPROC, "-t-*")
+GL_FUNCTION(glad_glGetTextureParameterIiv, PFNGLGETTEXTUREPARAMETERIIVPROC, "-t-*")
+GL_FUNCTION(glad_glGetTextureParameterIuiv, PFNGLGETTEXTUREPARAMETERIUIVPROC, "-t-*")
+GL_FUNCTION(glad_glGetTextureParameteriv, PFNGLGETTEXTUREPARAMETERIVPROC, "-t-*")
+GL_FUNCTION(glad_glCreateVertexArrays, PFNGLCREATEVERTEXARRAYSPROC, "-#v")
+GL_FUNCTION(glad_glDisableVertexArrayAttrib, PFNGLDISABLEVERTEXARRAYATTRIBPROC, "-v-")
+GL_FUNCTION(glad_glEnableVertexArrayAttrib, PFNGLENABLEVERTEXARRAYATTRIBPROC, "-v-")
+GL_FUNCTION(glad_glVertexArrayElementBuffer, PFNGLVERTEXARRAYELEMENTBUFFERPROC, "-vb")
+GL_FUNCTION(glad_glVertexArrayVertexBuffer, PFNGLVERTEXARRAYVERTEXBUFFERPROC, "-v-b--")
+GL_FUNCTION(glad_glVertexArrayVertexBuffers, PFNGLVERTEXARRAYVERTEXBUFFERSPROC, "-v-#baa")
+GL_FUNCTION(glad_glVertexArrayAttribBinding, PFNGLVERTEXARRAYATTRIBBINDINGPROC, "-v--")
+GL_FUNCTION(glad_glVertexArrayAttribFormat, PFNGLVERTEXARRAYATTRIBFORMATPROC, "-v--T--")
+GL_FUNCTION(glad_glVertexArrayAttribIFormat, PFNGLVERTEXARRAYATTRIBIFORMATPROC, "-v--T-")
+GL_FUNCTION(glad_glVertexArrayAttribLFormat, PFNGLVERTEXARRAYATTRIBLFORMATPROC, "-v--T-")
+GL_FUNCTION(glad_glVertexArrayBindingDivisor, PFNGLVERTEXARRAYBINDINGDIVISORPROC, "-v--")
+GL_FUNCTION(glad_glGetVertexArrayiv, PFNGLGETVERTEXARRAYIVPROC, "-v-*")
+GL_FUNCTION(glad_glGetVertexArrayIndexediv, PFNGLGETVERTEXARRAYINDEXEDIVPROC, "-v--*")
+GL_FUNCTION(glad_glGetVertexArrayIndexed64iv, PFNGLGETVERTEXARRAYINDEXED64IVPROC, "-v--*")
+GL_FUNCTION(glad_glCreateSamplers, PFNGLCREATESAMPLERSPROC, "-#s")
+GL_FUNCTION(glad_glCreateProgramPipelines, PFNGLCREATEPROGRAMPIPELINESPROC, "-#P")
+GL_FUNCTION(glad_glCreateQueries, PFNGLCREATEQUERIESPROC, "--#q")
+GL_FUNCTION(glad_glGetQueryBufferObjecti64v, PFNGLGETQUERYBUFFEROBJECTI64VPROC, "-qb--")
+GL_FUNCTION(glad_glGetQueryBufferObjectiv, PFNGLGETQUERYBUFFEROBJECTIVPROC, "-qb--")
+GL_FUNCTION(glad_glGetQueryBufferObjectui64v, PFNGLGETQUERYBUFFEROBJECTUI64VPROC, "-qb--")
+GL_FUNCTION(glad_glGetQueryBufferObjectuiv, PFNGLGETQUERYBUFFEROBJECTUIVPROC, "-qb--")
+GL_FUNCTION(glad_glMemoryBarrierByRegion, PFNGLMEMORYBARRIERBYREGIONPROC, "--")
+GL_FUNCTION(glad_glGetTextureSubImage, PFNGLGETTEXTURESUBIMAGEPROC, "-t----WHDFTz*")
+GL_FUNCTION(glad_glGetCompressedTextureSubImage, PFNGLGETCOMPRESSEDTEXTURESUBIMAGEPROC, "-t----WHDz*")
+GL_FUNCTION(glad_glGetGraphicsResetStatus, PFNGLGETGRAPHICSRESETSTATUSPROC, "-")
+GL_FUNCTION(glad_glGetnCompressedTexImage, PFNGLGETNCOMPRESSEDTEXIMAGEPROC, "---z*")
+GL_FUNCTION(glad_glGetnTexImage, PFNGLGETNTEXIMAGEPROC, "---FTz*")
+GL_FUNCTION(glad_glGetnUniformdv, PFNGLGETNUNIFORMDVPROC, "-p-z*")
+GL_FUNCTION(glad_glGetnUniformfv, PFNGLGETNUNIFORMFVPROC, "-p-z*")
+GL_FUNCTION(glad_glGetnUniformiv, PFNGLGETNUNIFORMIVPROC, "-p-z*")
+GL_FUNCTION(glad_glGetnUniformuiv, PFNGLGETNUNIFORMUIVPROC, "-p-z*")
+GL_FUNCTION(glad_glReadnPixels, PFNGLREADNPIXELSPROC, "---WHFTz*")
+GL_FUNCTION(glad_glTextureBarrier, PFNGLTEXTUREBARRIERPROC, "-")
+GL_FUNCTION(glad_glGetTextureHandleARB, PFNGLGETTEXTUREHANDLEARBPROC, "-t")
+GL_FUNCTION(glad_glGetTextureSamplerHandleARB, PFNGLGETTEXTURESAMPLERHANDLEARBPROC, "-ts")
+GL_FUNCTION(glad_glMakeTextureHandleResidentARB, PFNGLMAKETEXTUREHANDLERESIDENTARBPROC, "--")
+GL_FUNCTION(glad_glMakeTextureHandleNonResidentARB, PFNGLMAKETEXTUREHANDLENONRESIDENTARBPROC, "--")
+GL_FUNCTION(glad_glGetImageHandleARB, PFNGLGETIMAGEHANDLEARBPROC, "-t---F")
+GL_FUNCTION(glad_glMakeImageHandleResidentARB, PFNGLMAKEIMAGEHANDLERESIDENTARBPROC, "---")
+GL_FUNCTION(glad_glMakeImageHandleNonResidentARB, PFNGLMAKEIMAGEHANDLENONRESIDENTARBPROC, "--")
+GL_FUNCTION(glad_glUniformHandleui64ARB, PFNGLUNIFORMHANDLEUI64ARBPROC, "---")
+GL_FUNCTION(glad_glUniformHandleui64vARB, PFNGLUNIFORMHANDLEUI64VARBPROC, "--#d")
+GL_FUNCTION(glad_glProgramUniformHandleui64ARB, PFNGLPROGRAMUNIFORMHANDLEUI64ARBPROC, "-p--")
+GL_FUNCTION(glad_glProgramUniformHandleui64vARB, PFNGLPROGRAMUNIFORMHANDLEUI64VARBPROC, "-p-#d")
+GL_FUNCTION(glad_glIsTextureHandleResidentARB, PFNGLISTEXTUREHANDLERESIDENTARBPROC, "--")
+GL_FUNCTION(glad_glIsImageHandleResidentARB, PFNGLISIMAGEHANDLERESIDENTARBPROC, "--")
+GL_FUNCTION(glad_glVertexAttribL1ui64ARB, PFNGLVERTEXATTRIBL1UI64ARBPROC, "---")
+GL_FUNCTION(glad_glVertexAttribL1ui64vARB, PFNGLVERTEXATTRIBL1UI64VARBPROC, "--d")
+GL_FUNCTION(glad_glGetVertexAttribLui64vARB, PFNGLGETVERTEXATTRIBLUI64VARBPROC, "---*")
+GL_FUNCTION(glad_glLabelObjectEXT, PFNGLLABELOBJECTEXTPROC, "-T-lc")
+GL_FUNCTION(glad_glGetObjectLabelEXT, PFNGLGETOBJECTLABELEXTPROC, "-T-z**")
+GL_FUNCTION(glad_glInsertEventMarkerEXT, PFNGLINSERTEVENTMARKEREXTPROC, "-lc")
+GL_FUNCTION(glad_glPushGroupMarkerEXT, PFNGLPUSHGROUPMARKEREXTPROC, "-lc")
+GL_FUNCTION(glad_glPopGroupMarkerEXT, PFNGLPOPGROUPMARKEREXTPROC, "-")
+GL_FUNCTION(glad_glMaxShaderCompilerThreadsARB, PFNGLMAXSHADERCOMPILERTHREADSARBPROC, "--")
+GL_FUNCTION(glad_glMaxShaderCompilerThreadsKHR, PFNGLMAXSHADERCOMPILERTHREADSKHRPROC, "--")
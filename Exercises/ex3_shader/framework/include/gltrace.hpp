@@ -0,0 +1,88 @@
+#pragma once
+
+#include "glfunctions.hpp"
+#include <memory>
+#include <vector>
+
+namespace gpupro {
+
+	// Captures the complete GL command stream into a compact binary trace
+	// which can be replayed on any context (see GLTraceReplayer and the
+	// glreplay tool). This allows to compare driver costs and framework
+	// changes on identical command streams.
+	//
+	// The capture wraps the glad function pointers. Besides the arguments it
+	// stores the data behind pointers (buffer and texture uploads, shader
+	// sources, uniform arrays, ...), the object names returned by the driver
+	// and the data written to mapped buffers.
+	//
+	// Start the capture directly after the creation of the OGLContext, such
+	// that the trace contains the creation of all resources (frame 0).
+	// OGLContext::endFrame() marks the end of each frame.
+	//
+	// Not supported: bindless handles, uniform locations from queries and
+	// client arrays whose size cannot be derived from the arguments (they
+	// are replayed with zeroed memory). Writes to persistently mapped
+	// buffers are stored on flush and at the end of each frame.
+	class GLTrace
+	{
+	public:
+		// _numFrames: end the capture automatically after this number of
+		// frames. 0 captures until endCapture().
+		static bool beginCapture(const char* _fileName, GLuint _numFrames = 0);
+		static void endCapture();
+		static bool isCapturing();
+
+		// Called by OGLContext::endFrame().
+		static void markFrame();
+	};
+
+	template<GLFunction F, typename Fn, Fn* Pointer> struct ReplayCall;
+
+	// Replays a trace through the current glad function pointers (load a
+	// context first). Object names, sync objects and mapped pointers are
+	// translated to the ones of the replaying context.
+	class GLTraceReplayer
+	{
+	public:
+		struct CallStats
+		{
+			GLFunction function;
+			GLuint64 numCalls;
+			double totalTime;	///< CPU time in ms
+			double maxTime;		///< Slowest single call in ms
+		};
+
+		explicit GLTraceReplayer(const char* _fileName);
+		~GLTraceReplayer();
+		GLTraceReplayer(const GLTraceReplayer&) = delete;
+		GLTraceReplayer& operator = (const GLTraceReplayer&) = delete;
+
+		bool isValid() const;
+		// Including frame 0 which contains everything before the first
+		// OGLContext::endFrame() (usually the loading).
+		GLuint numFrames() const;
+		// Size of the default framebuffer during the capture.
+		GLsizei width() const;
+		GLsizei height() const;
+
+		// Execute all calls of a frame and return the CPU time in ms.
+		// Replay all frames in order first. Afterwards frames > 0 can be
+		// repeated for benchmarking (objects which are created and not
+		// deleted in the frame are created again each time).
+		// Returns a negative value if the trace is corrupt.
+		double replayFrame(GLuint _frame);
+
+		// Measure the time of each call. This adds two clock queries per call.
+		void setCallTiming(bool _enable);
+		// Statistics of all called functions sorted by total time (call
+		// counts are always collected).
+		std::vector<CallStats> callStats() const;
+		void resetStats();
+	private:
+		template<GLFunction F, typename Fn, Fn* Pointer> friend struct ReplayCall;
+		struct State;
+		std::unique_ptr<State> m_state;
+	};
+
+} // namespace gpupro
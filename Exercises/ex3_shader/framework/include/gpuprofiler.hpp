@@ -0,0 +1,81 @@
+#pragma once
+
+#include "gl.hpp"
+#include "timeline.hpp"
+#include <string>
+#include <vector>
+
+namespace gpupro {
+
+	// Measures the GPU time of nested scopes with timestamp queries. Unlike
+	// a Query it never waits for the GPU: the queries of each frame are read
+	// back when the GPU has finished them, which is usually one or two
+	// frames later. A frame whose results are still not available after
+	// LATENCY frames is dropped and its queries are reused.
+	//
+	// Scopes are identified by their name and their parent scope, so the
+	// same pass in two different places gives two entries. All scopes of a
+	// frame are children of the implicit scope "Frame" which lasts from the
+	// first scope to OGLContext::endFrame(). A scope which is entered more
+	// than once per frame reports the sum of all its intervals.
+	//
+	// Every scope is also a debug group (glPushDebugGroup), such that
+	// debuggers like RenderDoc show the same hierarchy. This happens even
+	// if the time measurement is disabled. The measured scopes also appear
+	// on the Timeline if it is enabled.
+	class GpuProfiler
+	{
+	public:
+		// Number of frames in flight before a result must be available.
+		static const GLuint LATENCY = 4;
+
+		struct ScopeStatistics
+		{
+			std::string name;
+			int depth;				///< 0 for the frame, 1 for top level scopes, ...
+			size_t numSamples;		///< Frames in the window (may be less than the window size)
+			double latest;			///< All times in ms
+			double p50, p95, p99;
+		};
+
+		// The measurement is off initially. Disabling releases all queries
+		// and discards the frames in flight, the statistics remain.
+		static void setEnabled(bool _enable);
+		static bool isEnabled();
+
+		// Number of frames for the percentiles (default 240).
+		static void setWindowSize(size_t _numFrames);
+
+		// Use GPU_SCOPE instead of calling these directly.
+		static void beginScope(const char* _name);
+		static void endScope();
+
+		// Close the current frame and collect all finished frames. This is
+		// called by OGLContext::endFrame().
+		static void endFrame();
+
+		// All scopes with samples in depth first order (children follow
+		// their parent).
+		static std::vector<ScopeStatistics> statistics();
+		// Writes statistics() as an indented table to std::cerr.
+		static void printStatistics();
+
+		// Frames whose results were not available in time.
+		static GLuint numDroppedFrames();
+	};
+
+	// Measures the lifetime of the object as a scope of the GpuProfiler.
+	class GpuScope
+	{
+	public:
+		explicit GpuScope(const char* _name) { GpuProfiler::beginScope(_name); }
+		~GpuScope() { GpuProfiler::endScope(); }
+		GpuScope(const GpuScope&) = delete;
+		GpuScope& operator = (const GpuScope&) = delete;
+	};
+
+	// Measure the GPU time from here to the end of the enclosing block:
+	//	{ GPU_SCOPE("Shadows"); ... }
+	#define GPU_SCOPE(_name) gpupro::GpuScope GPUPRO_CONCAT(gpuScope, __LINE__)(_name)
+
+} // namespace gpupro
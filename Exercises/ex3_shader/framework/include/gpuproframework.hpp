@@ -4,12 +4,29 @@
 #include "gl.hpp"
 
 #include "context.hpp"
+#include "bindingtable.hpp"
+#include "blocklayout.hpp"
+#include "commandbuffer.hpp"
+#include "rendergraph.hpp"
+#include "drawqueue.hpp"
 #include "buffer.hpp"
 #include "objloader.hpp"
 #include "pipeline.hpp"
 #include "program.hpp"
+#include "programcache.hpp"
+#include "shaderpreprocessor.hpp"
 #include "shader.hpp"
 #include "texture.hpp"
 #include "vertexformat.hpp"
+#include "vertexlayout.hpp"
 #include "model.hpp"
-#include "query.hpp"
\ No newline at end of file
+#include "query.hpp"
+#include "occlusionculler.hpp"
+#include "gpuprofiler.hpp"
+#include "pipelinestatistics.hpp"
+#include "timeline.hpp"
+#include "gpuvector.hpp"
+#include "fence.hpp"
+#include "deletionqueue.hpp"
+#include "nullgl.hpp"
+#include "gltrace.hpp"
\ No newline at end of file
@@ -0,0 +1,208 @@
+#pragma once
+
+#include "blocklayout.hpp"
+#include "buffer.hpp"
+#include "deletionqueue.hpp"
+#include "format.hpp"
+#include <glm/glm.hpp>
+#include <type_traits>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+
+namespace gpupro {
+
+	namespace details {
+		// True if BlockTypeTraits knows the layout of T (scalars, vectors and
+		// matrices).
+		template<typename T>
+		struct HasBlockTypeTraits
+		{
+			template<typename U> static char test(decltype(BlockTypeTraits<U, BlockStandard::STD430>::SIZE)*);
+			template<typename U> static long test(...);
+			static const bool value = sizeof(test<T>(nullptr)) == 1;
+		};
+	}
+
+	// Array stride of T inside a std430 buffer. Scalars, vectors and
+	// matrices take it from BlockTypeTraits, e.g. a vec3 is padded to 16
+	// bytes and cannot be stored tightly in a C++ array.
+	// Structs have no default: their stride depends on the alignment of the
+	// members and not on sizeof, e.g. struct {vec3 a; float b; vec3 c;} has
+	// 28 bytes in C++ but a stride of 32 in GLSL. Specialize this for own
+	// element types, best with the BlockLayout which mirrors the struct:
+	//	typedef BlockLayout<BlockStandard::STD430, glm::vec3, float, glm::vec3> ParticleLayout;
+	//	template<> struct Std430Stride<Particle> { static const size_t value = ParticleLayout::SIZE; };
+	template<typename T, bool KnownLayout = details::HasBlockTypeTraits<T>::value>
+	struct Std430Stride
+	{
+		static_assert(KnownLayout, "The std430 stride of this element type is unknown. Specialize Std430Stride<T>.");
+		static const size_t value = 0;
+	};
+	template<typename T>
+	struct Std430Stride<T, true> { static const size_t value = BlockTypeTraits<T[1], BlockStandard::STD430>::STRIDE; };
+
+	// A growable typed array in GPU memory.
+	// The capacity grows geometrically. Growing allocates a new buffer and
+	// copies the old content on GPU side, so appending is amortized O(1)
+	// and the data never travels back to the CPU.
+	//
+	// Since the underlying buffer may change on growth, bindings are not
+	// persistent: bind the vector again after appending.
+	template<typename T>
+	class GpuVector
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "GpuVector elements are copied as raw memory.");
+		static_assert(sizeof(T) % 4 == 0, "GLSL types have a size of a multiple of 4 bytes.");
+		static_assert(Std430Stride<T>::value == sizeof(T), "The array stride of T in std430 differs from sizeof(T). Add padding (e.g. use vec4 instead of vec3).");
+	public:
+		// _type: main purpose of the buffer (see Buffer::Type).
+		// _initialCapacity: number of elements to reserve memory for.
+		explicit GpuVector(Buffer::Type _type = Buffer::Type::SHADER_STORAGE, GLuint _initialCapacity = 64) :
+			m_type(_type),
+			m_buffer(_type, sizeof(T), std::max(_initialCapacity, 1u), Buffer::Usage::SUB_DATA_UPDATE),
+			m_size(0),
+			m_capacity(std::max(_initialCapacity, 1u)),
+			m_textureView(0),
+			m_textureViewBuffer(0),
+			m_textureViewFormat(InternalFormat::R32F)
+		{}
+
+		~GpuVector()
+		{
+			DeletionQueue::release(DeletionQueue::ObjectType::TEXTURE, m_textureView);
+		}
+
+		// Move but not copy-able
+		GpuVector(GpuVector&& _rhs) :
+			m_type(_rhs.m_type),
+			m_buffer(std::move(_rhs.m_buffer)),
+			m_size(_rhs.m_size),
+			m_capacity(_rhs.m_capacity),
+			m_textureView(_rhs.m_textureView),
+			m_textureViewBuffer(_rhs.m_textureViewBuffer),
+			m_textureViewFormat(_rhs.m_textureViewFormat)
+		{
+			_rhs.m_textureView = 0;
+		}
+		GpuVector(const GpuVector&) = delete;
+		GpuVector& operator = (GpuVector&& _rhs)
+		{
+			DeletionQueue::release(DeletionQueue::ObjectType::TEXTURE, m_textureView);
+			m_type = _rhs.m_type;
+			m_buffer = std::move(_rhs.m_buffer);
+			m_size = _rhs.m_size;
+			m_capacity = _rhs.m_capacity;
+			m_textureView = _rhs.m_textureView;
+			m_textureViewBuffer = _rhs.m_textureViewBuffer;
+			m_textureViewFormat = _rhs.m_textureViewFormat;
+			_rhs.m_textureView = 0;
+			return *this;
+		}
+		GpuVector& operator = (const GpuVector&) = delete;
+
+		void push_back(const T& _value)
+		{
+			append(&_value, 1);
+		}
+
+		// Append _count elements in a single upload.
+		void append(const T* _data, GLuint _count)
+		{
+			if(_count == 0) return;
+			reserve(m_size + _count);
+			m_buffer.subDataUpdate(static_cast<GLintptr>(m_size) * sizeof(T), static_cast<GLsizei>(_count * sizeof(T)), _data);
+			m_size += _count;
+		}
+		void append(const std::vector<T>& _data)
+		{
+			append(_data.data(), static_cast<GLuint>(_data.size()));
+		}
+
+		// Overwrite an existing element.
+		void set(GLuint _index, const T& _value)
+		{
+			if(_index >= m_size) {
+				std::cerr << "ERR: GpuVector::set of element " << _index << " out of range (" << m_size << " elements).\n";
+				return;
+			}
+			m_buffer.subDataUpdate(static_cast<GLintptr>(_index) * sizeof(T), sizeof(T), &_value);
+		}
+
+		// Make sure there is space for at least _capacity elements.
+		// This is the only operation which reallocates.
+		void reserve(GLuint _capacity)
+		{
+			if(_capacity <= m_capacity) return;
+			GLuint newCapacity = std::max(_capacity, m_capacity * 2);
+			Buffer newBuffer(m_type, sizeof(T), newCapacity, Buffer::Usage::SUB_DATA_UPDATE);
+			if(m_size > 0)
+				newBuffer.copyFrom(m_buffer, 0, 0, static_cast<GLsizeiptr>(m_size) * sizeof(T));
+			m_buffer = std::move(newBuffer);
+			m_capacity = newCapacity;
+			// The texture view still references the old memory.
+			m_textureViewBuffer = 0;
+		}
+
+		// Drop all elements. The memory is kept.
+		void clear() { m_size = 0; }
+
+		GLuint size() const { return m_size; }
+		GLuint capacity() const { return m_capacity; }
+		bool empty() const { return m_size == 0; }
+
+		// Bind as vertex buffer (stride = sizeof(T)).
+		void bindAsVertexBuffer(GLuint _bindingIndex, GLuint _offset = 0)
+		{
+			m_buffer.bindAsVertexBuffer(_bindingIndex, _offset);
+		}
+
+		// Bind the used part [0, size) as shader storage buffer.
+		void bindAsShaderStorageBuffer(GLuint _bindingIndex)
+		{
+			m_buffer.bindAsShaderStorageBuffer(_bindingIndex, 0, static_cast<GLsizeiptr>(std::max(m_size, 1u)) * sizeof(T));
+		}
+
+		// Bind as samplerBuffer. The vector owns a texture object which
+		// interprets the memory with the given _format.
+		void bindAsTextureBuffer(GLuint _bindingIndex, InternalFormat _format)
+		{
+			if(hasDSA())
+			{
+				if(!m_textureView)
+					glCreateTextures(GL_TEXTURE_BUFFER, 1, &m_textureView);
+				// Attach the buffer again if it changed due to growth.
+				if(m_textureViewBuffer != m_buffer.glID() || m_textureViewFormat != _format)
+				{
+					glTextureBuffer(m_textureView, static_cast<GLenum>(_format), m_buffer.glID());
+					m_textureViewBuffer = m_buffer.glID();
+					m_textureViewFormat = _format;
+				}
+				glBindTextureUnit(_bindingIndex, m_textureView);
+			} else {
+				if(!m_textureView)
+					glGenTextures(1, &m_textureView);
+				glActiveTexture(GL_TEXTURE0 + _bindingIndex);
+				glBindTexture(GL_TEXTURE_BUFFER, m_textureView);
+				if(m_textureViewBuffer != m_buffer.glID() || m_textureViewFormat != _format)
+				{
+					glTexBuffer(GL_TEXTURE_BUFFER, static_cast<GLenum>(_format), m_buffer.glID());
+					m_textureViewBuffer = m_buffer.glID();
+					m_textureViewFormat = _format;
+				}
+			}
+		}
+
+		// Access the underlying buffer. It is replaced on growth!
+		Buffer& buffer() { return m_buffer; }
+	private:
+		Buffer::Type m_type;
+		Buffer m_buffer;
+		GLuint m_size;
+		GLuint m_capacity;
+		GLuint m_textureView;
+		GLuint m_textureViewBuffer;
+		InternalFormat m_textureViewFormat;
+	};
+
+} // namespace gpupro
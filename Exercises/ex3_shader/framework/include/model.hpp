@@ -37,6 +37,10 @@ namespace gpupro {
 		// Call glDrawElements for the entire internal vertex buffer.
 		void draw(DrawPrimitiveType _primType = DrawPrimitiveType::TRIANGLES) const;
 
+		// Record bind() and draw() into a command buffer instead.
+		void bind(class CommandBuffer& _commands, int _posBindIdx, int _tsBindIdx, int _texBindIdx);
+		void draw(class CommandBuffer& _commands, DrawPrimitiveType _primType = DrawPrimitiveType::TRIANGLES) const;
+
 		const glm::vec3& boundingBoxMin() const { return m_bbMin; }
 		const glm::vec3& boundingBoxMax() const { return m_bbMax; }
 	private:
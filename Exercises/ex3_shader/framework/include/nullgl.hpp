@@ -0,0 +1,63 @@
+#pragma once
+
+#include "glfunctions.hpp"
+#include <vector>
+
+namespace gpupro {
+
+	// An alternative function table for glad which does not need a GPU.
+	// Every GL call is recorded (function, arguments and a timestamp)
+	// instead of being executed. Functions which create objects or return
+	// a state give plausible answers (incrementing names, complete
+	// framebuffers, signaled fences, successful compiles, ...), such that
+	// the framework runs as on a real 4.5 context.
+	//
+	// This allows to measure the CPU side of the framework and to count
+	// the GL calls per frame (e.g. to verify the redundant state filter)
+	// without a window. Use it through OGLContext(..., Backend::NULL_RECORDING)
+	// or call load() directly instead of gladLoadGL().
+	//
+	// Only the values of the arguments are recorded. For pointers this is
+	// the address, not the data behind it.
+	class NullGL
+	{
+	public:
+		typedef GLFunction Function;
+
+		struct Call
+		{
+			Function function;
+			GLuint firstArgument;		///< Index into arguments()
+			GLuint numArguments;
+			GLuint64 timestamp;			///< Nanoseconds since load()
+		};
+
+		// Replace all glad function pointers and report version 4.5 with all
+		// extensions. This also resets the recording.
+		static void load();
+		static bool isLoaded();
+
+		// Calls are counted always. Disable the recording of the calls and
+		// their arguments to measure the framework without recording costs.
+		static void setRecording(bool _enable);
+
+		// Clear all recorded calls and counters (e.g. at the begin of a frame).
+		// Object names continue to increase.
+		static void reset();
+
+		static const std::vector<Call>& calls();
+		// All arguments converted to 64 bit. Floats are stored as their bit
+		// pattern, use argumentAsFloat()/argumentAsDouble() to convert back.
+		static const GLuint64* arguments(const Call& _call);
+		static float argumentAsFloat(GLuint64 _argument);
+		static double argumentAsDouble(GLuint64 _argument);
+
+		static GLuint64 numCalls(Function _function);
+		// Total number of calls since the last reset().
+		static GLuint64 numCalls();
+
+		// Name of the GL function without the glad_ prefix, e.g. "glEnable".
+		static const char* name(Function _function);
+	};
+
+} // namespace gpupro
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "buffer.hpp"
+#include "pipeline.hpp"
+#include "program.hpp"
+#include "query.hpp"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace gpupro {
+
+	class OGLContext;
+	class BindingTable;
+
+	// Skips draws of objects which are hidden behind others. The test draws
+	// the bounding box of each object inside an occlusion query (without
+	// color and depth writes). The GPU decides with glBeginConditionalRender
+	// whether the real draw is executed, so the CPU never waits for a result.
+	//
+	// Temporal coherence: execute() reads the results of previous frames
+	// as far as they are available (without waiting) and
+	// 1. draws the objects which were visible unconditionally. They fill
+	//    the depth buffer,
+	// 2. tests the boxes of all objects against it,
+	// 3. draws the objects which were hidden (or unknown) conditionally on
+	//    the test of this frame.
+	// Objects which become visible appear in the same frame, objects which
+	// become hidden are skipped one frame later.
+	//
+	// Objects are identified by the handle from addObject() over frames.
+	// Objects whose box intersects the near plane or which have no result
+	// yet are always drawn.
+	//
+	// Only the submitted objects and the depth buffer content before
+	// execute() occlude. Draw other occluders first; a single object tested
+	// against a cleared depth buffer is never culled and only pays for the
+	// test.
+	class OcclusionCuller
+	{
+	public:
+		struct Stats
+		{
+			GLuint numSubmitted = 0;
+			GLuint numDrawnVisible = 0;		///< Drawn without condition (phase 1 and boxes at the near plane)
+			GLuint numTested = 0;			///< Phase 2
+			GLuint numConditional = 0;		///< Phase 3, the GPU skips the hidden ones
+			GLuint numHiddenLastFrame = 0;	///< Objects known to be hidden by the latest available result
+		};
+
+		// Results are read at most this many frames later. Older queries are
+		// reused without reading them.
+		static const GLuint LATENCY = 3;
+
+		// _type: SAMPLES_PASSED, ANY_SAMPLES_PASSED or
+		//		ANY_SAMPLES_PASSED_CONSERVATIVE (fastest, may report hidden
+		//		objects as visible).
+		explicit OcclusionCuller(Query::Type _type = Query::Type::ANY_SAMPLES_PASSED_CONSERVATIVE);
+		// Move but not copy-able
+		OcclusionCuller(OcclusionCuller&& _rhs) = default;
+		OcclusionCuller(const OcclusionCuller&) = delete;
+		OcclusionCuller& operator = (OcclusionCuller&& _rhs) = default;
+		OcclusionCuller& operator = (const OcclusionCuller&) = delete;
+
+		// Register an object with its bounding box in object space (e.g.
+		// Model::boundingBoxMin/Max()). The box must contain every position
+		// the vertex processing of the object's pipelines can produce. If a
+		// shader displaces or deforms vertices, pass a conservative box,
+		// otherwise visible objects get culled.
+		GLuint addObject(const glm::vec3& _bbMin, const glm::vec3& _bbMax);
+
+		// Draw an object in this frame (at most once per frame). The pipeline
+		// and the binding table must stay alive until execute().
+		// _world: Object to world transformation of the box. Together with
+		//		the box it must cover any displacement of the vertex shader.
+		// _bindings: optional.
+		// _draw: Binds the geometry and draws. It must not change the
+		//		pipeline or the binding table.
+		void submit(GLuint _object, const glm::mat4& _world, const CompiledPipeline& _pipeline, const BindingTable* _bindings,
+			std::function<void()> _draw);
+
+		// Test and draw everything submitted since the last call. Binds the
+		// internal box pipeline in between.
+		void execute(OGLContext& _context, const glm::mat4& _viewProjection);
+
+		// Statistics of the last execute().
+		const Stats& stats() const { return m_stats; }
+	private:
+		struct Object
+		{
+			std::vector<Query> queries;		///< Ring of LATENCY queries
+			GLuint64 issued[LATENCY];		///< Frame of each query, 0 if not pending
+			GLuint64 resultFrame;			///< Frame of the latest read result, 0 if unknown
+			bool visible;					///< Latest read result
+			glm::mat4 box;					///< Unit cube to object space
+		};
+
+		struct Draw
+		{
+			GLuint object;
+			glm::mat4 boxToWorld;
+			const CompiledPipeline* pipeline;
+			const BindingTable* bindings;
+			std::function<void()> draw;
+		};
+
+		void readResults(Object& _object);
+		void draw(OGLContext& _context, const Draw& _draw);
+
+		Query::Type m_type;
+		Program m_boxProgram;
+		GLint m_boxToClipLocation;
+		std::shared_ptr<VertexFormat> m_boxFormat;
+		std::unique_ptr<CompiledPipeline> m_boxPipeline;
+		Buffer m_boxVertices;
+		Buffer m_boxIndices;
+
+		std::vector<Object> m_objects;
+		std::vector<Draw> m_draws;
+		GLuint64 m_frame;
+		Stats m_stats;
+	};
+
+} // namespace gpupro
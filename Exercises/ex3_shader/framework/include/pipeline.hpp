@@ -1,9 +1,11 @@
 #pragma once
 
+#include "bindingtable.hpp"
 #include "program.hpp"
 #include "vertexformat.hpp"
 
 #include "gl.hpp"
+#include <memory>
 
 namespace gpupro {
 
@@ -151,6 +153,7 @@ namespace gpupro {
 	// Sampler states are real resources which must be allocated...
 	// Create some sampler objects globally and share them everywhere.
 	// You will probably never need more than 3 different samplers.
+	// The SamplerCache does this sharing automatically.
 	class SamplerState
 	{
 	public:
@@ -181,6 +184,25 @@ namespace gpupro {
 			DISABLE
 		};
 
+		// All parameters of a sampler. The defaults are that of OpenGL.
+		struct Desc
+		{
+			Filter minFilter = Filter::NEAREST;
+			Filter magFilter = Filter::LINEAR;
+			Filter mipFilter = Filter::LINEAR;
+			float maxAnisotropy = 1.0f;
+			DepthCompareFunc depthCmpFunc = DepthCompareFunc::DISABLE;
+			// It is possible to use different handlers in different dimensions.
+			// Since there are practically no usecases this framework simplifies
+			// this down to one setting.
+			BorderHandling borderHandling = BorderHandling::REPEAT;
+			float borderColor[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+			bool operator == (const Desc& _rhs) const;
+			bool operator != (const Desc& _rhs) const { return !(*this == _rhs); }
+			GLuint64 hash() const;
+		};
+
 		// The constructor creates the entire sampler object with all parameters.
 		// The arguments are sorted for importance and the defaults are that
 		// of OpenGL.
@@ -194,6 +216,7 @@ namespace gpupro {
 			BorderHandling _borderHandling = BorderHandling::REPEAT,
 			float _borderColor[4] = nullptr
 		);
+		explicit SamplerState(const Desc& _desc);
 		~SamplerState();
 		// Move but not copy-able
 		SamplerState(SamplerState&& _rhs);
@@ -202,20 +225,39 @@ namespace gpupro {
 		SamplerState& operator = (const SamplerState& _rhs) = delete;
 
 		GLuint glID() { return m_id; }
+		const Desc& desc() const { return m_desc; }
 	private:
 		GLuint m_id;
-		// The following states are not required for execution.
-		// They only expose the state for debugging reasons.
-#ifdef DEBUG
-		Filter m_minFilter;
-		Filter m_magFilter;
-		Filter m_mipFilter;
-		DepthCompareFunc m_depthCmpFunc;
-		// It is possible to use different handlers in different dimensions.
-		// Since there are practically no usecases this framework simplifies
-		// this down to one setting.
-		BorderHandling m_borderHandling;
-#endif
+		// Not required for execution. It is kept for the SamplerCache and
+		// exposes the state for debugging reasons.
+		Desc m_desc;
+	};
+
+	// Deduplicates sampler objects by their full descriptor. Equal
+	// descriptors return the same SamplerState, so pipelines which use
+	// equal samplers have equal GL names in their sampler slots. This keeps
+	// CompiledPipeline hashes equal and lets OGLContext skip the
+	// glBindSamplers calls.
+	//
+	// The samplers are reference counted. The GL object is released (through
+	// the DeletionQueue) when the last reference is dropped, the cache itself
+	// only holds weak references.
+	class SamplerCache
+	{
+	public:
+		static std::shared_ptr<SamplerState> get(const SamplerState::Desc& _desc);
+		// Same arguments as the SamplerState constructor.
+		static std::shared_ptr<SamplerState> get(SamplerState::Filter _minFilter = SamplerState::Filter::NEAREST,
+			SamplerState::Filter _magFilter = SamplerState::Filter::LINEAR,
+			SamplerState::Filter _mipFilter = SamplerState::Filter::LINEAR,
+			float _maxAnisotropy = 1.0f,
+			SamplerState::DepthCompareFunc _depthCmpFunc = SamplerState::DepthCompareFunc::DISABLE,
+			SamplerState::BorderHandling _borderHandling = SamplerState::BorderHandling::REPEAT,
+			const float _borderColor[4] = nullptr
+		);
+
+		// Number of sampler objects which are alive.
+		static size_t numSamplers();
 	};
 
 	// A pipeline is a collection of the entire OpenGL state.
@@ -238,7 +280,8 @@ namespace gpupro {
 	//	  OGLContext::setState() will do as few as possible real state changes
 	//	  on GPU side. However, each state is tested if it changed since the
 	//	  previous state. All together this can be faster or slower than a raw
-	//	  implementation with many states.
+	//	  implementation with many states. A CompiledPipeline does the
+	//	  validation once and reduces the test to a few integer compares.
 	//	* API upward compatibility DX12 and Vulkan follow the same concept.
 	struct Pipeline
 	{
@@ -249,7 +292,73 @@ namespace gpupro {
 		// that many. Have a look at GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS.
 		SamplerState* samplerState[64] = {nullptr};
 		Program* shader = nullptr;
+		// Alternative to shader: separable programs per stage. Only used if
+		// shader is nullptr.
+		ProgramPipeline* programs = nullptr;
 		VertexFormat* vertexFormat = nullptr;
+		// Optional resources which are bound together with the state. The
+		// table is referenced, so it can be changed after compilation.
+		BindingTable* bindings = nullptr;
+	};
+
+	// A Pipeline packed into a compact form which can be switched fast.
+	// Each GL call of the state is represented by one 64 bit key (the raw
+	// enums/values of that call). OGLContext::setState() compares the keys
+	// into a bit mask of changed calls and only issues the calls of set bits.
+	//
+	// The GL names of the shader(s), vertex format and samplers are copied at
+	// construction. Compile the pipeline again if one of them is replaced.
+	class CompiledPipeline
+	{
+	public:
+		explicit CompiledPipeline(const Pipeline& _pipeline);
+
+		// Hash over the entire state. Equal pipelines have the same hash.
+		// Useful to sort draw calls or to find duplicates.
+		GLuint64 hash() const { return m_hash; }
+	private:
+		friend class OGLContext;
+
+		// One slot per GL call.
+		enum Slot
+		{
+			CULL_MODE,
+			FRONT_FACE,
+			POLYGON_MODE,
+			LINE_WIDTH,
+			RASTERIZER_DISCARD,
+			COLOR_MASK,
+			DITHER,
+			DEPTH_TEST,
+			DEPTH_FUNC,
+			DEPTH_MASK,
+			STENCIL_TEST,
+			STENCIL_FUNC_FRONT,
+			STENCIL_FUNC_BACK,
+			STENCIL_OP_FRONT,
+			STENCIL_OP_BACK,
+			BLEND_MODE,
+			BLEND_EQUATION0,					///< 8 slots, one per draw buffer
+			BLEND_FUNC0 = BLEND_EQUATION0 + 8,	///< 8 slots, one per draw buffer
+			LOGIC_OP = BLEND_FUNC0 + 8,
+			ALPHA_TO_COVERAGE,
+			PROGRAM,
+			STAGE_PROGRAM0,						///< One slot per ProgramPipeline::Stage
+			VERTEX_ARRAY = STAGE_PROGRAM0 + ProgramPipeline::NUM_STAGES,
+			NUM_SLOTS
+		};
+		static_assert(NUM_SLOTS <= 64, "The dirty mask has 64 bits.");
+
+		GLuint64 m_keys[NUM_SLOTS];
+		// Slots which are irrelevant for this pipeline (e.g. stencil
+		// functions if the stencil test is disabled). They are never changed
+		// by setState() to avoid useless calls.
+		GLuint64 m_ignoreMask;
+		// Sampler names per texture unit and a bit mask of used units.
+		GLuint m_samplers[64];
+		GLuint64 m_samplerMask;
+		BindingTable* m_bindings;
+		GLuint64 m_hash;
 	};
 
 	// Compute shaders ignore most of the state. Therefore, the ComputePipeline
@@ -258,6 +367,7 @@ namespace gpupro {
 	{
 		SamplerState* samplerState[64] = {nullptr};
 		Program* shader = nullptr;
+		BindingTable* bindings = nullptr;
 	};
 
 } // namespace gpupro
\ No newline at end of file
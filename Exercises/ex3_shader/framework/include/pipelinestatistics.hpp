@@ -0,0 +1,87 @@
+#pragma once
+
+#include "gl.hpp"
+#include <string>
+#include <vector>
+
+namespace gpupro {
+
+	// Counts the work of each pass with pipeline statistics queries
+	// (ARB_pipeline_statistics_query, core in 4.6): vertices and primitives
+	// submitted, shader invocations per stage and primitives before and
+	// after clipping. The numbers answer questions like "how much overdraw
+	// does this pass have" or "did the reordering improve vertex reuse".
+	//
+	// Like the GpuProfiler the queries come from a per-frame pool and are
+	// read LATENCY frames later at the latest, without waiting. Passes
+	// cannot be nested (only one query per counter can be active).
+	// RenderGraph::execute() measures each pass if this is enabled.
+	class PipelineStatistics
+	{
+	public:
+		enum Counter
+		{
+			VERTICES_SUBMITTED,
+			PRIMITIVES_SUBMITTED,
+			VERTEX_SHADER_INVOCATIONS,
+			TESS_CONTROL_SHADER_PATCHES,
+			TESS_EVALUATION_SHADER_INVOCATIONS,
+			GEOMETRY_SHADER_INVOCATIONS,
+			GEOMETRY_SHADER_PRIMITIVES_EMITTED,
+			FRAGMENT_SHADER_INVOCATIONS,
+			COMPUTE_SHADER_INVOCATIONS,
+			CLIPPING_INPUT_PRIMITIVES,
+			CLIPPING_OUTPUT_PRIMITIVES,
+			NUM_COUNTERS
+		};
+
+		struct PassStatistics
+		{
+			std::string name;
+			GLuint64 counters[NUM_COUNTERS];
+			GLuint64 numPixels;		///< Size of the render target, 0 if unknown
+
+			// Fragment shader invocations per pixel. Includes fragments which
+			// fail the depth test after shading.
+			double overdraw() const;
+			// Vertices submitted per vertex shader invocation. Values above 1
+			// mean that the post transform cache reused shaded vertices.
+			double vertexReuse() const;
+		};
+
+		static const GLuint LATENCY = 4;
+
+		// False if the driver does not support the queries.
+		static bool isSupported();
+
+		// The measurement is off initially. Disabling releases all queries.
+		static void setEnabled(bool _enable);
+		static bool isEnabled();
+
+		// Count all draws and dispatches until endPass().
+		// _numPixels: Size of the render target for overdraw().
+		static void beginPass(const char* _name, GLuint64 _numPixels = 0);
+		static void endPass();
+
+		// Close the current frame and collect all finished frames. This is
+		// called by OGLContext::endFrame().
+		static void endFrame();
+
+		// The passes of the latest collected frame in execution order.
+		static const std::vector<PassStatistics>& statistics();
+		// Writes statistics() as a table to std::cerr.
+		static void printStatistics();
+	};
+
+	// Measures the lifetime of the object as a pass of the
+	// PipelineStatistics.
+	class PipelineStatisticsScope
+	{
+	public:
+		explicit PipelineStatisticsScope(const char* _name, GLuint64 _numPixels = 0) { PipelineStatistics::beginPass(_name, _numPixels); }
+		~PipelineStatisticsScope() { PipelineStatistics::endPass(); }
+		PipelineStatisticsScope(const PipelineStatisticsScope&) = delete;
+		PipelineStatisticsScope& operator = (const PipelineStatisticsScope&) = delete;
+	};
+
+} // namespace gpupro
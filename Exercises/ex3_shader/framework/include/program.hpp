@@ -1,10 +1,52 @@
 #pragma once
 
 #include "gl.hpp"
+#include "shader.hpp"
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <initializer_list>
+#include <string>
 #include <vector>
 
 namespace gpupro {
 
+	// A uniform of the default block or a member of a uniform/storage block
+	// as reported by the driver after linking.
+	struct ProgramUniform
+	{
+		std::string name;		///< Arrays are named "name[0]"
+		GLenum type;			///< E.g. GL_FLOAT_VEC3 or GL_SAMPLER_2D
+		GLint arraySize;		///< 1 for non-arrays
+		GLint location;			///< Default block only, otherwise -1
+		GLint binding;			///< Texture/image unit of samplers and images, otherwise -1
+		GLint offset;			///< Byte offset in the block, -1 in the default block
+		GLint arrayStride;		///< Block members only
+		GLint matrixStride;		///< Block members only
+	};
+
+	// A uniform (std140) or shader storage (std430) block.
+	struct ProgramBlock
+	{
+		std::string name;
+		GLint binding;
+		GLint dataSize;			///< Minimum buffer size in bytes
+		std::vector<ProgramUniform> members;	///< Sorted by offset
+	};
+
+	// A member of a C++ struct which mirrors a block, see
+	// Program::validateBlock() and GPUPRO_BLOCK_MEMBER.
+	struct BlockMemberLayout
+	{
+		const char* name;		///< Name in GLSL (arrays: "name[0]")
+		size_t offset;
+		size_t size;
+	};
+
+	// BlockMemberLayout of Struct::member which is called _glslName in the
+	// shader.
+	#define GPUPRO_BLOCK_MEMBER(Struct, member, glslName) \
+		gpupro::BlockMemberLayout{glslName, offsetof(Struct, member), sizeof(Struct::member)}
+
 	// A program is a fixed set of shaders linked together.
 	class Program
 	{
@@ -25,22 +67,139 @@ namespace gpupro {
 
 		// Add a compiled shader object to this program.
 		void attach(class Shader& _shader);
+		// Separable programs can be combined with other separable programs
+		// in a ProgramPipeline instead of linking all stages together (core
+		// since 4.1). Set this before linking or loading a binary.
+		void setSeparable(bool _separable);
+		bool isSeparable() const { return m_separable; }
 		// Link all the shaders now.
 		void link();
+		// Deferred linking: submitLink() only starts the linking (the
+		// attached shaders may still be compiling). checkStatus() throws the
+		// link log on errors (link() = submitLink() + checkStatus()).
+		void submitLink();
+		void checkStatus();
+		// True if linking finished, i.e. checkStatus() does not block.
+		// Always true without hasParallelShaderCompile().
+		bool isReady() const;
 
 		// Load from cached binary data (core since 4.1). This includes an
 		// implicit linking.
-		// The binary blob is driver dependent!
-		void loadFromBinary(GLenum _binaryFormat, const std::vector<unsigned char>& _binary);
+		// The binary blob is driver dependent! Returns false if the driver
+		// rejected it (e.g. after a driver update). Then compile the program
+		// from source again.
+		bool loadFromBinary(GLenum _binaryFormat, const std::vector<unsigned char>& _binary);
 		// Load a shader from a binary blob which was compiled
 		// for the very same driver.
 		// _binaryFormat: Second return value which specifies the format
 		//		of the data.
 		std::vector<unsigned char> getBinary(GLenum& _binaryFormat);
 
+		// ***** Reflection *******************************************************
+		// The interface is queried once after successful linking (or loading
+		// a binary). Nothing below asks the driver again.
+
+		// Uniforms of the default block, including samplers.
+		const std::vector<ProgramUniform>& uniforms() const { return m_uniforms; }
+		const std::vector<ProgramBlock>& uniformBlocks() const { return m_uniformBlocks; }
+		const std::vector<ProgramBlock>& storageBlocks() const { return m_storageBlocks; }
+		// A uniform or shader storage block, nullptr if there is none.
+		const ProgramBlock* findBlock(const char* _name) const;
+		// Location of a default block uniform ("name", "name[0]" or
+		// "name[i]" for arrays, "name[i].member" for arrays of structs). -1
+		// if it does not exist or is unused, then the setters ignore it. Get
+		// the location once, not per frame.
+		GLint uniformLocation(const char* _name) const;
+
+		// Compare the layout of a C++ struct with a block. Prints every
+		// mismatch (offset, size, members missing on either side) and
+		// returns false if there was one. Call it once after loading,
+		// e.g. validateBlock<TransformUniforms>("ubo_transform", {...}).
+		bool validateBlock(const char* _blockName, size_t _structSize, std::initializer_list<BlockMemberLayout> _members) const;
+		template<typename T>
+		bool validateBlock(const char* _blockName, std::initializer_list<BlockMemberLayout> _members) const
+		{
+			return validateBlock(_blockName, sizeof(T), _members);
+		}
+
+		// Typed setters for the default block (glProgramUniform*, core since
+		// 4.1, the program does not need to be bound). A value which equals
+		// the last value set through these functions is not uploaded again.
+		// Values set by other means (e.g. initializers in GLSL) are unknown,
+		// so the first call is always uploaded.
+		void setUniform(GLint _location, float _value);
+		void setUniform(GLint _location, const glm::vec2& _value);
+		void setUniform(GLint _location, const glm::vec3& _value);
+		void setUniform(GLint _location, const glm::vec4& _value);
+		// Also for bool uniforms and the texture unit of samplers.
+		void setUniform(GLint _location, GLint _value);
+		void setUniform(GLint _location, const glm::ivec2& _value);
+		void setUniform(GLint _location, const glm::ivec3& _value);
+		void setUniform(GLint _location, const glm::ivec4& _value);
+		void setUniform(GLint _location, GLuint _value);
+		void setUniform(GLint _location, const glm::mat3& _value);
+		void setUniform(GLint _location, const glm::mat4& _value);
+
+		// Number of set calls which were skipped because the value did not
+		// change (since the start, all programs).
+		static GLuint64 numRedundantUniforms();
+
 		GLuint glID() { return m_id; }
 	private:
+		// Query the interface after linking.
+		void reflect();
+		// True if the value must be uploaded. Updates the shadow copy.
+		bool updateUniform(GLint _location, GLenum _type, const void* _value, size_t _size);
+
+		// Per location of the default block
+		struct UniformSlot
+		{
+			GLint uniform;			///< Index in m_uniforms, -1 for unused locations
+			GLuint valueOffset;		///< Shadow copy in m_uniformValues
+			bool known;				///< False until the first set
+		};
+
 		GLuint m_id;
+		bool m_separable;
+		std::vector<ProgramUniform> m_uniforms;
+		std::vector<ProgramBlock> m_uniformBlocks;
+		std::vector<ProgramBlock> m_storageBlocks;
+		std::vector<UniformSlot> m_uniformSlots;
+		std::vector<unsigned char> m_uniformValues;
+	};
+
+	// A set of separable programs, one per graphics stage. Each stage can
+	// be exchanged independently as long as the interfaces between the
+	// stages match (use explicit locations). N variants of one stage need
+	// N links instead of one link per combination with the other stages.
+	//
+	// Reference it in Pipeline::programs. The OGLContext owns a single GL
+	// program pipeline object and only swaps the stages which differ from
+	// the previous pipeline.
+	class ProgramPipeline
+	{
+	public:
+		enum Stage
+		{
+			VERTEX,
+			TESS_CONTROL,
+			TESS_EVALUATION,
+			GEOMETRY,
+			FRAGMENT,
+			NUM_STAGES
+		};
+
+		ProgramPipeline();
+		// Use the program for one stage, nullptr disables the stage. A
+		// program which contains several stages must be set for each of
+		// them. The GL name is copied, compile Pipelines again after a
+		// change.
+		void setStage(Shader::Type _stage, Program* _program);
+
+		// GL names of the stage programs, 0 for unused stages.
+		GLuint glID(Stage _stage) const { return m_programs[_stage]; }
+	private:
+		GLuint m_programs[NUM_STAGES];
 	};
 
 } // namespace gpupro
\ No newline at end of file
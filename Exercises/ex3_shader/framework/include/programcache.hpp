@@ -0,0 +1,90 @@
+#pragma once
+
+#include "program.hpp"
+#include "shader.hpp"
+#include <string>
+#include <vector>
+
+namespace gpupro {
+
+	// Source code of one stage of a program. The name is only used in
+	// messages.
+	struct ShaderSource
+	{
+		Shader::Type type;
+		std::string source;
+		std::string name;
+
+		// Preprocess a file with ShaderPreprocessor (the file name and the
+		// defines become the name).
+		static ShaderSource fromFile(Shader::Type _type, const char* _fileName, const ShaderDefines& _defines = ShaderDefines());
+	};
+
+	// A program which is compiled and linked in the background by driver
+	// threads (see hasParallelShaderCompile()). Request all programs first,
+	// then do other loading work or render with a fallback until it is
+	// ready. Without the extension the driver may still compile
+	// asynchronously, but there is no way to ask without waiting.
+	class PendingProgram
+	{
+	public:
+		// Move but not copy-able
+		PendingProgram(PendingProgram&& _rhs) = default;
+		PendingProgram(const PendingProgram&) = delete;
+		PendingProgram& operator = (PendingProgram&& _rhs) = default;
+		PendingProgram& operator = (const PendingProgram&) = delete;
+
+		// True if program() will not block.
+		bool isReady() const;
+		// Wait for the driver if necessary, check the compile and link
+		// status (throws the log on errors) and return the program.
+		Program& program();
+		// The program if it is ready, otherwise _fallback. Never blocks.
+		// Note that a CompiledPipeline copies the program name; compile it
+		// again once the real program is ready.
+		Program* programOr(Program* _fallback);
+	private:
+		friend class ProgramCache;
+		PendingProgram() : m_cacheKey(0), m_checked(false) {}
+
+		Program m_program;
+		std::vector<Shader> m_shaders;	///< Until the status is checked
+		std::string m_cacheFile;
+		GLuint64 m_cacheKey;			///< 0 if the binary is not cached
+		bool m_checked;
+	};
+
+	// Stores linked programs as driver binaries on disk (glGetProgramBinary)
+	// and loads them on the next start instead of compiling the sources.
+	//
+	// All shaders of a program are submitted before anything is checked, so
+	// they compile in parallel if the driver supports it.
+	//
+	// An entry is keyed by a hash over all stage sources (including all
+	// defines they contain), the separable flag, the GL vendor, renderer
+	// and version and the binary formats of the driver. A driver update
+	// therefore misses the cache. If the driver rejects a binary anyway the
+	// program is compiled from source and the entry is replaced.
+	//
+	// Caching is disabled until setDirectory() is called and if the driver
+	// supports no binary formats.
+	class ProgramCache
+	{
+	public:
+		// Directory for the binaries. It is created if it does not exist.
+		// nullptr disables the cache.
+		static void setDirectory(const char* _path);
+
+		// Load the program from the cache or compile and link it.
+		// _separable: link a program for a ProgramPipeline.
+		static Program get(const std::vector<ShaderSource>& _stages, bool _separable = false);
+		// Same as get() but does not wait for the compilation and linking.
+		// Programs from the cache are ready immediately.
+		static PendingProgram request(const std::vector<ShaderSource>& _stages, bool _separable = false);
+
+		// Statistics since the start.
+		static GLuint numHits();
+		static GLuint numMisses();
+	};
+
+} // namespace gpupro
@@ -45,7 +45,8 @@ namespace gpupro {
 
 		// Get the result. Busy waiting until the GPU reached the query.
 		// To prevent waiting use multiple objects and use available() to
-		// check if a query is ready.
+		// check if a query is ready. For GPU times of whole frames and
+		// passes the GpuProfiler does this automatically.
 		void receive(bool _wait = true);
 
 		// Check if the results are ready
@@ -60,8 +61,8 @@ namespace gpupro {
 		double avg() const { return m_avgResult; }
 
 		// Get the extremal values of all uses.
-		double min() const { return m_max; }
-		double max() const { return m_min; }
+		double min() const { return m_min; }
+		double max() const { return m_max; }
 
 		GLuint glID() { return m_id; }
 	private:
@@ -0,0 +1,236 @@
+#pragma once
+
+#include "gl.hpp"
+#include "format.hpp"
+#include "pipeline.hpp"
+#include <glm/glm.hpp>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace gpupro {
+
+	class Texture;
+	class Buffer;
+	class OGLContext;
+
+	// A render graph (frame graph) describes a frame as a sequence of passes
+	// which declare the textures and buffers they read and write. Before
+	// execution the graph
+	//	* culls passes whose results are never used,
+	//	* assigns the transient render targets to a pool of textures, such
+	//	  that targets with disjoint lifetimes share the same texture,
+	//	* inserts glMemoryBarrier() with only the bits which are required
+	//	  by incoherent writes (images, storage buffers),
+	//	* creates and binds the framebuffers and clears the targets. Only
+	//	  the write masks a clear needs are changed (no separate clear
+	//	  pipeline is required).
+	//
+	// Passes are executed in the order they were added. Usually, the graph
+	// is rebuilt every frame: reset(), create resources, add passes, compile()
+	// and execute(). The texture pool and the framebuffers are kept alive
+	// between frames. Framebuffers with a deleted attachment are dropped on
+	// the next compile().
+	class RenderGraph
+	{
+	public:
+		// Index of a resource in the current frame.
+		typedef GLuint ResourceHandle;
+
+		enum class PassType
+		{
+			GRAPHICS,
+			COMPUTE
+		};
+
+		// What happens with the old content of a render target.
+		enum class LoadOp
+		{
+			LOAD,		///< Keep the content (the pass reads the target).
+			CLEAR,		///< Clear to the given value.
+			DONT_CARE	///< The content is invalidated.
+		};
+
+		// How a pass reads a buffer.
+		enum class BufferAccess
+		{
+			UNIFORM,
+			STORAGE,
+			VERTEX,
+			INDEX,
+			INDIRECT
+		};
+
+		// Returned by addPass() to declare the resources of a pass.
+		class PassBuilder
+		{
+		public:
+			PassBuilder& sampleTexture(ResourceHandle _texture);
+			PassBuilder& readImage(ResourceHandle _texture);
+			PassBuilder& writeImage(ResourceHandle _texture);
+			PassBuilder& readBuffer(ResourceHandle _buffer, BufferAccess _access);
+			// Write access through shader storage.
+			PassBuilder& writeBuffer(ResourceHandle _buffer);
+			// Render into a color attachment. _slot is the fragment shader output.
+			PassBuilder& colorTarget(ResourceHandle _texture, GLuint _slot, LoadOp _load = LoadOp::LOAD, const glm::vec4& _clearColor = glm::vec4(0.0f));
+			// Render into the depth and/or stencil attachment.
+			PassBuilder& depthStencilTarget(ResourceHandle _texture, LoadOp _load = LoadOp::LOAD, float _clearDepth = 1.0f, GLint _clearStencil = 0);
+			// The pass is never culled (e.g. it reads back data or writes to
+			// resources unknown to the graph).
+			PassBuilder& sideEffects();
+		private:
+			friend class RenderGraph;
+			PassBuilder(RenderGraph& _graph, GLuint _pass) : m_graph(_graph), m_pass(_pass) {}
+			RenderGraph& m_graph;
+			GLuint m_pass;
+		};
+
+		struct Stats
+		{
+			GLuint numPasses = 0;
+			GLuint numCulledPasses = 0;
+			GLuint numTransientTextures = 0;	///< Transient textures used by alive passes
+			GLuint numPoolTextures = 0;			///< Real textures which back the transient ones
+			GLuint numBarriers = 0;
+		};
+
+		RenderGraph();
+		~RenderGraph();
+		RenderGraph(const RenderGraph&) = delete;
+		RenderGraph& operator = (const RenderGraph&) = delete;
+
+		// A 2D texture owned by the graph, only valid within the frame.
+		ResourceHandle createTexture(const char* _name, GLsizei _width, GLsizei _height, InternalFormat _format);
+		// Persistent resources. Writes to imported resources are only kept
+		// if the resource is marked as output.
+		ResourceHandle importTexture(const char* _name, Texture& _texture);
+		ResourceHandle importBuffer(const char* _name, Buffer& _buffer);
+		// The default framebuffer (color, depth and stencil). It is always an
+		// output. Use it as color target 0 and/or as depth-stencil target.
+		ResourceHandle importBackbuffer(GLsizei _width, GLsizei _height);
+		// Keep all passes which contribute to this resource.
+		void markOutput(ResourceHandle _resource);
+
+		// _execute is called during execute() after the render targets are
+		// bound and cleared. It should set the pipeline, bind the resources
+		// and draw/dispatch.
+		PassBuilder addPass(const char* _name, PassType _type, std::function<void()> _execute);
+
+		// Texture which is assigned to a resource. For transient textures
+		// this is valid after compile().
+		Texture& texture(ResourceHandle _resource);
+		Buffer& buffer(ResourceHandle _resource);
+
+		// Cull passes, alias transient textures and compute barriers.
+		void compile();
+		void execute(OGLContext& _context);
+		// Remove all passes and resources. The texture pool is kept.
+		void reset();
+
+		const Stats& stats() const { return m_stats; }
+	private:
+		enum class ResourceType
+		{
+			TEXTURE,
+			BUFFER,
+			BACKBUFFER
+		};
+
+		enum class AccessType
+		{
+			SAMPLED,
+			IMAGE_READ,
+			IMAGE_WRITE,
+			BUFFER_READ,
+			BUFFER_WRITE,
+			COLOR_TARGET,
+			DEPTH_STENCIL_TARGET
+		};
+
+		struct Access
+		{
+			Access(ResourceHandle _resource, AccessType _type, BufferAccess _bufferAccess = BufferAccess::UNIFORM, GLuint _slot = 0,
+				LoadOp _load = LoadOp::LOAD, const glm::vec4& _clearColor = glm::vec4(0.0f), float _clearDepth = 1.0f, GLint _clearStencil = 0) :
+				resource(_resource), type(_type), bufferAccess(_bufferAccess), slot(_slot),
+				load(_load), clearColor(_clearColor), clearDepth(_clearDepth), clearStencil(_clearStencil)
+			{}
+
+			ResourceHandle resource;
+			AccessType type;
+			BufferAccess bufferAccess;
+			GLuint slot;
+			LoadOp load;
+			glm::vec4 clearColor;
+			float clearDepth;
+			GLint clearStencil;
+		};
+
+		struct Pass
+		{
+			std::string name;
+			PassType type;
+			std::function<void()> execute;
+			std::vector<Access> accesses;
+			bool sideEffects;
+			// Results of compile()
+			bool alive;
+			GLbitfield barrierBits;
+			GLuint framebuffer;
+			GLsizei viewport[2];
+		};
+
+		struct Resource
+		{
+			Resource(const char* _name, ResourceType _type, Texture* _texture, Buffer* _buffer,
+				GLsizei _width, GLsizei _height, InternalFormat _format, bool _transient, bool _output) :
+				name(_name), type(_type), texture(_texture), buffer(_buffer), width(_width), height(_height),
+				format(_format), transient(_transient), output(_output), firstPass(-1), lastPass(-1)
+			{}
+
+			std::string name;
+			ResourceType type;
+			Texture* texture;
+			Buffer* buffer;
+			GLsizei width, height;
+			InternalFormat format;
+			bool transient;
+			bool output;
+			// Results of compile()
+			int firstPass;
+			int lastPass;
+		};
+
+		struct PoolTexture
+		{
+			std::unique_ptr<Texture> texture;
+			int lastPass;	// Last pass using this texture in the current frame
+		};
+
+		static bool isTarget(AccessType _type) { return _type == AccessType::COLOR_TARGET || _type == AccessType::DEPTH_STENCIL_TARGET; }
+		static bool isWrite(AccessType _type) { return isTarget(_type) || _type == AccessType::IMAGE_WRITE || _type == AccessType::BUFFER_WRITE; }
+		// Barrier bit which makes incoherent writes visible to the access.
+		static GLbitfield requiredBarrier(const Access& _access);
+
+		ResourceHandle addResource(const Resource& _resource);
+		void addAccess(GLuint _pass, const Access& _access);
+		void cullPasses();
+		void assignTransientTextures();
+		void computeBarriers();
+		void createFramebuffers();
+		void clearTargets(OGLContext& _context, const Pass& _pass);
+
+		std::vector<Pass> m_passes;
+		std::vector<Resource> m_resources;
+		std::vector<PoolTexture> m_pool;
+		// Framebuffer objects for combinations of attachments (attachment
+		// points and texture names).
+		std::map<std::vector<GLuint>, GLuint> m_framebuffers;
+		// DeletionQueue::generation() of textures when the framebuffers were
+		// last checked for deleted attachments.
+		GLuint m_textureGeneration;
+		Stats m_stats;
+	};
+
+} // namespace gpupro
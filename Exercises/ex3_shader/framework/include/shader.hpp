@@ -1,9 +1,16 @@
 #pragma once
 
 #include "gl.hpp"
+#include <map>
+#include <string>
 
 namespace gpupro {
 
+	// Preprocessor symbols of one shader permutation (name -> value, the
+	// value may be empty). The map keeps the names sorted, so equal sets
+	// compare equal independent of the order they were added in.
+	typedef std::map<std::string, std::string> ShaderDefines;
+
 	// A shader is a single compiled GLSL file. They cannot be used directly,
 	// but must be bound and linked in a program object.
 	class Shader
@@ -32,14 +39,28 @@ namespace gpupro {
 		// Load from source code and compile.
 		// This is called by loadFromFile indirectly.
 		void loadFromSource(const char* _source, const char* _debugName = nullptr);
-		// Reads the file in memory and calls loadFromSource.
-		void loadFromFile(const char* _fileName);
+		// Deferred compilation: submit() only starts the compilation.
+		// Checking the status right away would wait for the driver, so
+		// submit all shaders first and link them. checkStatus() throws the
+		// compile log on errors (loadFromSource() = submit() + checkStatus()).
+		void submit(const char* _source, const char* _debugName = nullptr);
+		void checkStatus();
+		// True if the compilation finished, i.e. checkStatus() does not
+		// block. Always true without hasParallelShaderCompile().
+		bool isReady() const;
+		// Preprocesses the file (resolves #include and adds _defines, see
+		// ShaderPreprocessor) and calls loadFromSource.
+		void loadFromFile(const char* _fileName, const ShaderDefines& _defines = ShaderDefines());
+
+		// Read an entire source file. Throws if it cannot be opened.
+		static std::string readFile(const char* _fileName);
 
 		GLuint glID() { return m_id; }
 		GLenum type() const { return m_type; }
 	private:
 		GLuint m_id;
 		GLenum m_type;
+		std::string m_debugName;
 	};
 
 } // namespace gpupro
\ No newline at end of file
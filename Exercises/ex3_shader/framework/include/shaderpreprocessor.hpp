@@ -0,0 +1,84 @@
+#pragma once
+
+#include "programcache.hpp"
+#include "shader.hpp"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace gpupro {
+
+	// Expands shader files before they are passed to the driver:
+	// * #include "file" is replaced by the file. The path is relative to the
+	//   including file. Every file is included at most once per shader, so
+	//   include guards are not necessary (and cycles are harmless).
+	// * The defines are inserted directly after the #version line.
+	// #line directives keep the line numbers of the compile log correct. The
+	// log reports the n-th included file as source string n; the name of
+	// the ShaderSource lists these numbers.
+	//
+	// Files are read and expanded once. Variants are cached by the hash of
+	// the expanded source and the define set, so asking for a known variant
+	// costs a lookup only. The cache is never invalidated automatically;
+	// call clear() after editing files at runtime.
+	//
+	// Directives inside block comments are not recognized as comments.
+	class ShaderPreprocessor
+	{
+	public:
+		// The expanded source of the file with the defines. Throws if a file
+		// cannot be opened. The reference is valid until clear().
+		static const ShaderSource& get(Shader::Type _type, const char* _fileName, const ShaderDefines& _defines = ShaderDefines());
+
+		// Forget all files and variants.
+		static void clear();
+
+		// Number of cached variants.
+		static size_t numVariants();
+	};
+
+	// Specialized programs from the same stage files. Features are toggled
+	// by defines instead of dynamic branches on uniforms. Each define set is
+	// preprocessed, compiled and linked when it is requested first (through
+	// the ProgramCache) and kept afterwards.
+	//
+	// Request all variants which will be used early. They compile in
+	// parallel and get() does not need to wait later. Keep the returned
+	// references (or CompiledPipelines of them) instead of calling get()
+	// per draw call.
+	//
+	// Separable variants (one stage per ProgramVariants) can be combined in
+	// a ProgramPipeline. Then the number of links grows with the sum of the
+	// variants per stage instead of their product.
+	class ProgramVariants
+	{
+	public:
+		struct Stage
+		{
+			Shader::Type type;
+			std::string fileName;
+		};
+
+		explicit ProgramVariants(std::vector<Stage> _stages, bool _separable = false);
+		// Move but not copy-able
+		ProgramVariants(ProgramVariants&& _rhs) = default;
+		ProgramVariants(const ProgramVariants&) = delete;
+		ProgramVariants& operator = (ProgramVariants&& _rhs) = default;
+		ProgramVariants& operator = (const ProgramVariants&) = delete;
+
+		// Start the compilation of a variant if it is not known yet.
+		void request(const ShaderDefines& _defines);
+		// Wait for the variant (requests it if necessary). Throws on compile
+		// and link errors. The reference is valid as long as this object.
+		Program& get(const ShaderDefines& _defines);
+
+		size_t numVariants() const { return m_variants.size(); }
+	private:
+		PendingProgram& find(const ShaderDefines& _defines);
+
+		std::vector<Stage> m_stages;
+		bool m_separable;
+		std::map<ShaderDefines, PendingProgram> m_variants;
+	};
+
+} // namespace gpupro
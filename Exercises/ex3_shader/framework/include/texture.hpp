@@ -74,6 +74,9 @@ namespace gpupro {
 
 		// Bind as sampled texture
 		void bindAsTexture(GLuint _bindingIndex);
+		// Bind a mip level as image for random read/write access. The entire
+		// level is bound (all layers).
+		void bindAsImage(GLuint _bindingIndex, ImageAccess _access, GLuint _mipLevel = 0);
 
 		GLsizei width() const { return m_size[0]; }
 		GLsizei height() const { return m_size[1]; }
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "gl.hpp"
+#include <string>
+
+namespace gpupro {
+
+	// Records CPU zones of all threads together with the GPU scopes of the
+	// GpuProfiler and exports them as a Chrome trace (load the file in
+	// chrome://tracing or ui.perfetto.dev).
+	//
+	// Every thread writes into its own ring buffer without locks. A zone
+	// costs two clock reads and two small stores. When a buffer is full the
+	// oldest events are overwritten. Zone names are stored as pointers, so
+	// they must live until the export (use string literals).
+	//
+	// GPU timestamps run on a different clock. endFrame() measures the
+	// offset with glGetInteger64v(GL_TIMESTAMP) now and then, and the GPU
+	// zones are shifted by it.
+	//
+	// Recording is off initially. Enable it as the first thing in main()
+	// to see the startup. Define GPUPRO_NO_TIMELINE to compile all
+	// CPU_ZONEs out.
+	class Timeline
+	{
+	public:
+		// Capacity of the ring buffer of each thread and of the GPU zones.
+		static const size_t EVENTS_PER_THREAD = 1 << 16;
+
+		static void setEnabled(bool _enable);
+		static bool isEnabled();
+
+		// Name of the calling thread in the trace.
+		static void setThreadName(const char* _name);
+
+		// Use CPU_ZONE instead of calling these directly.
+		static void beginZone(const char* _name);
+		static void endZone();
+
+		// Frame marker and clock calibration. This is called by
+		// OGLContext::endFrame().
+		static void endFrame();
+
+		// Called by the GpuProfiler for each measured scope. The times are
+		// GPU timestamps in ns.
+		static void addGpuZone(const std::string& _name, GLuint64 _begin, GLuint64 _end);
+
+		// Write everything recorded so far. Other threads should not record
+		// at the same time, their latest events may be incomplete otherwise.
+		static bool exportChromeTrace(const char* _fileName);
+
+		// Forget all events.
+		static void clear();
+	};
+
+	// Records the lifetime of the object as a zone of the Timeline.
+	class CpuZone
+	{
+	public:
+		explicit CpuZone(const char* _name) { Timeline::beginZone(_name); }
+		~CpuZone() { Timeline::endZone(); }
+		CpuZone(const CpuZone&) = delete;
+		CpuZone& operator = (const CpuZone&) = delete;
+	};
+
+	#define GPUPRO_CONCAT_IMPL(a, b) a##b
+	#define GPUPRO_CONCAT(a, b) GPUPRO_CONCAT_IMPL(a, b)
+	// Record the CPU time from here to the end of the enclosing block:
+	//	{ CPU_ZONE("Load textures"); ... }
+#ifdef GPUPRO_NO_TIMELINE
+	#define CPU_ZONE(_name) ((void)0)
+#else
+	#define CPU_ZONE(_name) gpupro::CpuZone GPUPRO_CONCAT(cpuZone, __LINE__)(_name)
+#endif
+
+} // namespace gpupro
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "gl.hpp"
+#include <memory>
 #include <vector>
 
 namespace gpupro {
@@ -75,4 +76,20 @@ namespace gpupro {
 		GLuint m_id;
 	};
 
+	// Interns vertex formats by their attribute lists. Equal layouts return
+	// the same VertexFormat (the order of the attributes does not matter),
+	// so pipelines with the same layout share one VAO and OGLContext does
+	// not switch the vertex array between them.
+	//
+	// The formats are reference counted. The VAO is released when the last
+	// reference is dropped, the cache itself only holds weak references.
+	class VertexFormatCache
+	{
+	public:
+		static std::shared_ptr<VertexFormat> get(const std::vector<VertexAttribute>& _attributes);
+
+		// Number of vertex formats which are alive.
+		static size_t numFormats();
+	};
+
 } // namespace gpupro
\ No newline at end of file
@@ -0,0 +1,329 @@
+#pragma once
+
+#include "vertexformat.hpp"
+
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace gpupro {
+
+	// Describes vertex buffers by the C++ struct which is stored in them.
+	// The VertexAttribute list, the stride and the conversion from loader
+	// output are derived from the struct at compile time, so the offsets
+	// cannot get out of sync and layout mistakes fail to compile.
+	//
+	// Example:
+	//	struct Vertex
+	//	{
+	//		glm::vec3 position;
+	//		PackedNormal normal;		// 4 bytes instead of 12
+	//		Half<2> texCoord;			// 4 bytes instead of 8
+	//	};
+	//	typedef VertexLayout<Vertex, 0, 0,
+	//		GPUPRO_VERTEX_MEMBER(0, Vertex, position),
+	//		GPUPRO_VERTEX_MEMBER(1, Vertex, normal),
+	//		GPUPRO_VERTEX_MEMBER(2, Vertex, texCoord)
+	//	> Layout;
+	//
+	//	std::shared_ptr<VertexFormat> format = Layout::format();
+	//	std::vector<Vertex> vertices(n);
+	//	Layout::pack(vertices.data(), n, positions, normals, texCoords);
+	//
+	// A plain type can be a vertex as well. Then the member is the whole
+	// vertex: VertexLayout<glm::vec2, 2, 0, VertexMember<4, glm::vec2, 0>>.
+
+	// ***** Quantized member types *******************************************
+	// Integers which are mapped to [-1,1] (signed) or [0,1] (unsigned) in the
+	// shader. Use them for normals, colors or texture coordinates in [0,1].
+	template<typename T, int N>
+	struct Normalized
+	{
+		T v[N];
+	};
+	template<int N> using SNorm8 = Normalized<GLbyte, N>;
+	template<int N> using UNorm8 = Normalized<GLubyte, N>;
+	template<int N> using SNorm16 = Normalized<GLshort, N>;
+	template<int N> using UNorm16 = Normalized<GLushort, N>;
+
+	// Half precision floats (GL_HALF_FLOAT).
+	template<int N>
+	struct Half
+	{
+		GLushort v[N];
+	};
+
+	// Four signed normalized values in 10|10|10|2 bits (x in the lowest bits).
+	// The usual choice for normals and tangents (w can store the handedness).
+	struct PackedNormal
+	{
+		GLuint bits;
+	};
+
+	// ***** Batch converters *************************************************
+	// Convert _count scalars (_count elements for the packed normal) from
+	// the loader's floats into the quantized types and back. Values are
+	// clamped to the representable range and rounded to nearest.
+	// The conversions to normalized types and to half use SSE2 where
+	// available.
+	void pack(const float* _in, GLbyte* _out, size_t _count);
+	void pack(const float* _in, GLubyte* _out, size_t _count);
+	void pack(const float* _in, GLshort* _out, size_t _count);
+	void pack(const float* _in, GLushort* _out, size_t _count);
+	void packHalf(const float* _in, GLushort* _out, size_t _count);
+	// 4 floats per element. Signed normalized, the w component gets 2 bits.
+	void packNormal(const float* _in, GLuint* _out, size_t _count);
+
+	void unpack(const GLbyte* _in, float* _out, size_t _count);
+	void unpack(const GLubyte* _in, float* _out, size_t _count);
+	void unpack(const GLshort* _in, float* _out, size_t _count);
+	void unpack(const GLushort* _in, float* _out, size_t _count);
+	void unpackHalf(const GLushort* _in, float* _out, size_t _count);
+	void unpackNormal(const GLuint* _in, float* _out, size_t _count);
+
+	// ***** Member traits ****************************************************
+	// How a member type is presented to GL and which type the loader
+	// provides (Source, consisting of NUM_COMPONENTS Scalars).
+	// Specialize it to support further member types.
+	template<typename T> struct VertexMemberTraits;
+
+	namespace details {
+		// Unquantized members are copied.
+		template<typename T, typename ScalarT, GLint N, VertexAttribute::Type TypeT>
+		struct CopiedMember
+		{
+			typedef T Source;
+			typedef ScalarT Scalar;
+			static const GLint NUM_COMPONENTS = N;
+			static const VertexAttribute::Type TYPE = TypeT;
+			static const GLboolean NORMALIZED = GL_FALSE;
+			static void pack(const Scalar* _in, T* _out, size_t _count) { memcpy(static_cast<void*>(_out), _in, _count * sizeof(T)); }
+			static void unpack(const T* _in, Scalar* _out, size_t _count) { memcpy(_out, _in, _count * sizeof(T)); }
+		};
+
+		template<int N> struct FloatVector;
+		template<> struct FloatVector<1> { typedef float type; };
+		template<> struct FloatVector<2> { typedef glm::vec2 type; };
+		template<> struct FloatVector<3> { typedef glm::vec3 type; };
+		template<> struct FloatVector<4> { typedef glm::vec4 type; };
+
+		template<typename T> struct NormalizedType;
+		template<> struct NormalizedType<GLbyte> { static const VertexAttribute::Type TYPE = VertexAttribute::Type::INT8; };
+		template<> struct NormalizedType<GLubyte> { static const VertexAttribute::Type TYPE = VertexAttribute::Type::UINT8; };
+		template<> struct NormalizedType<GLshort> { static const VertexAttribute::Type TYPE = VertexAttribute::Type::INT16; };
+		template<> struct NormalizedType<GLushort> { static const VertexAttribute::Type TYPE = VertexAttribute::Type::UINT16; };
+
+		constexpr bool contains(GLuint) { return false; }
+		template<typename... Rest>
+		constexpr bool contains(GLuint _value, GLuint _first, Rest... _rest) { return _value == _first || contains(_value, _rest...); }
+		constexpr bool unique() { return true; }
+		template<typename... Rest>
+		constexpr bool unique(GLuint _first, Rest... _rest) { return !contains(_first, _rest...) && unique(_rest...); }
+		constexpr bool all() { return true; }
+		template<typename... Rest>
+		constexpr bool all(bool _first, Rest... _rest) { return _first && all(_rest...); }
+		constexpr bool disjoint(GLuint) { return true; }
+		template<typename... Rest>
+		constexpr bool disjoint(GLuint _a, GLuint _b, Rest... _rest) { return (_a & _b) == 0 && disjoint(_a | _b, _rest...); }
+		constexpr GLuint mask() { return 0; }
+		template<typename... Rest>
+		constexpr GLuint mask(GLuint _first, Rest... _rest) { return (1u << _first) | mask(_rest...); }
+
+		template<typename Layout>
+		void appendAttributes(std::vector<VertexAttribute>& _attributes)
+		{
+			std::array<VertexAttribute, Layout::NUM_ATTRIBUTES> attr = Layout::attributes();
+			_attributes.insert(_attributes.end(), attr.begin(), attr.end());
+		}
+	}
+
+	template<> struct VertexMemberTraits<float> : details::CopiedMember<float, float, 1, VertexAttribute::Type::FLOAT> {};
+	template<> struct VertexMemberTraits<glm::vec2> : details::CopiedMember<glm::vec2, float, 2, VertexAttribute::Type::FLOAT> {};
+	template<> struct VertexMemberTraits<glm::vec3> : details::CopiedMember<glm::vec3, float, 3, VertexAttribute::Type::FLOAT> {};
+	template<> struct VertexMemberTraits<glm::vec4> : details::CopiedMember<glm::vec4, float, 4, VertexAttribute::Type::FLOAT> {};
+	template<> struct VertexMemberTraits<GLint> : details::CopiedMember<GLint, GLint, 1, VertexAttribute::Type::INT32> {};
+	template<> struct VertexMemberTraits<glm::ivec2> : details::CopiedMember<glm::ivec2, GLint, 2, VertexAttribute::Type::INT32> {};
+	template<> struct VertexMemberTraits<glm::ivec3> : details::CopiedMember<glm::ivec3, GLint, 3, VertexAttribute::Type::INT32> {};
+	template<> struct VertexMemberTraits<glm::ivec4> : details::CopiedMember<glm::ivec4, GLint, 4, VertexAttribute::Type::INT32> {};
+	template<> struct VertexMemberTraits<GLuint> : details::CopiedMember<GLuint, GLuint, 1, VertexAttribute::Type::UINT32> {};
+	template<> struct VertexMemberTraits<glm::uvec2> : details::CopiedMember<glm::uvec2, GLuint, 2, VertexAttribute::Type::UINT32> {};
+	template<> struct VertexMemberTraits<glm::uvec3> : details::CopiedMember<glm::uvec3, GLuint, 3, VertexAttribute::Type::UINT32> {};
+	template<> struct VertexMemberTraits<glm::uvec4> : details::CopiedMember<glm::uvec4, GLuint, 4, VertexAttribute::Type::UINT32> {};
+
+	template<typename T, int N>
+	struct VertexMemberTraits<Normalized<T, N>>
+	{
+		static_assert(N >= 1 && N <= 4, "A vertex attribute has 1 to 4 components.");
+		typedef typename details::FloatVector<N>::type Source;
+		typedef float Scalar;
+		static const GLint NUM_COMPONENTS = N;
+		static const VertexAttribute::Type TYPE = details::NormalizedType<T>::TYPE;
+		static const GLboolean NORMALIZED = GL_TRUE;
+		static void pack(const float* _in, Normalized<T, N>* _out, size_t _count) { gpupro::pack(_in, _out->v, _count * N); }
+		static void unpack(const Normalized<T, N>* _in, float* _out, size_t _count) { gpupro::unpack(_in->v, _out, _count * N); }
+	};
+
+	template<int N>
+	struct VertexMemberTraits<Half<N>>
+	{
+		static_assert(N >= 1 && N <= 4, "A vertex attribute has 1 to 4 components.");
+		typedef typename details::FloatVector<N>::type Source;
+		typedef float Scalar;
+		static const GLint NUM_COMPONENTS = N;
+		static const VertexAttribute::Type TYPE = VertexAttribute::Type::HALF;
+		static const GLboolean NORMALIZED = GL_FALSE;
+		static void pack(const float* _in, Half<N>* _out, size_t _count) { packHalf(_in, _out->v, _count * N); }
+		static void unpack(const Half<N>* _in, float* _out, size_t _count) { unpackHalf(_in->v, _out, _count * N); }
+	};
+
+	template<>
+	struct VertexMemberTraits<PackedNormal>
+	{
+		typedef glm::vec4 Source;
+		typedef float Scalar;
+		static const GLint NUM_COMPONENTS = 4;
+		static const VertexAttribute::Type TYPE = VertexAttribute::Type::INT_2_10_10_10;
+		static const GLboolean NORMALIZED = GL_TRUE;
+		static void pack(const float* _in, PackedNormal* _out, size_t _count) { packNormal(_in, &_out->bits, _count); }
+		static void unpack(const PackedNormal* _in, float* _out, size_t _count) { unpackNormal(&_in->bits, _out, _count); }
+	};
+
+	// ***** Layouts **********************************************************
+	// A (possibly strided) array of source data, e.g. the normals inside
+	// OBJLoader::TangentSpace: VertexStream<glm::vec3>(&ts[0].normal, sizeof(ts[0])).
+	template<typename T>
+	struct VertexStream
+	{
+		VertexStream(const T* _data) : data(_data), stride(sizeof(T)) {}
+		VertexStream(const T* _data, size_t _stride) : data(_data), stride(_stride) {}
+
+		const T& operator [] (size_t _index) const { return *reinterpret_cast<const T*>(reinterpret_cast<const char*>(data) + _index * stride); }
+
+		const T* data;
+		size_t stride;
+	};
+
+	// One member of a vertex struct which is bound to the attribute
+	// AttributeIndex. Use GPUPRO_VERTEX_MEMBER to get the offset.
+	template<GLuint AttributeIndex, typename T, size_t Offset>
+	struct VertexMember
+	{
+		typedef VertexMemberTraits<T> Traits;
+		typedef typename Traits::Source Source;
+		typedef typename Traits::Scalar Scalar;
+		static const GLuint ATTRIBUTE_INDEX = AttributeIndex;
+		static const size_t OFFSET = Offset;
+		static const size_t SIZE = sizeof(T);
+
+		static_assert(AttributeIndex < 16, "Only 16 vertex attributes are guaranteed (GL_MAX_VERTEX_ATTRIBS).");
+		static_assert(Offset <= 2047, "The offset exceeds the guaranteed GL_MAX_VERTEX_ATTRIB_RELATIVE_OFFSET.");
+		static_assert(Offset % std::alignment_of<T>::value == 0, "The member is not aligned.");
+		static_assert(sizeof(Source) == Traits::NUM_COMPONENTS * sizeof(Scalar), "The source type must consist of tightly packed scalars.");
+
+		static constexpr VertexAttribute attribute(GLuint _bindingIndex, GLuint _divisor)
+		{
+			return VertexAttribute{AttributeIndex, _bindingIndex, Traits::NUM_COMPONENTS, Traits::TYPE, Traits::NORMALIZED, static_cast<GLuint>(Offset), _divisor};
+		}
+
+		// Convert in chunks: gather the sources, convert the chunk at once
+		// and scatter the results into the vertices.
+		static void pack(void* _vertices, size_t _vertexSize, size_t _count, VertexStream<Source> _source)
+		{
+			const size_t CHUNK = 64;
+			Scalar in[CHUNK * Traits::NUM_COMPONENTS];
+			T out[CHUNK];
+			for(size_t first = 0; first < _count; first += CHUNK)
+			{
+				size_t num = _count - first < CHUNK ? _count - first : CHUNK;
+				const Scalar* src = reinterpret_cast<const Scalar*>(&_source[first]);
+				if(_source.stride != sizeof(Source))
+				{
+					for(size_t i = 0; i < num; ++i)
+						memcpy(in + i * Traits::NUM_COMPONENTS, &_source[first + i], sizeof(Source));
+					src = in;
+				}
+				Traits::pack(src, out, num);
+				char* dst = static_cast<char*>(_vertices) + first * _vertexSize + Offset;
+				for(size_t i = 0; i < num; ++i)
+					memcpy(dst + i * _vertexSize, static_cast<const void*>(out + i), sizeof(T));
+			}
+		}
+
+		static void unpack(const void* _vertices, size_t _vertexSize, size_t _count, Source* _out)
+		{
+			const char* src = static_cast<const char*>(_vertices) + Offset;
+			T in;
+			for(size_t i = 0; i < _count; ++i)
+			{
+				memcpy(static_cast<void*>(&in), src + i * _vertexSize, sizeof(T));
+				Traits::unpack(&in, reinterpret_cast<Scalar*>(_out + i), 1);
+			}
+		}
+	};
+
+#define GPUPRO_VERTEX_MEMBER(_attributeIndex, _vertex, _member) \
+	::gpupro::VertexMember<_attributeIndex, decltype(_vertex::_member), offsetof(_vertex, _member)>
+
+	// All attributes of one vertex buffer which is bound to BindingIndex.
+	// Divisor: 0 for per vertex data, n to advance every n instances.
+	template<typename Vertex, GLuint BindingIndex, GLuint Divisor, typename... Members>
+	struct VertexLayout
+	{
+		static_assert(std::is_standard_layout<Vertex>::value, "offsetof requires a standard layout vertex.");
+		static_assert(sizeof(Vertex) <= 2048, "The stride exceeds the guaranteed GL_MAX_VERTEX_ATTRIB_STRIDE.");
+		static_assert(BindingIndex < 16, "Only 16 vertex buffer bindings are guaranteed (GL_MAX_VERTEX_ATTRIB_BINDINGS).");
+		static_assert(details::unique(Members::ATTRIBUTE_INDEX...), "Two members use the same attribute index.");
+		static_assert(details::all((Members::OFFSET + Members::SIZE <= sizeof(Vertex))...), "A member is outside of the vertex.");
+
+		static const GLuint BINDING_INDEX = BindingIndex;
+		static const GLuint NUM_ATTRIBUTES = sizeof...(Members);
+		// Use this as element size of the vertex buffer.
+		static const GLuint STRIDE = sizeof(Vertex);
+		// Bit i is set if attribute i is used.
+		static const GLuint ATTRIBUTE_MASK = details::mask(Members::ATTRIBUTE_INDEX...);
+
+		static constexpr std::array<VertexAttribute, sizeof...(Members)> attributes()
+		{
+			return {{Members::attribute(BindingIndex, Divisor)...}};
+		}
+
+		// The interned format of this layout alone. Use makeVertexFormat()
+		// to combine several buffers.
+		static std::shared_ptr<VertexFormat> format()
+		{
+			std::array<VertexAttribute, sizeof...(Members)> attr = attributes();
+			return VertexFormatCache::get(std::vector<VertexAttribute>(attr.begin(), attr.end()));
+		}
+
+		// Fill _count vertices from one stream per member (same order as the
+		// members).
+		static void pack(Vertex* _out, size_t _count, VertexStream<typename Members::Source>... _sources)
+		{
+			int expand[] = {0, (Members::pack(_out, sizeof(Vertex), _count, _sources), 0)...};
+			(void)expand;
+		}
+
+		// Convert _count vertices back into one dense array per member.
+		static void unpack(const Vertex* _in, size_t _count, typename Members::Source*... _outs)
+		{
+			int expand[] = {0, (Members::unpack(_in, sizeof(Vertex), _count, _outs), 0)...};
+			(void)expand;
+		}
+	};
+
+	// The VertexFormat of several vertex buffers (one layout each), e.g.
+	// separate position and attribute streams.
+	template<typename... Layouts>
+	std::shared_ptr<VertexFormat> makeVertexFormat()
+	{
+		static_assert(details::unique(Layouts::BINDING_INDEX...), "Two layouts use the same binding index.");
+		static_assert(details::disjoint(0, Layouts::ATTRIBUTE_MASK...), "Two layouts use the same attribute index.");
+		std::vector<VertexAttribute> attributes;
+		int expand[] = {0, (details::appendAttributes<Layouts>(attributes), 0)...};
+		(void)expand;
+		return VertexFormatCache::get(attributes);
+	}
+
+} // namespace gpupro
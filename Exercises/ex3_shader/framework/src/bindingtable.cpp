@@ -0,0 +1,71 @@
+#include "bindingtable.hpp"
+#include "texture.hpp"
+#include "pipeline.hpp"
+#include "buffer.hpp"
+#include <iostream>
+
+void gpupro::BindingTable::setTexture(GLuint _unit, Texture* _texture)
+{
+	if(_unit >= MAX_TEXTURES)
+	{
+		std::cerr << "ERR: Texture unit " << _unit << " is out of range for a binding table.\n";
+		return;
+	}
+	m_textures[_unit] = _texture ? _texture->glID() : 0;
+	if(m_textures[_unit])
+		m_textureMask |= 1ull << _unit;
+	else
+		m_textureMask &= ~(1ull << _unit);
+}
+
+void gpupro::BindingTable::setSampler(GLuint _unit, SamplerState* _sampler)
+{
+	if(_unit >= MAX_TEXTURES)
+	{
+		std::cerr << "ERR: Sampler unit " << _unit << " is out of range for a binding table.\n";
+		return;
+	}
+	m_samplers[_unit] = _sampler ? _sampler->glID() : 0;
+	if(m_samplers[_unit])
+		m_samplerMask |= 1ull << _unit;
+	else
+		m_samplerMask &= ~(1ull << _unit);
+}
+
+void gpupro::BindingTable::setUniformBuffer(GLuint _bindingIndex, Buffer* _buffer, GLintptr _offset, GLsizeiptr _size)
+{
+	setBuffer(m_uniformBuffers, _bindingIndex, _buffer, _offset, _size);
+}
+
+void gpupro::BindingTable::setShaderStorageBuffer(GLuint _bindingIndex, Buffer* _buffer, GLintptr _offset, GLsizeiptr _size)
+{
+	setBuffer(m_storageBuffers, _bindingIndex, _buffer, _offset, _size);
+}
+
+void gpupro::BindingTable::clear()
+{
+	*this = BindingTable();
+}
+
+void gpupro::BindingTable::setBuffer(BufferRanges& _ranges, GLuint _bindingIndex, Buffer* _buffer, GLintptr _offset, GLsizeiptr _size)
+{
+	if(_bindingIndex >= MAX_BUFFERS)
+	{
+		std::cerr << "ERR: Buffer binding " << _bindingIndex << " is out of range for a binding table.\n";
+		return;
+	}
+	if(_buffer)
+	{
+		if(_size == -1)
+			_size = _buffer->size() - _offset;
+		_ranges.ids[_bindingIndex] = _buffer->glID();
+		_ranges.offsets[_bindingIndex] = _offset;
+		_ranges.sizes[_bindingIndex] = _size;
+		_ranges.mask |= 1ull << _bindingIndex;
+	} else {
+		_ranges.ids[_bindingIndex] = 0;
+		_ranges.offsets[_bindingIndex] = 0;
+		_ranges.sizes[_bindingIndex] = 0;
+		_ranges.mask &= ~(1ull << _bindingIndex);
+	}
+}
@@ -1,22 +1,64 @@
 #include "buffer.hpp"
+#include "deletionqueue.hpp"
 #include <iostream>
+#include <algorithm>
+#include <cstring>
+
+void gpupro::IntervalSet::insert(GLintptr _begin, GLintptr _end)
+{
+	if(_begin >= _end) return;
+	// Find the first range which ends at or after the new begin. All ranges
+	// from there on which start at or before the new end are merged.
+	auto first = std::lower_bound(m_ranges.begin(), m_ranges.end(), _begin,
+		[](const Range& _r, GLintptr _x) { return _r.end < _x; });
+	auto last = first;
+	while(last != m_ranges.end() && last->begin <= _end)
+	{
+		_begin = std::min(_begin, last->begin);
+		_end = std::max(_end, last->end);
+		++last;
+	}
+	if(first == last)
+		m_ranges.insert(first, Range{_begin, _end});
+	else {
+		first->begin = _begin;
+		first->end = _end;
+		m_ranges.erase(first + 1, last);
+	}
+}
+
+GLintptr gpupro::IntervalSet::coveredSize() const
+{
+	GLintptr size = 0;
+	for(auto& r : m_ranges)
+		size += r.end - r.begin;
+	return size;
+}
 
 gpupro::Buffer::Buffer(Type _type, GLuint _elementSize, GLuint _numElements, Usage _usageBits, const GLvoid* _data) :
 	m_type(_type),
 	m_size(_elementSize * _numElements),
 	m_elementSize(_elementSize),
-	m_usage(_usageBits)
+	m_usage(_usageBits),
+	m_fullUpdateThreshold(0.5f)
 {
-	// Generated one buffer
-	glGenBuffers(1, &m_id);
-	// Allocate space
-	glBindBuffer(static_cast<GLenum>(m_type), m_id);
-	glBufferStorage(static_cast<GLenum>(m_type), m_size, _data, static_cast<GLbitfield>(_usageBits));
+	if(hasDSA())
+	{
+		// Create and allocate without touching any binding point
+		glCreateBuffers(1, &m_id);
+		glNamedBufferStorage(m_id, m_size, _data, static_cast<GLbitfield>(_usageBits));
+	} else {
+		// Generated one buffer
+		glGenBuffers(1, &m_id);
+		// Allocate space
+		glBindBuffer(static_cast<GLenum>(m_type), m_id);
+		glBufferStorage(static_cast<GLenum>(m_type), m_size, _data, static_cast<GLbitfield>(_usageBits));
+	}
 }
 
 gpupro::Buffer::~Buffer()
 {
-	glDeleteBuffers(1, &m_id);
+	DeletionQueue::release(DeletionQueue::ObjectType::BUFFER, m_id);
 }
 
 gpupro::Buffer::Buffer(Buffer&& _rhs) :
@@ -24,20 +66,28 @@ gpupro::Buffer::Buffer(Buffer&& _rhs) :
 	m_type(_rhs.m_type),
 	m_size(_rhs.m_size),
 	m_elementSize(_rhs.m_elementSize),
-	m_usage(_rhs.m_usage)
+	m_usage(_rhs.m_usage),
+	m_shadow(std::move(_rhs.m_shadow)),
+	m_dirtyRanges(std::move(_rhs.m_dirtyRanges)),
+	m_fullUpdateThreshold(_rhs.m_fullUpdateThreshold),
+	m_shadowStats(_rhs.m_shadowStats)
 {
 	_rhs.m_id = 0;
 }
 
 gpupro::Buffer& gpupro::Buffer::operator=(Buffer&& _rhs)
 {
-	glDeleteBuffers(1, &m_id);
+	DeletionQueue::release(DeletionQueue::ObjectType::BUFFER, m_id);
 
 	m_id = _rhs.m_id;
 	m_type = _rhs.m_type;
 	m_size = _rhs.m_size;
 	m_elementSize = _rhs.m_elementSize;
 	m_usage = _rhs.m_usage;
+	m_shadow = std::move(_rhs.m_shadow);
+	m_dirtyRanges = std::move(_rhs.m_dirtyRanges);
+	m_fullUpdateThreshold = _rhs.m_fullUpdateThreshold;
+	m_shadowStats = _rhs.m_shadowStats;
 	_rhs.m_id = 0;
 	return *this;
 }
@@ -59,6 +109,13 @@ void gpupro::Buffer::bindAsUniformBuffer(GLuint _bindingIndex, GLintptr _offset,
 	glBindBufferRange(GL_UNIFORM_BUFFER, _bindingIndex, m_id, _offset, _size);
 }
 
+void gpupro::Buffer::bindAsShaderStorageBuffer(GLuint _bindingIndex, GLintptr _offset, GLsizeiptr _size)
+{
+	if(_size == -1)
+		_size = m_size - _offset;
+	glBindBufferRange(GL_SHADER_STORAGE_BUFFER, _bindingIndex, m_id, _offset, _size);
+}
+
 void gpupro::Buffer::subDataUpdate(GLintptr _offset, GLsizei _size, const GLvoid* _data)
 {
 	if(!(m_usage & Usage::SUB_DATA_UPDATE)) {
@@ -69,14 +126,214 @@ void gpupro::Buffer::subDataUpdate(GLintptr _offset, GLsizei _size, const GLvoid
 	if(_size == -1)
 		_size = m_size - (GLsizei)_offset;
 
-	// Bind to arbitrary buffer point to call the storage command
-	glBindBuffer(static_cast<GLenum>(m_type), m_id);
-	glBufferSubData(static_cast<GLenum>(m_type), _offset, _size, _data);
+	if(hasDSA())
+		glNamedBufferSubData(m_id, _offset, _size, _data);
+	else {
+		// Bind to arbitrary buffer point to call the storage command
+		glBindBuffer(static_cast<GLenum>(m_type), m_id);
+		glBufferSubData(static_cast<GLenum>(m_type), _offset, _size, _data);
+	}
 }
 
 void gpupro::Buffer::clear()
 {
-	glBindBuffer(static_cast<GLenum>(m_type), m_id);
 	unsigned zero = 0;
-	glClearBufferData(static_cast<GLenum>(m_type), GL_R32UI, GL_RED, GL_UNSIGNED_INT, &zero);
+	if(hasDSA())
+		glClearNamedBufferData(m_id, GL_R32UI, GL_RED, GL_UNSIGNED_INT, &zero);
+	else {
+		glBindBuffer(static_cast<GLenum>(m_type), m_id);
+		glClearBufferData(static_cast<GLenum>(m_type), GL_R32UI, GL_RED, GL_UNSIGNED_INT, &zero);
+	}
+}
+
+void gpupro::Buffer::copyFrom(Buffer& _source, GLintptr _srcOffset, GLintptr _dstOffset, GLsizeiptr _size)
+{
+	if(hasDSA())
+		glCopyNamedBufferSubData(_source.m_id, m_id, _srcOffset, _dstOffset, _size);
+	else {
+		// The copy binding points exist to not disturb any other binding.
+		glBindBuffer(GL_COPY_READ_BUFFER, _source.m_id);
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+		glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, _srcOffset, _dstOffset, _size);
+	}
+}
+
+gpupro::Buffer::MappedRange gpupro::Buffer::map(MapAccess _access, GLintptr _offset, GLsizeiptr _size)
+{
+	if(_size == -1)
+		_size = m_size - _offset;
+	if(_offset < 0 || _size <= 0 || _offset + _size > m_size) {
+		std::cerr << "ERR: Buffer::map range out of bounds.\n";
+		return MappedRange();
+	}
+
+	// Validate the access against the flags from buffer creation.
+	if((_access & MapAccess::READ) && !(m_usage & Usage::MAP_READ)) {
+		std::cerr << "ERR: Buffer::map with READ access requires Usage::MAP_READ.\n";
+		return MappedRange();
+	}
+	if((_access & MapAccess::WRITE) && !(m_usage & Usage::MAP_WRITE)) {
+		std::cerr << "ERR: Buffer::map with WRITE access requires Usage::MAP_WRITE.\n";
+		return MappedRange();
+	}
+	if(!(_access & (MapAccess::READ | MapAccess::WRITE))) {
+		std::cerr << "ERR: Buffer::map requires at least one of READ or WRITE access.\n";
+		return MappedRange();
+	}
+	if((_access & MapAccess::PERSISTENT) && !(m_usage & Usage::MAP_PERSISTENT)) {
+		std::cerr << "ERR: Buffer::map with PERSISTENT access requires Usage::MAP_PERSISTENT.\n";
+		return MappedRange();
+	}
+	if((_access & MapAccess::COHERENT) && !(m_usage & Usage::MAP_COHERENT)) {
+		std::cerr << "ERR: Buffer::map with COHERENT access requires Usage::MAP_COHERENT.\n";
+		return MappedRange();
+	}
+	if((_access & (MapAccess::INVALIDATE_RANGE | MapAccess::INVALIDATE_BUFFER | MapAccess::UNSYNCHRONIZED)) && (_access & MapAccess::READ)) {
+		std::cerr << "ERR: Buffer::map cannot invalidate or skip synchronization for READ access.\n";
+		return MappedRange();
+	}
+	if((_access & MapAccess::EXPLICIT_FLUSH) && !(_access & MapAccess::WRITE)) {
+		std::cerr << "ERR: Buffer::map with EXPLICIT_FLUSH requires WRITE access.\n";
+		return MappedRange();
+	}
+
+	void* data;
+	if(hasDSA())
+		data = glMapNamedBufferRange(m_id, _offset, _size, static_cast<GLbitfield>(_access));
+	else {
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_id);
+		data = glMapBufferRange(GL_COPY_WRITE_BUFFER, _offset, _size, static_cast<GLbitfield>(_access));
+	}
+	if(!data) {
+		std::cerr << "ERR: Buffer::map failed.\n";
+		return MappedRange();
+	}
+	return MappedRange(m_id, data, _size, _access);
+}
+
+gpupro::Buffer::MappedRange::~MappedRange()
+{
+	unmap();
+}
+
+gpupro::Buffer::MappedRange::MappedRange(MappedRange&& _rhs) :
+	m_bufferID(_rhs.m_bufferID),
+	m_data(_rhs.m_data),
+	m_size(_rhs.m_size),
+	m_access(_rhs.m_access)
+{
+	_rhs.m_data = nullptr;
+}
+
+gpupro::Buffer::MappedRange& gpupro::Buffer::MappedRange::operator = (MappedRange&& _rhs)
+{
+	unmap();
+
+	m_bufferID = _rhs.m_bufferID;
+	m_data = _rhs.m_data;
+	m_size = _rhs.m_size;
+	m_access = _rhs.m_access;
+	_rhs.m_data = nullptr;
+	return *this;
+}
+
+void gpupro::Buffer::MappedRange::flush(GLintptr _offset, GLsizeiptr _size)
+{
+	if(!m_data) return;
+	if(!(m_access & MapAccess::EXPLICIT_FLUSH)) {
+		std::cerr << "ERR: MappedRange::flush requires MapAccess::EXPLICIT_FLUSH.\n";
+		return;
+	}
+	if(_size == -1)
+		_size = m_size - _offset;
+
+	if(hasDSA())
+		glFlushMappedNamedBufferRange(m_bufferID, _offset, _size);
+	else {
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_bufferID);
+		glFlushMappedBufferRange(GL_COPY_WRITE_BUFFER, _offset, _size);
+	}
+}
+
+void gpupro::Buffer::MappedRange::unmap()
+{
+	if(!m_data) return;
+
+	if(hasDSA())
+		glUnmapNamedBuffer(m_bufferID);
+	else {
+		glBindBuffer(GL_COPY_WRITE_BUFFER, m_bufferID);
+		glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+	}
+	m_data = nullptr;
+}
+
+void gpupro::Buffer::enableShadow(float _fullUpdateThreshold, const GLvoid* _initialData)
+{
+	if(!(m_usage & Usage::SUB_DATA_UPDATE)) {
+		std::cerr << "ERR: Buffer::enableShadow requires Usage::SUB_DATA_UPDATE. The current buffer is static.\n";
+		return;
+	}
+
+	m_shadow.resize(m_size);
+	if(_initialData)
+		memcpy(m_shadow.data(), _initialData, m_size);
+	else
+		std::fill(m_shadow.begin(), m_shadow.end(), 0);
+	m_dirtyRanges.clear();
+	m_fullUpdateThreshold = _fullUpdateThreshold;
+	m_shadowStats = ShadowStats();
+}
+
+void gpupro::Buffer::write(GLintptr _offset, GLsizei _size, const GLvoid* _data)
+{
+	if(!hasShadow()) {
+		std::cerr << "ERR: Buffer::write requires a shadow copy. Call enableShadow() first.\n";
+		return;
+	}
+	if(_offset < 0 || _size <= 0 || _offset + _size > m_size) {
+		std::cerr << "ERR: Buffer::write out of range.\n";
+		return;
+	}
+
+	memcpy(m_shadow.data() + _offset, _data, _size);
+	m_dirtyRanges.insert(_offset, _offset + _size);
+	m_shadowStats.numWrites++;
+	m_shadowStats.bytesWritten += _size;
+}
+
+void gpupro::Buffer::writeElement(GLuint _index, GLsizei _size, const GLvoid* _data)
+{
+	// A larger value would overwrite the next element.
+	if(static_cast<GLuint>(_size) > m_elementSize) {
+		std::cerr << "ERR: Buffer::write of " << _size << " bytes into elements of " << m_elementSize << " bytes.\n";
+		return;
+	}
+	if(_index >= numElements()) {
+		std::cerr << "ERR: Buffer::write of element " << _index << " out of range (" << numElements() << " elements).\n";
+		return;
+	}
+	write(static_cast<GLintptr>(_index) * m_elementSize, _size, _data);
+}
+
+void gpupro::Buffer::flushShadow()
+{
+	if(m_dirtyRanges.empty()) return;
+
+	// Many scattered ranges are more expensive than one large upload.
+	if(m_dirtyRanges.coveredSize() > m_fullUpdateThreshold * m_size)
+	{
+		subDataUpdate(0, m_size, m_shadow.data());
+		m_shadowStats.numUploads++;
+		m_shadowStats.bytesUploaded += m_size;
+	} else {
+		for(auto& r : m_dirtyRanges.ranges())
+		{
+			GLsizei size = static_cast<GLsizei>(r.end - r.begin);
+			subDataUpdate(r.begin, size, m_shadow.data() + r.begin);
+			m_shadowStats.numUploads++;
+			m_shadowStats.bytesUploaded += size;
+		}
+	}
+	m_dirtyRanges.clear();
 }
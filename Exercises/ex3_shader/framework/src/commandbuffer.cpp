@@ -0,0 +1,123 @@
+#include "commandbuffer.hpp"
+#include "buffer.hpp"
+#include <cstring>
+#include <iostream>
+
+gpupro::CommandBuffer::CommandBuffer()
+{
+}
+
+gpupro::CommandBuffer::~CommandBuffer()
+{
+}
+
+gpupro::CommandBuffer::CommandBuffer(CommandBuffer&& _rhs) :
+	m_commands(std::move(_rhs.m_commands)),
+	m_uniformData(std::move(_rhs.m_uniformData)),
+	m_uniformBuffer(std::move(_rhs.m_uniformBuffer))
+{
+}
+
+gpupro::CommandBuffer& gpupro::CommandBuffer::operator = (CommandBuffer&& _rhs)
+{
+	m_commands = std::move(_rhs.m_commands);
+	m_uniformData = std::move(_rhs.m_uniformData);
+	m_uniformBuffer = std::move(_rhs.m_uniformBuffer);
+	return *this;
+}
+
+template<typename T>
+void gpupro::CommandBuffer::push(CommandType _type, const T& _args)
+{
+	const size_t numWords = (sizeof(T) + sizeof(GLuint64) - 1) / sizeof(GLuint64);
+	const size_t pos = m_commands.size();
+	m_commands.resize(pos + 1 + numWords, 0);
+	// Header: type in the lower half, argument size in words in the upper half.
+	m_commands[pos] = static_cast<GLuint64>(_type) | (static_cast<GLuint64>(numWords) << 32);
+	memcpy(&m_commands[pos + 1], &_args, sizeof(T));
+}
+
+void gpupro::CommandBuffer::setState(const CompiledPipeline& _pipeline)
+{
+	push(CommandType::SET_STATE, &_pipeline);
+}
+
+void gpupro::CommandBuffer::setBindings(const BindingTable& _table)
+{
+	push(CommandType::SET_BINDINGS, &_table);
+}
+
+void gpupro::CommandBuffer::bindVertexBuffer(GLuint _bindingIndex, Buffer& _buffer, GLuint _offset)
+{
+	BindVertexBufferCmd cmd;
+	cmd.bindingIndex = _bindingIndex;
+	cmd.buffer = _buffer.glID();
+	cmd.offset = static_cast<GLintptr>(_offset) * _buffer.elementSize();
+	cmd.stride = _buffer.elementSize();
+	push(CommandType::BIND_VERTEX_BUFFER, cmd);
+}
+
+void gpupro::CommandBuffer::bindIndexBuffer(Buffer& _buffer)
+{
+	BindIndexBufferCmd cmd;
+	cmd.buffer = _buffer.glID();
+	cmd.indexSize = _buffer.elementSize();
+	switch(cmd.indexSize)
+	{
+	case 1: cmd.indexType = GL_UNSIGNED_BYTE; break;
+	case 2: cmd.indexType = GL_UNSIGNED_SHORT; break;
+	case 4: cmd.indexType = GL_UNSIGNED_INT; break;
+	default:
+		std::cerr << "ERR: Index buffers must have an element size of 1, 2 or 4 bytes.\n";
+		return;
+	}
+	push(CommandType::BIND_INDEX_BUFFER, cmd);
+}
+
+void gpupro::CommandBuffer::setUniforms(GLuint _bindingIndex, const void* _data, GLsizeiptr _size)
+{
+	SetUniformsCmd cmd;
+	cmd.bindingIndex = _bindingIndex;
+	cmd.offset = (static_cast<GLsizeiptr>(m_uniformData.size()) + UNIFORM_ALIGNMENT - 1) / UNIFORM_ALIGNMENT * UNIFORM_ALIGNMENT;
+	cmd.size = _size;
+	m_uniformData.resize(cmd.offset + _size);
+	memcpy(m_uniformData.data() + cmd.offset, _data, _size);
+	push(CommandType::SET_UNIFORMS, cmd);
+}
+
+void gpupro::CommandBuffer::drawIndexed(Model::DrawPrimitiveType _primType, GLuint _indexCount, GLuint _firstIndex,
+	GLint _baseVertex, GLuint _instanceCount, GLuint _baseInstance)
+{
+	DrawIndexedCmd cmd;
+	cmd.primType = static_cast<GLenum>(_primType);
+	cmd.indexCount = _indexCount;
+	cmd.firstIndex = _firstIndex;
+	cmd.baseVertex = _baseVertex;
+	cmd.instanceCount = _instanceCount;
+	cmd.baseInstance = _baseInstance;
+	push(CommandType::DRAW_INDEXED, cmd);
+}
+
+void gpupro::CommandBuffer::draw(Model::DrawPrimitiveType _primType, GLuint _vertexCount, GLuint _firstVertex,
+	GLuint _instanceCount, GLuint _baseInstance)
+{
+	DrawCmd cmd;
+	cmd.primType = static_cast<GLenum>(_primType);
+	cmd.vertexCount = _vertexCount;
+	cmd.firstVertex = _firstVertex;
+	cmd.instanceCount = _instanceCount;
+	cmd.baseInstance = _baseInstance;
+	push(CommandType::DRAW, cmd);
+}
+
+void gpupro::CommandBuffer::reset()
+{
+	m_commands.clear();
+	m_uniformData.clear();
+}
+
+void gpupro::CommandQueue::submit(CommandBuffer& _commands)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_submitted.push_back(&_commands);
+}
@@ -1,7 +1,19 @@
 #include "context.hpp"
+#include "deletionqueue.hpp"
+#include "nullgl.hpp"
+#include "gltrace.hpp"
+#include "gpuprofiler.hpp"
+#include "pipelinestatistics.hpp"
+#include "timeline.hpp"
+#include "buffer.hpp"
 #include "gl.hpp"
 #include <iostream>
 #include <string>
+#include <cstring>
+#include <algorithm>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
 
 static void glDebugOutput(GLenum _source, GLenum _type, GLuint _id, GLenum _severity, GLsizei _length, const GLchar* _message, const void* _userParam)
 {
@@ -51,9 +63,12 @@ static void glDebugOutput(GLenum _source, GLenum _type, GLuint _id, GLenum _seve
 		std::cerr << "WAR: " << logMessage.c_str() << '\n';
 }
 
-gpupro::OGLContext::OGLContext(DebugSeverity _dbgLevel)
+gpupro::OGLContext::OGLContext(DebugSeverity _dbgLevel, Backend _backend)
 {
-	if(!gladLoadGL())
+	CPU_ZONE("OGLContext");
+	if(_backend == Backend::NULL_RECORDING)
+		NullGL::load();
+	else if(!gladLoadGL())
 		throw std::exception("Cannot initialize Glad/load gl-function pointers!\n");
 	std::cerr << "INF: Loaded GL-context is version " << GLVersion.major << '.' << GLVersion.minor << '\n';
 
@@ -69,210 +84,520 @@ gpupro::OGLContext::OGLContext(DebugSeverity _dbgLevel)
 	// Enable seamless cube map sampling which is always a good idea since
 	// it is core (3.2).
 	glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+
+	// Let the driver compile with as many threads as it likes (0xffffffff
+	// means implementation defined maximum).
+	if(GLAD_GL_KHR_parallel_shader_compile)
+		glMaxShaderCompilerThreadsKHR(0xffffffff);
+	else if(GLAD_GL_ARB_parallel_shader_compile)
+		glMaxShaderCompilerThreadsARB(0xffffffff);
+
+	// The default pipeline matches the initial OpenGL state. Program and
+	// vertex array are unknown and will be set on first use.
+	CompiledPipeline defaultState((Pipeline()));
+	for(int i = 0; i < CompiledPipeline::NUM_SLOTS; ++i)
+		m_currentState.keys[i] = defaultState.m_keys[i];
+	m_currentState.keys[CompiledPipeline::PROGRAM] = ~0ull;
+	m_currentState.keys[CompiledPipeline::VERTEX_ARRAY] = ~0ull;
+	for(int i = 0; i < static_cast<int>(DeletionQueue::ObjectType::NUM_TYPES); ++i)
+		m_deletionGenerations[i] = DeletionQueue::generation(static_cast<DeletionQueue::ObjectType>(i));
+
+	auto supportedSlots = [](GLenum _limit) {
+		GLint numBindings = 0;
+		glGetIntegerv(_limit, &numBindings);
+		numBindings = std::min(numBindings, static_cast<GLint>(BindingTable::MAX_BUFFERS));
+		return (1ull << numBindings) - 1;
+	};
+	m_uniformBufferSlots = supportedSlots(GL_MAX_UNIFORM_BUFFER_BINDINGS);
+	m_storageBufferSlots = supportedSlots(GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS);
+
+	m_emptyVertexFormat = VertexFormatCache::get(std::vector<VertexAttribute>());
+
+	// Pipelines with separable programs change the stages of this object.
+	// It stays bound, but is only used while program 0 is in use. Its
+	// stages are empty initially, which matches the default keys.
+	glGenProgramPipelines(1, &m_programPipeline);
+	glBindProgramPipeline(m_programPipeline);
 }
 
-void gpupro::OGLContext::setState(Pipeline& _pipeline)
+gpupro::OGLContext::~OGLContext()
 {
-	// ***** Rasterizer state *************************************************
-	if(m_currentState.rasterizer.cullMode != _pipeline.rasterizer.cullMode)
-	{
-		if(_pipeline.rasterizer.cullMode == RasterizerState::CullMode::NONE)
-			glDisable(GL_CULL_FACE);
-		else {
-			glEnable(GL_CULL_FACE);
-			glCullFace(static_cast<GLenum>(_pipeline.rasterizer.cullMode));
-		}
-		m_currentState.rasterizer.cullMode = _pipeline.rasterizer.cullMode;
-	}
-	if(m_currentState.rasterizer.frontFaceWinding != _pipeline.rasterizer.frontFaceWinding)
-	{
-		glFrontFace(static_cast<GLenum>(_pipeline.rasterizer.frontFaceWinding));
-		m_currentState.rasterizer.frontFaceWinding = _pipeline.rasterizer.frontFaceWinding;
-	}
-	if(m_currentState.rasterizer.fillMode != _pipeline.rasterizer.fillMode)
-	{
-		glPolygonMode(GL_FRONT_AND_BACK, static_cast<GLenum>(_pipeline.rasterizer.fillMode));
-		m_currentState.rasterizer.fillMode = _pipeline.rasterizer.fillMode;
-	}
-	if(m_currentState.rasterizer.lineWidth != _pipeline.rasterizer.lineWidth)
-	{
-		glLineWidth(_pipeline.rasterizer.lineWidth);
-		m_currentState.rasterizer.lineWidth = _pipeline.rasterizer.lineWidth;
-	}
-	if(m_currentState.rasterizer.discard != _pipeline.rasterizer.discard)
-	{
-		if(_pipeline.rasterizer.discard)
-			glEnable(GL_RASTERIZER_DISCARD);
-		else
-			glDisable(GL_RASTERIZER_DISCARD);
-		m_currentState.rasterizer.discard = _pipeline.rasterizer.discard;
-	}
-	if(m_currentState.rasterizer.colorWrite != _pipeline.rasterizer.colorWrite)
-	{
-		glColorMask(_pipeline.rasterizer.colorWrite, _pipeline.rasterizer.colorWrite, _pipeline.rasterizer.colorWrite, _pipeline.rasterizer.colorWrite);
-		m_currentState.rasterizer.colorWrite = _pipeline.rasterizer.colorWrite;
-	}
-	if(m_currentState.rasterizer.dithering != _pipeline.rasterizer.dithering)
-	{
-		if(_pipeline.rasterizer.dithering)
-			glEnable(GL_DITHER);
-		else
-			glDisable(GL_DITHER);
-		m_currentState.rasterizer.dithering = _pipeline.rasterizer.dithering;
-	}
+	// The profilers' queries belong to this context.
+	GpuProfiler::setEnabled(false);
+	PipelineStatistics::setEnabled(false);
+	DeletionQueue::flush();
+	glDeleteProgramPipelines(1, &m_programPipeline);
+}
 
-	// ***** Depth-stencil state **********************************************
-	if(m_currentState.depthStencil.depthTest != _pipeline.depthStencil.depthTest)
+void gpupro::OGLContext::endFrame()
+{
+	Timeline::endFrame();
+	GpuProfiler::endFrame();
+	PipelineStatistics::endFrame();
+	DeletionQueue::endFrame();
+	GLTrace::markFrame();
+}
+
+// Index of the lowest set bit. _mask must not be 0.
+static int lowestBit(GLuint64 _mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	// _BitScanForward64 is not available on 32 bit targets.
+	if(_BitScanForward(&index, static_cast<unsigned long>(_mask)))
+		return static_cast<int>(index);
+	_BitScanForward(&index, static_cast<unsigned long>(_mask >> 32));
+	return static_cast<int>(index) + 32;
+#else
+	return __builtin_ctzll(_mask);
+#endif
+}
+
+// Call _func(first, count) for each range of consecutive set bits.
+template<typename Func>
+static void forEachRange(GLuint64 _mask, Func _func)
+{
+	while(_mask)
 	{
-		if(_pipeline.depthStencil.depthTest)
-			glEnable(GL_DEPTH_TEST);
-		else
-			glDisable(GL_DEPTH_TEST);
-		m_currentState.depthStencil.depthTest = _pipeline.depthStencil.depthTest;
+		const int first = lowestBit(_mask);
+		const GLuint64 gaps = ~(_mask >> first);
+		const int count = gaps ? lowestBit(gaps) : 64;
+		_func(first, count);
+		_mask = (first + count >= 64) ? 0 : _mask & (~0ull << (first + count));
 	}
-	if(m_currentState.depthStencil.depthTest &&
-		m_currentState.depthStencil.depthCmpFunc != _pipeline.depthStencil.depthCmpFunc)
+}
+
+// Copy the names of all _candidates slots into _current and return a mask
+// of the slots which changed.
+static GLuint64 updateNames(GLuint* _current, const GLuint* _new, GLuint64 _candidates)
+{
+	GLuint64 changed = 0;
+	while(_candidates)
 	{
-		glDepthFunc(static_cast<GLenum>(_pipeline.depthStencil.depthCmpFunc));
-		m_currentState.depthStencil.depthCmpFunc = _pipeline.depthStencil.depthCmpFunc;
+		const int i = lowestBit(_candidates);
+		_candidates &= _candidates - 1;
+		if(_current[i] != _new[i])
+		{
+			_current[i] = _new[i];
+			changed |= 1ull << i;
+		}
 	}
-	if(m_currentState.depthStencil.depthWrite != _pipeline.depthStencil.depthWrite)
+	return changed;
+}
+
+void gpupro::OGLContext::setState(const CompiledPipeline& _pipeline)
+{
+	checkDeletedObjects();
+
+	// Find all calls which change something
+	GLuint64 dirty = 0;
+	for(int i = 0; i < CompiledPipeline::NUM_SLOTS; ++i)
+		dirty |= static_cast<GLuint64>(m_currentState.keys[i] != _pipeline.m_keys[i]) << i;
+	dirty &= ~_pipeline.m_ignoreMask;
+
+	while(dirty)
 	{
-		glDepthMask(_pipeline.depthStencil.depthWrite);
-		m_currentState.depthStencil.depthWrite = _pipeline.depthStencil.depthWrite;
+		const int slot = lowestBit(dirty);
+		dirty &= dirty - 1;
+		const GLuint64 key = _pipeline.m_keys[slot];
+		m_currentState.keys[slot] = key;
+		switch(slot)
+		{
+		// ***** Rasterizer state *************************************************
+		case CompiledPipeline::CULL_MODE:
+			if(key == GL_NONE)
+				glDisable(GL_CULL_FACE);
+			else {
+				glEnable(GL_CULL_FACE);
+				glCullFace(static_cast<GLenum>(key));
+			}
+			break;
+		case CompiledPipeline::FRONT_FACE:
+			glFrontFace(static_cast<GLenum>(key));
+			break;
+		case CompiledPipeline::POLYGON_MODE:
+			glPolygonMode(GL_FRONT_AND_BACK, static_cast<GLenum>(key));
+			break;
+		case CompiledPipeline::LINE_WIDTH: {
+			GLuint bits = static_cast<GLuint>(key);
+			float lineWidth;
+			memcpy(&lineWidth, &bits, sizeof(float));
+			glLineWidth(lineWidth);
+		} break;
+		case CompiledPipeline::RASTERIZER_DISCARD:
+			if(key) glEnable(GL_RASTERIZER_DISCARD);
+			else glDisable(GL_RASTERIZER_DISCARD);
+			break;
+		case CompiledPipeline::COLOR_MASK: {
+			GLboolean mask = key ? GL_TRUE : GL_FALSE;
+			glColorMask(mask, mask, mask, mask);
+		} break;
+		case CompiledPipeline::DITHER:
+			if(key) glEnable(GL_DITHER);
+			else glDisable(GL_DITHER);
+			break;
+
+		// ***** Depth-stencil state **********************************************
+		case CompiledPipeline::DEPTH_TEST:
+			if(key) glEnable(GL_DEPTH_TEST);
+			else glDisable(GL_DEPTH_TEST);
+			break;
+		case CompiledPipeline::DEPTH_FUNC:
+			glDepthFunc(static_cast<GLenum>(key));
+			break;
+		case CompiledPipeline::DEPTH_MASK:
+			glDepthMask(key ? GL_TRUE : GL_FALSE);
+			break;
+		case CompiledPipeline::STENCIL_TEST:
+			if(key) glEnable(GL_STENCIL_TEST);
+			else glDisable(GL_STENCIL_TEST);
+			break;
+		case CompiledPipeline::STENCIL_FUNC_FRONT:
+		case CompiledPipeline::STENCIL_FUNC_BACK:
+			glStencilFuncSeparate(slot == CompiledPipeline::STENCIL_FUNC_FRONT ? GL_FRONT : GL_BACK,
+				static_cast<GLenum>(key & 0xffff), static_cast<GLint>(key >> 32), 0xffffffff);
+			break;
+		case CompiledPipeline::STENCIL_OP_FRONT:
+		case CompiledPipeline::STENCIL_OP_BACK:
+			glStencilOpSeparate(slot == CompiledPipeline::STENCIL_OP_FRONT ? GL_FRONT : GL_BACK,
+				static_cast<GLenum>(key & 0xffff), static_cast<GLenum>((key >> 16) & 0xffff), static_cast<GLenum>((key >> 32) & 0xffff));
+			break;
+
+		// ***** Blend state ******************************************************
+		case CompiledPipeline::BLEND_MODE:
+			if(key == static_cast<GLuint64>(BlendState::BlendMode::BLEND)) {
+				glEnable(GL_BLEND);
+				glDisable(GL_COLOR_LOGIC_OP);
+			} else if(key == static_cast<GLuint64>(BlendState::BlendMode::LOGIC))
+				glEnable(GL_COLOR_LOGIC_OP);
+			else {
+				glDisable(GL_BLEND);
+				glDisable(GL_COLOR_LOGIC_OP);
+			}
+			break;
+		case CompiledPipeline::LOGIC_OP:
+			glLogicOp(static_cast<GLenum>(key));
+			break;
+		case CompiledPipeline::ALPHA_TO_COVERAGE:
+			if(key) glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+			else glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+			break;
+
+		// ***** Shader program and vertex format *********************************
+		case CompiledPipeline::PROGRAM:
+			glUseProgram(static_cast<GLuint>(key));
+			break;
+		case CompiledPipeline::VERTEX_ARRAY:
+			glBindVertexArray(key ? static_cast<GLuint>(key) : m_emptyVertexFormat->glID());
+			break;
+		case CompiledPipeline::STAGE_PROGRAM0 + ProgramPipeline::VERTEX:
+			glUseProgramStages(m_programPipeline, GL_VERTEX_SHADER_BIT, static_cast<GLuint>(key));
+			break;
+		case CompiledPipeline::STAGE_PROGRAM0 + ProgramPipeline::TESS_CONTROL:
+			glUseProgramStages(m_programPipeline, GL_TESS_CONTROL_SHADER_BIT, static_cast<GLuint>(key));
+			break;
+		case CompiledPipeline::STAGE_PROGRAM0 + ProgramPipeline::TESS_EVALUATION:
+			glUseProgramStages(m_programPipeline, GL_TESS_EVALUATION_SHADER_BIT, static_cast<GLuint>(key));
+			break;
+		case CompiledPipeline::STAGE_PROGRAM0 + ProgramPipeline::GEOMETRY:
+			glUseProgramStages(m_programPipeline, GL_GEOMETRY_SHADER_BIT, static_cast<GLuint>(key));
+			break;
+		case CompiledPipeline::STAGE_PROGRAM0 + ProgramPipeline::FRAGMENT:
+			glUseProgramStages(m_programPipeline, GL_FRAGMENT_SHADER_BIT, static_cast<GLuint>(key));
+			break;
+
+		default:
+			if(slot >= CompiledPipeline::BLEND_FUNC0)
+			{
+				GLuint i = slot - CompiledPipeline::BLEND_FUNC0;
+				glBlendFuncSeparatei(i,
+					static_cast<GLenum>(key & 0xffff), static_cast<GLenum>((key >> 16) & 0xffff),
+					static_cast<GLenum>((key >> 32) & 0xffff), static_cast<GLenum>(key >> 48));
+			} else {
+				GLuint i = slot - CompiledPipeline::BLEND_EQUATION0;
+				glBlendEquationSeparatei(i, static_cast<GLenum>(key & 0xffff), static_cast<GLenum>(key >> 16));
+			}
+		}
 	}
-	if(m_currentState.depthStencil.stencilTest != _pipeline.depthStencil.stencilTest)
+
+	// ***** Sampler states and resources *************************************
+	setSamplers(_pipeline.m_samplers, _pipeline.m_samplerMask, _pipeline.m_bindings);
+	if(_pipeline.m_bindings)
+		setBindings(*_pipeline.m_bindings);
+}
+
+void gpupro::OGLContext::setState(Pipeline& _pipeline)
+{
+	setState(CompiledPipeline(_pipeline));
+}
+
+void gpupro::OGLContext::setState(ComputePipeline & _pipeline)
+{
+	checkDeletedObjects();
+
+	// ***** Sampler states ***************************************************
+	GLuint samplers[64];
+	GLuint64 mask = 0;
+	for(int i = 0; i < 64; ++i)
 	{
-		if(_pipeline.depthStencil.stencilTest)
-			glEnable(GL_STENCIL_TEST);
-		else
-			glDisable(GL_STENCIL_TEST);
-		m_currentState.depthStencil.stencilTest = _pipeline.depthStencil.stencilTest;
+		samplers[i] = _pipeline.samplerState[i] ? _pipeline.samplerState[i]->glID() : 0;
+		if(samplers[i])
+			mask |= 1ull << i;
 	}
-	if(m_currentState.depthStencil.stencilTest)
+	setSamplers(samplers, mask, _pipeline.bindings);
+
+	if(_pipeline.bindings)
+		setBindings(*_pipeline.bindings);
+
+	// ***** Shader program ***************************************************
+	if(_pipeline.shader) setProgram(_pipeline.shader->glID());
+}
+
+void gpupro::OGLContext::prepareClear(GLbitfield _buffers)
+{
+	auto change = [this](int _slot, GLuint64 _key) {
+		if(m_currentState.keys[_slot] == _key)
+			return false;
+		m_currentState.keys[_slot] = _key;
+		return true;
+	};
+	if(change(CompiledPipeline::RASTERIZER_DISCARD, 0))
+		glDisable(GL_RASTERIZER_DISCARD);
+	if((_buffers & GL_COLOR_BUFFER_BIT) && change(CompiledPipeline::COLOR_MASK, 1))
+		glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+	if((_buffers & GL_DEPTH_BUFFER_BIT) && change(CompiledPipeline::DEPTH_MASK, 1))
+		glDepthMask(GL_TRUE);
+	// The stencil write mask and the scissor test are never changed by
+	// the pipelines and keep their defaults.
+}
+
+void gpupro::OGLContext::setBindings(const BindingTable& _table)
+{
+	checkDeletedObjects();
+	BindingTable& cur = m_currentBindings;
+
+	// Samplers of the table override those of the pipeline.
+	GLuint64 changed = updateNames(cur.m_samplers, _table.m_samplers, _table.m_samplerMask);
+	cur.m_samplerMask |= _table.m_samplerMask;
+	forEachRange(changed, [&cur](int _first, int _count) {
+		glBindSamplers(_first, _count, cur.m_samplers + _first);
+	});
+
+	changed = updateNames(cur.m_textures, _table.m_textures, cur.m_textureMask | _table.m_textureMask);
+	cur.m_textureMask = _table.m_textureMask;
+	forEachRange(changed, [&cur](int _first, int _count) {
+		glBindTextures(_first, _count, cur.m_textures + _first);
+	});
+
+	setBuffers(GL_UNIFORM_BUFFER, m_uniformBufferSlots, cur.m_uniformBuffers, _table.m_uniformBuffers);
+	setBuffers(GL_SHADER_STORAGE_BUFFER, m_storageBufferSlots, cur.m_storageBuffers, _table.m_storageBuffers);
+}
+
+void gpupro::OGLContext::execute(CommandBuffer& _commands)
+{
+	// Upload the uniform slices of all commands at once.
+	GLuint uniformBuffer = 0;
+	if(!_commands.m_uniformData.empty())
 	{
-		if(m_currentState.depthStencil.stencilCmpFuncFront != _pipeline.depthStencil.stencilCmpFuncFront
-			|| m_currentState.depthStencil.stencilRefFront != _pipeline.depthStencil.stencilRefFront)
+		GLsizei dataSize = static_cast<GLsizei>(_commands.m_uniformData.size());
+		if(!_commands.m_uniformBuffer || _commands.m_uniformBuffer->size() < dataSize)
 		{
-			glStencilFuncSeparate(GL_FRONT, static_cast<GLenum>(_pipeline.depthStencil.stencilCmpFuncFront), _pipeline.depthStencil.stencilRefFront, 0xffffffff);
-			m_currentState.depthStencil.stencilCmpFuncFront = _pipeline.depthStencil.stencilCmpFuncFront;
-			m_currentState.depthStencil.stencilRefFront = _pipeline.depthStencil.stencilRefFront;
-		}
-		if(m_currentState.depthStencil.stencilCmpFuncBack != _pipeline.depthStencil.stencilCmpFuncBack
-			|| m_currentState.depthStencil.stencilRefBack != _pipeline.depthStencil.stencilRefBack)
-		{
-			glStencilFuncSeparate(GL_BACK, static_cast<GLenum>(_pipeline.depthStencil.stencilCmpFuncBack), _pipeline.depthStencil.stencilRefBack, 0xffffffff);
-			m_currentState.depthStencil.stencilCmpFuncBack = _pipeline.depthStencil.stencilCmpFuncBack;
-			m_currentState.depthStencil.stencilRefBack = _pipeline.depthStencil.stencilRefBack;
-		}
-		if(m_currentState.depthStencil.stencilFailOpFront != _pipeline.depthStencil.stencilFailOpFront
-			|| m_currentState.depthStencil.zfailOpFront != _pipeline.depthStencil.zfailOpFront
-			|| m_currentState.depthStencil.passOpFront != _pipeline.depthStencil.passOpFront)
-		{
-			glStencilOpSeparate(GL_FRONT, static_cast<GLenum>(_pipeline.depthStencil.stencilFailOpFront),
-				static_cast<GLenum>(_pipeline.depthStencil.zfailOpFront),
-				static_cast<GLenum>(_pipeline.depthStencil.passOpFront));
-			m_currentState.depthStencil.stencilFailOpFront = _pipeline.depthStencil.stencilFailOpFront;
-			m_currentState.depthStencil.zfailOpFront = _pipeline.depthStencil.zfailOpFront;
-			m_currentState.depthStencil.passOpFront = _pipeline.depthStencil.passOpFront;
-		}
-		if(m_currentState.depthStencil.stencilFailOpBack != _pipeline.depthStencil.stencilFailOpBack
-			|| m_currentState.depthStencil.zfailOpBack != _pipeline.depthStencil.zfailOpBack
-			|| m_currentState.depthStencil.passOpBack != _pipeline.depthStencil.passOpBack)
-		{
-			glStencilOpSeparate(GL_BACK, static_cast<GLenum>(_pipeline.depthStencil.stencilFailOpBack),
-				static_cast<GLenum>(_pipeline.depthStencil.zfailOpBack),
-				static_cast<GLenum>(_pipeline.depthStencil.passOpBack));
-			m_currentState.depthStencil.stencilFailOpBack = _pipeline.depthStencil.stencilFailOpBack;
-			m_currentState.depthStencil.zfailOpBack = _pipeline.depthStencil.zfailOpBack;
-			m_currentState.depthStencil.passOpBack = _pipeline.depthStencil.passOpBack;
+			GLsizei capacity = std::max(dataSize, _commands.m_uniformBuffer ? _commands.m_uniformBuffer->size() * 2 : 0);
+			_commands.m_uniformBuffer.reset(new Buffer(Buffer::Type::UNIFORM, 1, capacity, Buffer::Usage::SUB_DATA_UPDATE));
 		}
+		_commands.m_uniformBuffer->subDataUpdate(0, dataSize, _commands.m_uniformData.data());
+		uniformBuffer = _commands.m_uniformBuffer->glID();
 	}
 
-	// ***** Blend state ******************************************************
-	if(m_currentState.blendState.enableBlending != _pipeline.blendState.enableBlending)
+	GLenum indexType = GL_UNSIGNED_INT;
+	GLuint indexSize = 4;
+	const GLuint64* cmd = _commands.m_commands.data();
+	const GLuint64* end = cmd + _commands.m_commands.size();
+	while(cmd < end)
 	{
-		if(_pipeline.blendState.enableBlending == BlendState::BlendMode::BLEND) {
-			glEnable(GL_BLEND);
-			glDisable(GL_COLOR_LOGIC_OP);
-		} else if(_pipeline.blendState.enableBlending == BlendState::BlendMode::LOGIC)
-			glEnable(GL_COLOR_LOGIC_OP);
-		else {
-			glDisable(GL_BLEND);
-			glDisable(GL_COLOR_LOGIC_OP);
-		}
-		m_currentState.blendState.enableBlending = _pipeline.blendState.enableBlending;
-	}
-	if(m_currentState.blendState.enableBlending == BlendState::BlendMode::BLEND)
-	{
-		for(int i = 0; i < 8; ++i)
+		const auto type = static_cast<CommandBuffer::CommandType>(*cmd & 0xffffffff);
+		const size_t numWords = static_cast<size_t>(*cmd >> 32);
+		const void* args = cmd + 1;
+		switch(type)
 		{
-			if(m_currentState.blendState.buf[i].colorBlendOp != _pipeline.blendState.buf[i].colorBlendOp
-				|| m_currentState.blendState.buf[i].alphaBlendOp != _pipeline.blendState.buf[i].alphaBlendOp)
-			{
-				glBlendEquationSeparatei(i, static_cast<GLenum>(_pipeline.blendState.buf[i].colorBlendOp), static_cast<GLenum>(_pipeline.blendState.buf[i].alphaBlendOp));
-				m_currentState.blendState.buf[i].colorBlendOp = _pipeline.blendState.buf[i].colorBlendOp;
-				m_currentState.blendState.buf[i].alphaBlendOp = _pipeline.blendState.buf[i].alphaBlendOp;
-			}
-			if(m_currentState.blendState.buf[i].srcColorFactor != _pipeline.blendState.buf[i].srcColorFactor
-				|| m_currentState.blendState.buf[i].srcAlphaFactor != _pipeline.blendState.buf[i].srcAlphaFactor
-				|| m_currentState.blendState.buf[i].dstColorFactor != _pipeline.blendState.buf[i].dstColorFactor
-				|| m_currentState.blendState.buf[i].dstAlphaFactor != _pipeline.blendState.buf[i].dstAlphaFactor)
+		case CommandBuffer::CommandType::SET_STATE: {
+			const CompiledPipeline* pipeline;
+			memcpy(&pipeline, args, sizeof(pipeline));
+			setState(*pipeline);
+		} break;
+		case CommandBuffer::CommandType::SET_BINDINGS: {
+			const BindingTable* table;
+			memcpy(&table, args, sizeof(table));
+			setBindings(*table);
+		} break;
+		case CommandBuffer::CommandType::BIND_VERTEX_BUFFER: {
+			CommandBuffer::BindVertexBufferCmd c;
+			memcpy(&c, args, sizeof(c));
+			glBindVertexBuffer(c.bindingIndex, c.buffer, c.offset, c.stride);
+		} break;
+		case CommandBuffer::CommandType::BIND_INDEX_BUFFER: {
+			CommandBuffer::BindIndexBufferCmd c;
+			memcpy(&c, args, sizeof(c));
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, c.buffer);
+			indexType = c.indexType;
+			indexSize = c.indexSize;
+		} break;
+		case CommandBuffer::CommandType::SET_UNIFORMS: {
+			CommandBuffer::SetUniformsCmd c;
+			memcpy(&c, args, sizeof(c));
+			glBindBufferRange(GL_UNIFORM_BUFFER, c.bindingIndex, uniformBuffer, c.offset, c.size);
+			// Keep the cached bindings of setBindings() valid.
+			if(c.bindingIndex < BindingTable::MAX_BUFFERS)
 			{
-				glBlendFuncSeparatei(i,
-					static_cast<GLenum>(_pipeline.blendState.buf[i].srcColorFactor), static_cast<GLenum>(_pipeline.blendState.buf[i].dstColorFactor),
-					static_cast<GLenum>(_pipeline.blendState.buf[i].srcAlphaFactor), static_cast<GLenum>(_pipeline.blendState.buf[i].dstAlphaFactor));
-				m_currentState.blendState.buf[i].srcColorFactor = _pipeline.blendState.buf[i].srcColorFactor;
-				m_currentState.blendState.buf[i].srcAlphaFactor = _pipeline.blendState.buf[i].srcAlphaFactor;
-				m_currentState.blendState.buf[i].dstColorFactor = _pipeline.blendState.buf[i].dstColorFactor;
-				m_currentState.blendState.buf[i].dstAlphaFactor = _pipeline.blendState.buf[i].dstAlphaFactor;
+				BindingTable::BufferRanges& ubos = m_currentBindings.m_uniformBuffers;
+				ubos.ids[c.bindingIndex] = uniformBuffer;
+				ubos.offsets[c.bindingIndex] = c.offset;
+				ubos.sizes[c.bindingIndex] = c.size;
+				ubos.mask |= 1ull << c.bindingIndex;
 			}
+		} break;
+		case CommandBuffer::CommandType::DRAW_INDEXED: {
+			CommandBuffer::DrawIndexedCmd c;
+			memcpy(&c, args, sizeof(c));
+			glDrawElementsInstancedBaseVertexBaseInstance(c.primType, c.indexCount, indexType,
+				reinterpret_cast<const void*>(static_cast<size_t>(c.firstIndex) * indexSize),
+				c.instanceCount, c.baseVertex, c.baseInstance);
+		} break;
+		case CommandBuffer::CommandType::DRAW: {
+			CommandBuffer::DrawCmd c;
+			memcpy(&c, args, sizeof(c));
+			glDrawArraysInstancedBaseInstance(c.primType, c.firstVertex, c.vertexCount, c.instanceCount, c.baseInstance);
+		} break;
 		}
+		cmd += 1 + numWords;
 	}
-	if(m_currentState.blendState.logicOp != _pipeline.blendState.logicOp)
+}
+
+void gpupro::OGLContext::execute(CommandQueue& _queue)
+{
+	std::vector<CommandBuffer*> submitted;
 	{
-		glLogicOp(static_cast<GLenum>(_pipeline.blendState.logicOp));
-		m_currentState.blendState.logicOp = _pipeline.blendState.logicOp;
+		std::lock_guard<std::mutex> lock(_queue.m_mutex);
+		submitted.swap(_queue.m_submitted);
 	}
-	if(m_currentState.blendState.alphaToCoverage != _pipeline.blendState.alphaToCoverage)
+	for(CommandBuffer* commands : submitted)
+		execute(*commands);
+}
+
+void gpupro::OGLContext::setSamplers(const GLuint* _samplers, GLuint64 _mask, const BindingTable* _table)
+{
+	// Merge the samplers of the table now. Otherwise they would be
+	// replaced here and set again in setBindings().
+	GLuint merged[BindingTable::MAX_TEXTURES];
+	if(_table && _table->m_samplerMask)
 	{
-		if(_pipeline.blendState.alphaToCoverage)
-			glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE);
-		else
-			glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
-		m_currentState.blendState.alphaToCoverage = _pipeline.blendState.alphaToCoverage;
+		memcpy(merged, _samplers, sizeof(merged));
+		GLuint64 tableMask = _table->m_samplerMask;
+		while(tableMask)
+		{
+			const int i = lowestBit(tableMask);
+			tableMask &= tableMask - 1;
+			merged[i] = _table->m_samplers[i];
+		}
+		_samplers = merged;
+		_mask |= _table->m_samplerMask;
 	}
 
-	// ***** Sampler states ***************************************************
-	for(int i = 0; i < 64; ++i)
+	BindingTable& cur = m_currentBindings;
+	// Only units which are used now or were used before can change.
+	GLuint64 changed = updateNames(cur.m_samplers, _samplers, cur.m_samplerMask | _mask);
+	cur.m_samplerMask = _mask;
+	forEachRange(changed, [&cur](int _first, int _count) {
+		glBindSamplers(_first, _count, cur.m_samplers + _first);
+	});
+}
+
+void gpupro::OGLContext::setBuffers(GLenum _target, GLuint64 _supportedSlots, BindingTable::BufferRanges& _current, const BindingTable::BufferRanges& _new)
+{
+	// Binding a range above the limit of the driver fails as a whole.
+	const GLuint64 newMask = _new.mask & _supportedSlots;
+	if(newMask != _new.mask)
+		std::cerr << "ERR: Buffer binding " << lowestBit(_new.mask & ~_supportedSlots) << " is not supported by the driver and is ignored.\n";
+	GLuint64 candidates = _current.mask | newMask;
+	GLuint64 changed = 0;
+	while(candidates)
 	{
-		if(m_currentState.samplerState[i] != _pipeline.samplerState[i])
+		const int i = lowestBit(candidates);
+		candidates &= candidates - 1;
+		if(_current.ids[i] != _new.ids[i]
+			|| _current.offsets[i] != _new.offsets[i]
+			|| _current.sizes[i] != _new.sizes[i])
 		{
-			glBindSampler(i, _pipeline.samplerState[i] ? _pipeline.samplerState[i]->glID() : 0);
-			m_currentState.samplerState[i] = _pipeline.samplerState[i];
+			_current.ids[i] = _new.ids[i];
+			_current.offsets[i] = _new.offsets[i];
+			_current.sizes[i] = _new.sizes[i];
+			changed |= 1ull << i;
 		}
 	}
+	_current.mask = newMask;
+	forEachRange(changed, [&](int _first, int _count) {
+		glBindBuffersRange(_target, _first, _count, _current.ids + _first, _current.offsets + _first, _current.sizes + _first);
+	});
+}
 
-	// ***** Shader program ***************************************************
-	if(_pipeline.shader) glUseProgram(_pipeline.shader->glID());
+void gpupro::OGLContext::setProgram(GLuint _program)
+{
+	if(m_currentState.keys[CompiledPipeline::PROGRAM] != _program)
+	{
+		glUseProgram(_program);
+		m_currentState.keys[CompiledPipeline::PROGRAM] = _program;
+	}
+}
 
-	static VertexFormat dummyVertexFormat({{}});
-	if(_pipeline.vertexFormat) glBindVertexArray(_pipeline.vertexFormat->glID());
-	else glBindVertexArray(dummyVertexFormat.glID());
+// Forget the names of all slots in _mask which were deleted since
+// _generation. Slots which were never bound cannot change.
+static void forgetDeleted(gpupro::DeletionQueue::ObjectType _type, GLuint _generation, GLuint* _names, GLuint64 _mask)
+{
+	while(_mask)
+	{
+		const int i = lowestBit(_mask);
+		_mask &= _mask - 1;
+		if(_names[i] && _names[i] != ~0u && gpupro::DeletionQueue::wasDeleted(_type, _names[i], _generation))
+			_names[i] = ~0u;
+	}
 }
 
-void gpupro::OGLContext::setState(ComputePipeline & _pipeline)
+void gpupro::OGLContext::checkDeletedObjects()
 {
-	// ***** Sampler states ***************************************************
-	for(int i = 0; i < 64; ++i)
+	// Deleting a bound object resets the binding and the name can be
+	// reused. Therefore, a cached name is no proof for a binding anymore.
+	// Only the slots which held a deleted name are marked as unknown.
+	typedef DeletionQueue::ObjectType Type;
+	GLuint previous[static_cast<int>(Type::NUM_TYPES)];
+	for(int i = 0; i < static_cast<int>(Type::NUM_TYPES); ++i)
 	{
-		if(m_currentState.samplerState[i] != _pipeline.samplerState[i])
-		{
-			glBindSampler(i, _pipeline.samplerState[i] ? _pipeline.samplerState[i]->glID() : 0);
-			m_currentState.samplerState[i] = _pipeline.samplerState[i];
-		}
+		previous[i] = m_deletionGenerations[i];
+		m_deletionGenerations[i] = DeletionQueue::generation(static_cast<Type>(i));
 	}
+	auto changed = [&](Type _type) { return previous[static_cast<int>(_type)] != m_deletionGenerations[static_cast<int>(_type)]; };
+	auto forgetKey = [&](int _slot, Type _type) {
+		GLuint64& key = m_currentState.keys[_slot];
+		if(key && key != ~0ull && DeletionQueue::wasDeleted(_type, static_cast<GLuint>(key), previous[static_cast<int>(_type)]))
+			key = ~0ull;
+	};
 
-	// ***** Shader program ***************************************************
-	if(_pipeline.shader) glUseProgram(_pipeline.shader->glID());
+	if(changed(Type::PROGRAM))
+	{
+		forgetKey(CompiledPipeline::PROGRAM, Type::PROGRAM);
+		for(int i = 0; i < ProgramPipeline::NUM_STAGES; ++i)
+			forgetKey(CompiledPipeline::STAGE_PROGRAM0 + i, Type::PROGRAM);
+	}
+	if(changed(Type::VERTEX_ARRAY))
+		forgetKey(CompiledPipeline::VERTEX_ARRAY, Type::VERTEX_ARRAY);
+
+	BindingTable& cur = m_currentBindings;
+	if(changed(Type::SAMPLER))
+		forgetDeleted(Type::SAMPLER, previous[static_cast<int>(Type::SAMPLER)], cur.m_samplers, cur.m_samplerMask);
+	if(changed(Type::TEXTURE))
+		forgetDeleted(Type::TEXTURE, previous[static_cast<int>(Type::TEXTURE)], cur.m_textures, cur.m_textureMask);
+	if(changed(Type::BUFFER))
+	{
+		forgetDeleted(Type::BUFFER, previous[static_cast<int>(Type::BUFFER)], cur.m_uniformBuffers.ids, cur.m_uniformBuffers.mask);
+		forgetDeleted(Type::BUFFER, previous[static_cast<int>(Type::BUFFER)], cur.m_storageBuffers.ids, cur.m_storageBuffers.mask);
+	}
 }
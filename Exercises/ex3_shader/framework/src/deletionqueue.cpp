@@ -0,0 +1,116 @@
+#include "deletionqueue.hpp"
+#include "fence.hpp"
+
+#include <vector>
+#include <deque>
+
+namespace {
+
+	struct Object
+	{
+		gpupro::DeletionQueue::ObjectType type;
+		GLuint id;
+	};
+
+	// All objects released in one frame together with the fence which
+	// marks the end of that frame.
+	struct FrameObjects
+	{
+		gpupro::Fence fence;
+		std::vector<Object> objects;
+	};
+
+	bool s_active = false;
+	std::vector<Object> s_currentFrame;
+	std::deque<FrameObjects> s_pendingFrames;
+	// The names of the latest deleted objects per type. The name deleted in
+	// generation g is at g % DELETED_LOG_SIZE.
+	const GLuint DELETED_LOG_SIZE = 256;
+	const int NUM_TYPES = static_cast<int>(gpupro::DeletionQueue::ObjectType::NUM_TYPES);
+	GLuint s_generations[NUM_TYPES] = {0};
+	GLuint s_deletedNames[NUM_TYPES][DELETED_LOG_SIZE];
+
+	void deleteObject(const Object& _obj)
+	{
+		switch(_obj.type)
+		{
+		case gpupro::DeletionQueue::ObjectType::BUFFER: glDeleteBuffers(1, &_obj.id); break;
+		case gpupro::DeletionQueue::ObjectType::TEXTURE: glDeleteTextures(1, &_obj.id); break;
+		case gpupro::DeletionQueue::ObjectType::PROGRAM: glDeleteProgram(_obj.id); break;
+		case gpupro::DeletionQueue::ObjectType::QUERY: glDeleteQueries(1, &_obj.id); break;
+		case gpupro::DeletionQueue::ObjectType::VERTEX_ARRAY: glDeleteVertexArrays(1, &_obj.id); break;
+		case gpupro::DeletionQueue::ObjectType::SAMPLER: glDeleteSamplers(1, &_obj.id); break;
+		case gpupro::DeletionQueue::ObjectType::FRAMEBUFFER: glDeleteFramebuffers(1, &_obj.id); break;
+		default: return;
+		}
+		const int type = static_cast<int>(_obj.type);
+		s_deletedNames[type][s_generations[type] % DELETED_LOG_SIZE] = _obj.id;
+		++s_generations[type];
+	}
+
+} // namespace
+
+void gpupro::DeletionQueue::release(ObjectType _type, GLuint _id)
+{
+	if(!_id) return;
+	if(s_active)
+		s_currentFrame.push_back(Object{_type, _id});
+	else
+		deleteObject(Object{_type, _id});
+}
+
+void gpupro::DeletionQueue::endFrame()
+{
+	s_active = true;
+
+	if(!s_currentFrame.empty())
+	{
+		s_pendingFrames.push_back(FrameObjects{Fence(), std::move(s_currentFrame)});
+		s_currentFrame.clear();
+	}
+
+	// Frames finish in order -> stop at the first one which is still running.
+	while(!s_pendingFrames.empty() && s_pendingFrames.front().fence.signaled())
+	{
+		for(auto& obj : s_pendingFrames.front().objects)
+			deleteObject(obj);
+		s_pendingFrames.pop_front();
+	}
+}
+
+void gpupro::DeletionQueue::flush()
+{
+	glFinish();
+	for(auto& frame : s_pendingFrames)
+		for(auto& obj : frame.objects)
+			deleteObject(obj);
+	s_pendingFrames.clear();
+	for(auto& obj : s_currentFrame)
+		deleteObject(obj);
+	s_currentFrame.clear();
+}
+
+size_t gpupro::DeletionQueue::numPending()
+{
+	size_t num = s_currentFrame.size();
+	for(auto& frame : s_pendingFrames)
+		num += frame.objects.size();
+	return num;
+}
+
+GLuint gpupro::DeletionQueue::generation(ObjectType _type)
+{
+	return s_generations[static_cast<int>(_type)];
+}
+
+bool gpupro::DeletionQueue::wasDeleted(ObjectType _type, GLuint _id, GLuint _generation)
+{
+	const int type = static_cast<int>(_type);
+	const GLuint numDeleted = s_generations[type] - _generation;
+	if(numDeleted > DELETED_LOG_SIZE)
+		return true;
+	for(GLuint g = _generation; g != s_generations[type]; ++g)
+		if(s_deletedNames[type][g % DELETED_LOG_SIZE] == _id)
+			return true;
+	return false;
+}
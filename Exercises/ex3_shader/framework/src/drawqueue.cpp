@@ -0,0 +1,214 @@
+#include "drawqueue.hpp"
+#include "context.hpp"
+#include "timeline.hpp"
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+	// Below this number of draws sorting is not worth starting threads.
+	const size_t PARALLEL_SORT_THRESHOLD = 16384;
+
+	// Blocks until all threads reached wait().
+	class Barrier
+	{
+	public:
+		explicit Barrier(unsigned _numThreads) : m_numThreads(_numThreads), m_numWaiting(0), m_generation(0) {}
+
+		void wait()
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			unsigned generation = m_generation;
+			if(++m_numWaiting == m_numThreads)
+			{
+				m_numWaiting = 0;
+				++m_generation;
+				m_condition.notify_all();
+			} else
+				m_condition.wait(lock, [&]() { return generation != m_generation; });
+		}
+	private:
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		unsigned m_numThreads;
+		unsigned m_numWaiting;
+		unsigned m_generation;
+	};
+
+	GLuint64 quantizeDepth(float _depth)
+	{
+		return static_cast<GLuint64>(std::min(std::max(_depth, 0.0f), 1.0f) * 0xffffff);
+	}
+
+} // namespace
+
+gpupro::DrawQueue::DrawQueue(GLuint _numThreads) :
+	m_numThreads(_numThreads)
+{
+	if(m_numThreads == 0)
+		m_numThreads = std::max(1u, std::thread::hardware_concurrency());
+}
+
+void gpupro::DrawQueue::submit(Bucket _bucket, GLuint _layer, const CompiledPipeline& _pipeline, const BindingTable* _bindings,
+	float _depth, std::function<void()> _draw)
+{
+	// Fold the pipeline hash and the table address into the id ranges.
+	// Collisions only make the order less optimal.
+	GLuint64 hash = _pipeline.hash();
+	GLuint pipelineId = static_cast<GLuint>((hash ^ (hash >> 16) ^ (hash >> 32) ^ (hash >> 48)) & 0xffff);
+	GLuint materialId = _bindings ? static_cast<GLuint>((reinterpret_cast<size_t>(_bindings) * 0x9E3779B97F4A7C15ull) >> 44) : 0;
+	GLuint64 key = _bucket == Bucket::SOLID
+		? makeSolidKey(_layer, pipelineId, materialId, _depth)
+		: makeBlendedKey(_layer, _depth, pipelineId, materialId);
+	submit(_bucket, key, _pipeline, _bindings, std::move(_draw));
+}
+
+void gpupro::DrawQueue::submit(Bucket _bucket, GLuint64 _key, const CompiledPipeline& _pipeline, const BindingTable* _bindings,
+	std::function<void()> _draw)
+{
+	SortEntry entry = {_key, static_cast<GLuint>(m_draws.size())};
+	m_buckets[static_cast<int>(_bucket)].push_back(entry);
+	Draw draw = {&_pipeline, _bindings, std::move(_draw)};
+	m_draws.push_back(std::move(draw));
+}
+
+GLuint64 gpupro::DrawQueue::makeSolidKey(GLuint _layer, GLuint _pipelineId, GLuint _materialId, float _depth)
+{
+	return (static_cast<GLuint64>(_layer & 0xf) << 60)
+		| (static_cast<GLuint64>(_pipelineId & 0xffff) << 44)
+		| (static_cast<GLuint64>(_materialId & 0xfffff) << 24)
+		| quantizeDepth(_depth);
+}
+
+GLuint64 gpupro::DrawQueue::makeBlendedKey(GLuint _layer, float _depth, GLuint _pipelineId, GLuint _materialId)
+{
+	return (static_cast<GLuint64>(_layer & 0xf) << 60)
+		| ((0xffffff - quantizeDepth(_depth)) << 36)
+		| (static_cast<GLuint64>(_pipelineId & 0xffff) << 20)
+		| static_cast<GLuint64>(_materialId & 0xfffff);
+}
+
+void gpupro::DrawQueue::sort(std::vector<SortEntry>& _entries)
+{
+	// LSD radix sort with 8 bit digits. Each thread sorts a chunk of the
+	// input into the places computed from the histograms of all threads.
+	const size_t n = _entries.size();
+	if(n < 2) return;
+	m_sortBuffer.resize(n);
+	const unsigned numThreads = n < PARALLEL_SORT_THRESHOLD ? 1 : m_numThreads;
+	std::vector<std::array<size_t, 256>> histograms(numThreads);
+	Barrier barrier(numThreads);
+	bool resultInSortBuffer = false;
+
+	auto worker = [&](unsigned _thread) {
+		CPU_ZONE("DrawQueue::sort");
+		SortEntry* in = _entries.data();
+		SortEntry* out = m_sortBuffer.data();
+		const size_t begin = n * _thread / numThreads;
+		const size_t end = n * (_thread + 1) / numThreads;
+		for(int shift = 0; shift < 64; shift += 8)
+		{
+			std::array<size_t, 256>& histogram = histograms[_thread];
+			histogram.fill(0);
+			for(size_t i = begin; i < end; ++i)
+				++histogram[(in[i].key >> shift) & 0xff];
+			barrier.wait();
+
+			// Compute where this thread writes each digit. If all keys have the
+			// same digit the pass would not change anything.
+			size_t offsets[256];
+			size_t sum = 0;
+			bool skip = false;
+			for(int d = 0; d < 256; ++d)
+			{
+				size_t digitStart = sum;
+				for(unsigned t = 0; t < numThreads; ++t)
+				{
+					if(t == _thread) offsets[d] = sum;
+					sum += histograms[t][d];
+				}
+				if(sum - digitStart == n) skip = true;
+			}
+			if(!skip)
+				for(size_t i = begin; i < end; ++i)
+					out[offsets[(in[i].key >> shift) & 0xff]++] = in[i];
+			// Wait until all scatters are done before the histograms are reused.
+			barrier.wait();
+			if(!skip)
+				std::swap(in, out);
+		}
+		if(_thread == 0)
+			resultInSortBuffer = in != _entries.data();
+	};
+
+	std::vector<std::thread> threads;
+	for(unsigned t = 1; t < numThreads; ++t)
+		threads.emplace_back(worker, t);
+	worker(0);
+	for(auto& thread : threads)
+		thread.join();
+
+	if(resultInSortBuffer)
+		_entries.swap(m_sortBuffer);
+}
+
+void gpupro::DrawQueue::execute(OGLContext& _context)
+{
+	m_stats = Stats();
+	m_stats.numDraws = static_cast<GLuint>(m_draws.size());
+
+	// Count the switches of the submission order for comparison.
+	GLuint submittedPipelineSwitches = 0;
+	GLuint submittedBindingSwitches = 0;
+	const CompiledPipeline* pipeline = nullptr;
+	const BindingTable* bindings = nullptr;
+	for(auto& draw : m_draws)
+	{
+		if(draw.pipeline != pipeline)
+		{
+			++submittedPipelineSwitches;
+			bindings = nullptr;
+		}
+		if(draw.bindings && draw.bindings != bindings) ++submittedBindingSwitches;
+		pipeline = draw.pipeline;
+		if(draw.bindings) bindings = draw.bindings;
+	}
+
+	pipeline = nullptr;
+	bindings = nullptr;
+	for(auto& bucket : m_buckets)
+	{
+		sort(bucket);
+		for(auto& entry : bucket)
+		{
+			Draw& draw = m_draws[entry.index];
+			if(draw.pipeline != pipeline)
+			{
+				_context.setState(*draw.pipeline);
+				pipeline = draw.pipeline;
+				++m_stats.pipelineSwitches;
+				// The samplers and bindings of the pipeline replace parts of
+				// the table, it must be applied again.
+				bindings = nullptr;
+			}
+			if(draw.bindings && draw.bindings != bindings)
+			{
+				_context.setBindings(*draw.bindings);
+				bindings = draw.bindings;
+				++m_stats.bindingSwitches;
+			}
+			if(draw.draw)
+				draw.draw();
+		}
+		bucket.clear();
+	}
+	m_draws.clear();
+
+	if(submittedPipelineSwitches > m_stats.pipelineSwitches)
+		m_stats.pipelineSwitchesAvoided = submittedPipelineSwitches - m_stats.pipelineSwitches;
+	if(submittedBindingSwitches > m_stats.bindingSwitches)
+		m_stats.bindingSwitchesAvoided = submittedBindingSwitches - m_stats.bindingSwitches;
+}
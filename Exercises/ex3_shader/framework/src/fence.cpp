@@ -0,0 +1,47 @@
+#include "fence.hpp"
+
+gpupro::Fence::Fence()
+{
+	m_sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+gpupro::Fence::~Fence()
+{
+	if(m_sync) glDeleteSync(m_sync);
+}
+
+gpupro::Fence::Fence(Fence&& _rhs) :
+	m_sync(_rhs.m_sync)
+{
+	_rhs.m_sync = nullptr;
+}
+
+gpupro::Fence& gpupro::Fence::operator = (Fence&& _rhs)
+{
+	if(m_sync) glDeleteSync(m_sync);
+
+	m_sync = _rhs.m_sync;
+	_rhs.m_sync = nullptr;
+	return *this;
+}
+
+bool gpupro::Fence::signaled() const
+{
+	if(!m_sync) return true;
+	// Unlike glClientWaitSync this does not flush the command queue.
+	GLint status = GL_UNSIGNALED;
+	glGetSynciv(m_sync, GL_SYNC_STATUS, 1, nullptr, &status);
+	return status == GL_SIGNALED;
+}
+
+bool gpupro::Fence::wait(GLuint64 _timeoutNs)
+{
+	if(!m_sync) return true;
+	GLenum result = glClientWaitSync(m_sync, GL_SYNC_FLUSH_COMMANDS_BIT, _timeoutNs);
+	return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+void gpupro::Fence::waitGPU()
+{
+	if(m_sync) glWaitSync(m_sync, 0, GL_TIMEOUT_IGNORED);
+}
@@ -0,0 +1,27 @@
+#include "glfunctions.hpp"
+
+namespace {
+
+	const char* s_names[] = {
+	#define GL_FUNCTION(name, type, params) #name + 5,
+	#include "glfunctions.inl"
+	#undef GL_FUNCTION
+	};
+
+	const char* s_parameters[] = {
+	#define GL_FUNCTION(name, type, params) params,
+	#include "glfunctions.inl"
+	#undef GL_FUNCTION
+	};
+
+} // namespace
+
+const char* gpupro::glFunctionName(GLFunction _function)
+{
+	return s_names[size_t(_function)];
+}
+
+const char* gpupro::glFunctionParameters(GLFunction _function)
+{
+	return s_parameters[size_t(_function)];
+}
@@ -0,0 +1,989 @@
+#include "gltrace.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+using gpupro::GLFunction;
+
+// ************************************************************************* //
+// Trace format
+//
+// Header: magic, version, number of functions, the function names (id =
+// index in this table), width and height of the default framebuffer.
+// Calls: 16 bit function id, the arguments with their native size and the
+// data of pointer arguments (32 bit size or marker followed by the bytes).
+// After the arguments follow the names written by the function and the
+// return value.
+// Index: number of frames, stream offsets of all frames plus the end of
+// the last frame. The last 8 bytes of the file contain the index offset.
+
+namespace {
+
+	const size_t NUM_FUNCTIONS = size_t(GLFunction::NUM_FUNCTIONS);
+	const size_t MAX_PARAMETERS = 16;
+	const uint32_t TRACE_MAGIC = 0x52545047;	// "GPTR"
+	const uint32_t TRACE_VERSION = 1;
+	// Special record: data written by the application to a mapped buffer.
+	const uint16_t MAPPED_WRITE = 0xffff;
+	// Markers instead of a data size
+	const uint32_t NULL_POINTER = 0xffffffff;
+	const uint32_t BUFFER_OFFSET = 0xfffffffe;	///< Followed by a 64 bit offset
+	const uint32_t UNKNOWN_SIZE = 0xfffffffd;
+	// Memory for outputs and arrays of unknown size during replay.
+	const size_t SCRATCH_SIZE = 1 << 16;
+
+	template<typename T>
+	typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, GLuint64>::type toWord(T _value)
+	{
+		return static_cast<GLuint64>(_value);
+	}
+
+	GLuint64 toWord(float _value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &_value, sizeof(bits));
+		return bits;
+	}
+
+	GLuint64 toWord(double _value)
+	{
+		GLuint64 bits;
+		memcpy(&bits, &_value, sizeof(bits));
+		return bits;
+	}
+
+	template<typename T>
+	GLuint64 toWord(T* _pointer)
+	{
+		return static_cast<GLuint64>(reinterpret_cast<uintptr_t>(_pointer));
+	}
+
+	template<typename T>
+	typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, T>::type fromWord(GLuint64 _word)
+	{
+		return static_cast<T>(_word);
+	}
+
+	template<typename T>
+	typename std::enable_if<std::is_floating_point<T>::value, T>::type fromWord(GLuint64 _word)
+	{
+		T value;
+		memcpy(&value, &_word, sizeof(value));
+		return value;
+	}
+
+	template<typename T>
+	typename std::enable_if<std::is_pointer<T>::value, T>::type fromWord(GLuint64 _word)
+	{
+		return reinterpret_cast<T>(static_cast<uintptr_t>(_word));
+	}
+
+	template<typename T> struct PointeeSize { static const size_t value = 0; };
+	template<typename T> struct PointeeSize<T*> { static const size_t value = sizeof(typename std::conditional<std::is_scalar<T>::value, T, char>::type); };
+
+	// Pointer to non-const data which is written by GL.
+	template<typename T> struct IsOutput { static const bool value = false; };
+	template<typename T> struct IsOutput<T*> { static const bool value = !std::is_const<T>::value; };
+
+	bool isObjectName(char _class)
+	{
+		return strchr("btsfrvqxPph", _class) != nullptr;
+	}
+
+	int findParameter(const char* _params, char _class)
+	{
+		const char* p = strchr(_params, _class);
+		return p ? int(p - _params) : -1;
+	}
+
+	// Buffer and texture uploads/downloads which can use a pixel buffer.
+	bool isPixelTransfer(const char* _name)
+	{
+		if(strstr(_name, "Clear")) return false;
+		return (strstr(_name, "Tex") && strstr(_name, "Image")) || strstr(_name, "ReadPixels") || strstr(_name, "ReadnPixels");
+	}
+
+	size_t pixelSize(GLenum _format, GLenum _type)
+	{
+		size_t components = 4;
+		switch(_format)
+		{
+		case GL_RED: case GL_GREEN: case GL_BLUE: case GL_RED_INTEGER:
+		case GL_DEPTH_COMPONENT: case GL_STENCIL_INDEX:
+			components = 1; break;
+		case GL_RG: case GL_RG_INTEGER: case GL_DEPTH_STENCIL:
+			components = 2; break;
+		case GL_RGB: case GL_BGR: case GL_RGB_INTEGER: case GL_BGR_INTEGER:
+			components = 3; break;
+		}
+		switch(_type)
+		{
+		case GL_UNSIGNED_BYTE: case GL_BYTE: return components;
+		case GL_UNSIGNED_SHORT: case GL_SHORT: case GL_HALF_FLOAT: return components * 2;
+		case GL_UNSIGNED_INT: case GL_INT: case GL_FLOAT: return components * 4;
+		// Packed types contain all components
+		case GL_UNSIGNED_BYTE_3_3_2: case GL_UNSIGNED_BYTE_2_3_3_REV: return 1;
+		case GL_UNSIGNED_SHORT_5_6_5: case GL_UNSIGNED_SHORT_5_6_5_REV:
+		case GL_UNSIGNED_SHORT_4_4_4_4: case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+		case GL_UNSIGNED_SHORT_5_5_5_1: case GL_UNSIGNED_SHORT_1_5_5_5_REV: return 2;
+		case GL_FLOAT_32_UNSIGNED_INT_24_8_REV: return 8;
+		default: return 4;
+		}
+	}
+
+	// ********************************************************************* //
+	// Capture
+
+	struct Mapping
+	{
+		char* data;
+		GLsizeiptr length;
+		GLbitfield access;
+	};
+
+	bool s_capturing = false;
+	GLuint s_framesLeft = 0;
+	std::ofstream s_file;
+	std::vector<char> s_stream;			// Not yet written part of the stream
+	GLuint64 s_streamOffset = 0;		// Bytes written to the file
+	std::vector<GLuint64> s_frameOffsets;
+	GLint s_unpackAlignment = 4, s_unpackRowLength = 0;
+	GLint s_packAlignment = 4, s_packRowLength = 0;
+	std::unordered_map<GLenum, GLuint> s_boundBuffers;
+	std::unordered_map<GLuint, Mapping> s_mappings;		// By buffer name
+
+	void write(const void* _data, size_t _size)
+	{
+		const char* bytes = static_cast<const char*>(_data);
+		s_stream.insert(s_stream.end(), bytes, bytes + _size);
+		if(s_stream.size() > (1 << 22))
+		{
+			s_file.write(s_stream.data(), s_stream.size());
+			s_streamOffset += s_stream.size();
+			s_stream.clear();
+		}
+	}
+
+	template<typename T>
+	void writeValue(T _value)
+	{
+		write(&_value, sizeof(T));
+	}
+
+	void writeData(const void* _data, size_t _size)
+	{
+		if(!_data)
+			writeValue(NULL_POINTER);
+		else {
+			writeValue(static_cast<uint32_t>(_size));
+			write(_data, _size);
+		}
+	}
+
+	GLuint64 streamPosition()
+	{
+		return s_streamOffset + s_stream.size();
+	}
+
+	void writeMapped(GLuint _buffer, GLintptr _offset, GLsizeiptr _length)
+	{
+		auto it = s_mappings.find(_buffer);
+		if(it == s_mappings.end() || !(it->second.access & GL_MAP_WRITE_BIT))
+			return;
+		writeValue(MAPPED_WRITE);
+		writeValue(toWord(it->second.data));
+		writeValue(static_cast<GLuint64>(_offset));
+		writeData(it->second.data + _offset, size_t(_length));
+	}
+
+	// Size of the data behind a pointer parameter or UNKNOWN_SIZE.
+	size_t dataSize(GLFunction _function, const char* _params, int _index, const GLuint64* _words, bool _output)
+	{
+		const char* name = glFunctionName(_function);
+		int format = findParameter(_params, 'F');
+		int type = findParameter(_params, 'T');
+		if(format >= 0 && type >= 0)
+		{
+			size_t pixel = pixelSize(GLenum(_words[format]), GLenum(_words[type]));
+			int w = findParameter(_params, 'W');
+			int h = findParameter(_params, 'H');
+			int d = findParameter(_params, 'D');
+			// Clear functions take a single value
+			if(w < 0) return pixel;
+			size_t width = size_t(_words[w]);
+			size_t height = h >= 0 ? size_t(_words[h]) : 1;
+			size_t depth = d >= 0 ? size_t(_words[d]) : 1;
+			if(!width || !height || !depth) return 0;
+			size_t alignment = size_t(_output ? s_packAlignment : s_unpackAlignment);
+			size_t rowLength = size_t(_output ? s_packRowLength : s_unpackRowLength);
+			size_t rowSize = pixel * (rowLength ? rowLength : width);
+			rowSize = (rowSize + alignment - 1) / alignment * alignment;
+			return rowSize * (height * depth - 1) + pixel * width;
+		}
+		int size = findParameter(_params, 'z');
+		if(size >= 0) return size_t(_words[size]);
+		int length = findParameter(_params, 'l');
+		if(length >= 0) return size_t(_words[length]);
+		if(_output) return UNKNOWN_SIZE;
+
+		// glUniform{1234}{f,i,ui,d}v, glUniformMatrix{234}[x{234}]{f,d}v and
+		// the glProgramUniform versions.
+		const char* uniform = strstr(name, "Uniform");
+		int count = findParameter(_params, '#');
+		if(uniform && count >= 0)
+		{
+			const char* p = uniform + 7;
+			size_t components = 1;
+			if(strncmp(p, "Matrix", 6) == 0)
+			{
+				p += 6;
+				size_t rows = size_t(*p++ - '0');
+				size_t columns = rows;
+				if(*p == 'x') { columns = size_t(p[1] - '0'); p += 2; }
+				components = rows * columns;
+			}
+			else if(*p >= '1' && *p <= '4')
+				components = size_t(*p++ - '0');
+			size_t elementSize = (*p == 'd' || strstr(p, "64")) ? 8 : 4;
+			return size_t(_words[count]) * components * elementSize;
+		}
+		// gl*Parameter{f,i,Ii,Iui}v(object, pname, params)
+		if(strstr(name, "Parameter") && _index > 0)
+		{
+			GLenum pname = GLenum(_words[_index - 1]);
+			return (pname == GL_TEXTURE_BORDER_COLOR || pname == GL_TEXTURE_SWIZZLE_RGBA) ? 16 : 4;
+		}
+		// glClearBuffer*v(buffer, drawbuffer, value) and glClearNamedFramebuffer*v
+		if(strncmp(name, "glClearBuffer", 13) == 0 || strncmp(name, "glClearNamedFramebuffer", 23) == 0)
+		{
+			GLenum buffer = GLenum(_words[_params[0] == 'f' ? 1 : 0]);
+			return buffer == GL_COLOR ? 16 : 4;
+		}
+		return UNKNOWN_SIZE;
+	}
+
+	void writeString(const GLchar* _string, GLint _length)
+	{
+		writeData(_string, _string && _length < 0 ? strlen(_string) : size_t(_length));
+	}
+
+	// Arguments and the data of pointer arguments.
+	void writeArguments(GLFunction _function, size_t _numArgs, const GLuint64* _words, const size_t* _sizes,
+		const bool* _isPointer, const bool* _isOutput, const size_t* _pointeeSizes)
+	{
+		const char* params = glFunctionParameters(_function) + 1;
+		const char* name = glFunctionName(_function);
+		int count = findParameter(params, '#');
+		int length = findParameter(params, 'l');
+		size_t numElements = count >= 0 ? size_t(_words[count]) : 1;
+
+		writeValue(static_cast<uint16_t>(_function));
+		for(size_t i = 0; i < _numArgs; ++i)
+		{
+			const void* pointer = fromWord<const void*>(_words[i]);
+			if(!_isPointer[i]) {
+				write(&_words[i], _sizes[i]);
+				continue;
+			}
+			const char c = params[i];
+			if(c == 'n') continue;
+			if(c == 'y' || c == 'o') {
+				writeValue(_words[i]);
+				continue;
+			}
+			// Output names are written after the call
+			if(isObjectName(c) && _isOutput[i]) continue;
+			if(isObjectName(c) || c == 'a') {
+				writeData(pointer, numElements * _pointeeSizes[i]);
+				continue;
+			}
+			if(c == 'c') {
+				writeString(static_cast<const GLchar*>(pointer), length >= 0 ? GLint(_words[length]) : -1);
+				continue;
+			}
+			if(c == 'S') {
+				if(!pointer) { writeValue(NULL_POINTER); continue; }
+				const GLchar* const* strings = static_cast<const GLchar* const*>(pointer);
+				// Only glShaderSource has explicit lengths
+				const GLint* lengths = _function == GLFunction::glShaderSource ? fromWord<const GLint*>(_words[i + 1]) : nullptr;
+				writeValue(static_cast<uint32_t>(numElements));
+				for(size_t s = 0; s < numElements; ++s)
+					writeString(strings[s], lengths ? lengths[s] : -1);
+				continue;
+			}
+			// 'd' and '*'
+			if(!pointer) {
+				writeValue(NULL_POINTER);
+				continue;
+			}
+			if(isPixelTransfer(name) && s_boundBuffers[_isOutput[i] ? GL_PIXEL_PACK_BUFFER : GL_PIXEL_UNPACK_BUFFER]) {
+				writeValue(BUFFER_OFFSET);
+				writeValue(_words[i]);
+				continue;
+			}
+			size_t size = dataSize(_function, params, int(i), _words, _isOutput[i]);
+			if(_isOutput[i])
+				writeValue(static_cast<uint32_t>(size == UNKNOWN_SIZE ? 0 : size));
+			else if(size == UNKNOWN_SIZE)
+				writeValue(UNKNOWN_SIZE);
+			else
+				writeData(pointer, size);
+		}
+	}
+
+	// Names generated by the function.
+	void writeOutputs(GLFunction _function, size_t _numArgs, const GLuint64* _words, const bool* _isOutput)
+	{
+		const char* params = glFunctionParameters(_function) + 1;
+		int count = findParameter(params, '#');
+		size_t numElements = count >= 0 ? size_t(_words[count]) : 1;
+		for(size_t i = 0; i < _numArgs; ++i)
+			if(isObjectName(params[i]) && _isOutput[i])
+				write(fromWord<const GLuint*>(_words[i]), numElements * sizeof(GLuint));
+	}
+
+	GLsizeiptr bufferSize(GLenum _target, GLuint _buffer);
+
+	// Track the state which is required to serialize the data.
+	void beforeCall(GLFunction _function, const GLuint64* _words)
+	{
+		switch(_function)
+		{
+		case GLFunction::glFlushMappedBufferRange:
+			writeMapped(s_boundBuffers[GLenum(_words[0])], GLintptr(_words[1]), GLsizeiptr(_words[2]));
+			break;
+		case GLFunction::glFlushMappedNamedBufferRange:
+			writeMapped(GLuint(_words[0]), GLintptr(_words[1]), GLsizeiptr(_words[2]));
+			break;
+		case GLFunction::glUnmapBuffer:
+		case GLFunction::glUnmapNamedBuffer: {
+			GLuint buffer = _function == GLFunction::glUnmapBuffer ? s_boundBuffers[GLenum(_words[0])] : GLuint(_words[0]);
+			auto it = s_mappings.find(buffer);
+			if(it == s_mappings.end()) break;
+			if(!(it->second.access & GL_MAP_FLUSH_EXPLICIT_BIT))
+				writeMapped(buffer, 0, it->second.length);
+			s_mappings.erase(it);
+			break;
+		}
+		case GLFunction::glDeleteBuffers: {
+			const GLuint* buffers = fromWord<const GLuint*>(_words[1]);
+			for(GLsizei i = 0; i < GLsizei(_words[0]); ++i)
+				s_mappings.erase(buffers[i]);
+			break;
+		}
+		default: break;
+		}
+	}
+
+	void afterCall(GLFunction _function, const GLuint64* _words, GLuint64 _result)
+	{
+		switch(_function)
+		{
+		case GLFunction::glBindBuffer:
+			s_boundBuffers[GLenum(_words[0])] = GLuint(_words[1]);
+			break;
+		case GLFunction::glBindBufferBase:
+		case GLFunction::glBindBufferRange:
+			s_boundBuffers[GLenum(_words[0])] = GLuint(_words[2]);
+			break;
+		case GLFunction::glPixelStorei:
+			switch(GLenum(_words[0]))
+			{
+			case GL_UNPACK_ALIGNMENT: s_unpackAlignment = GLint(_words[1]); break;
+			case GL_UNPACK_ROW_LENGTH: s_unpackRowLength = GLint(_words[1]); break;
+			case GL_PACK_ALIGNMENT: s_packAlignment = GLint(_words[1]); break;
+			case GL_PACK_ROW_LENGTH: s_packRowLength = GLint(_words[1]); break;
+			}
+			break;
+		case GLFunction::glMapBufferRange:
+		case GLFunction::glMapNamedBufferRange: {
+			if(!_result) break;
+			GLuint buffer = _function == GLFunction::glMapBufferRange ? s_boundBuffers[GLenum(_words[0])] : GLuint(_words[0]);
+			s_mappings[buffer] = Mapping{ fromWord<char*>(_result), GLsizeiptr(_words[2]), GLbitfield(_words[3]) };
+			break;
+		}
+		case GLFunction::glMapBuffer:
+		case GLFunction::glMapNamedBuffer: {
+			if(!_result) break;
+			bool named = _function == GLFunction::glMapNamedBuffer;
+			GLuint buffer = named ? GLuint(_words[0]) : s_boundBuffers[GLenum(_words[0])];
+			GLenum access = GLenum(_words[1]);
+			GLbitfield accessBits = (access == GL_READ_ONLY ? 0 : GL_MAP_WRITE_BIT) | (access == GL_WRITE_ONLY ? 0 : GL_MAP_READ_BIT);
+			s_mappings[buffer] = Mapping{ fromWord<char*>(_result), bufferSize(named ? 0 : GLenum(_words[0]), buffer), accessBits };
+			break;
+		}
+		default: break;
+		}
+	}
+
+	// Calls the original function and serializes the results.
+	template<typename Ret>
+	struct CaptureResult
+	{
+		template<typename Fn, typename... Args>
+		static Ret call(GLFunction _function, Fn _original, const GLuint64* _words, const bool* _isOutput, Args... _args)
+		{
+			Ret result = _original(_args...);
+			GLuint64 word = toWord(result);
+			writeOutputs(_function, sizeof...(Args), _words, _isOutput);
+			write(&word, sizeof(Ret));
+			afterCall(_function, _words, word);
+			return result;
+		}
+	};
+
+	template<>
+	struct CaptureResult<void>
+	{
+		template<typename Fn, typename... Args>
+		static void call(GLFunction _function, Fn _original, const GLuint64* _words, const bool* _isOutput, Args... _args)
+		{
+			_original(_args...);
+			writeOutputs(_function, sizeof...(Args), _words, _isOutput);
+			afterCall(_function, _words, 0);
+		}
+	};
+
+	template<GLFunction F, typename Fn> struct Capture;
+	template<GLFunction F, typename Ret, typename... Args>
+	struct Capture<F, Ret (APIENTRY*)(Args...)>
+	{
+		static Ret (APIENTRY* original)(Args...);
+
+		static Ret APIENTRY call(Args... _args)
+		{
+			// The additional element avoids arrays of size 0.
+			const GLuint64 words[] = { toWord(_args)..., 0 };
+			static const size_t sizes[] = { sizeof(Args)..., 0 };
+			static const bool isPointer[] = { std::is_pointer<Args>::value..., false };
+			static const bool isOutput[] = { IsOutput<Args>::value..., false };
+			static const size_t pointeeSizes[] = { PointeeSize<Args>::value..., 0 };
+			beforeCall(F, words);
+			writeArguments(F, sizeof...(Args), words, sizes, isPointer, isOutput, pointeeSizes);
+			return CaptureResult<Ret>::call(F, original, words, isOutput, _args...);
+		}
+	};
+
+	template<GLFunction F, typename Ret, typename... Args>
+	Ret (APIENTRY* Capture<F, Ret (APIENTRY*)(Args...)>::original)(Args...) = nullptr;
+
+	GLsizeiptr bufferSize(GLenum _target, GLuint _buffer)
+	{
+		GLint64 size = 0;
+		if(_target && Capture<GLFunction::glad_glGetBufferParameteri64v, PFNGLGETBUFFERPARAMETERI64VPROC>::original)
+			Capture<GLFunction::glad_glGetBufferParameteri64v, PFNGLGETBUFFERPARAMETERI64VPROC>::original(_target, GL_BUFFER_SIZE, &size);
+		else if(Capture<GLFunction::glad_glGetNamedBufferParameteri64v, PFNGLGETNAMEDBUFFERPARAMETERI64VPROC>::original)
+			Capture<GLFunction::glad_glGetNamedBufferParameteri64v, PFNGLGETNAMEDBUFFERPARAMETERI64VPROC>::original(_buffer, GL_BUFFER_SIZE, &size);
+		return GLsizeiptr(size);
+	}
+
+} // namespace
+
+bool gpupro::GLTrace::beginCapture(const char* _fileName, GLuint _numFrames)
+{
+	if(s_capturing) {
+		std::cerr << "ERR: GLTrace::beginCapture: a capture is already running.\n";
+		return false;
+	}
+	if(!glad_glGetIntegerv) {
+		std::cerr << "ERR: GLTrace::beginCapture requires a loaded context.\n";
+		return false;
+	}
+	s_file.open(_fileName, std::ios::binary | std::ios::trunc);
+	if(!s_file) {
+		std::cerr << "ERR: GLTrace::beginCapture cannot open " << _fileName << ".\n";
+		return false;
+	}
+
+	GLint viewport[4] = {0};
+	glGetIntegerv(GL_VIEWPORT, viewport);
+
+	s_stream.clear();
+	s_streamOffset = 0;
+	writeValue(TRACE_MAGIC);
+	writeValue(TRACE_VERSION);
+	writeValue(static_cast<uint32_t>(NUM_FUNCTIONS));
+	for(size_t i = 0; i < NUM_FUNCTIONS; ++i)
+	{
+		const char* name = glFunctionName(GLFunction(i));
+		writeValue(static_cast<uint16_t>(strlen(name)));
+		write(name, strlen(name));
+	}
+	writeValue(static_cast<int32_t>(viewport[2]));
+	writeValue(static_cast<int32_t>(viewport[3]));
+
+	// The capture starts with the initial state of a new context.
+	s_unpackAlignment = s_packAlignment = 4;
+	s_unpackRowLength = s_packRowLength = 0;
+	s_boundBuffers.clear();
+	s_mappings.clear();
+	s_frameOffsets.clear();
+	s_frameOffsets.push_back(streamPosition());
+	s_framesLeft = _numFrames;
+
+	#define GL_FUNCTION(name, type, params) \
+		if(name) { Capture<GLFunction::name, type>::original = name; name = &Capture<GLFunction::name, type>::call; }
+	#include "glfunctions.inl"
+	#undef GL_FUNCTION
+
+	s_capturing = true;
+	return true;
+}
+
+void gpupro::GLTrace::endCapture()
+{
+	if(!s_capturing) return;
+
+	#define GL_FUNCTION(name, type, params) \
+		if(Capture<GLFunction::name, type>::original) { name = Capture<GLFunction::name, type>::original; Capture<GLFunction::name, type>::original = nullptr; }
+	#include "glfunctions.inl"
+	#undef GL_FUNCTION
+	s_capturing = false;
+
+	// The last frame may be incomplete
+	if(s_frameOffsets.back() != streamPosition())
+		s_frameOffsets.push_back(streamPosition());
+
+	GLuint64 indexOffset = streamPosition();
+	writeValue(static_cast<uint32_t>(s_frameOffsets.size() - 1));
+	write(s_frameOffsets.data(), s_frameOffsets.size() * sizeof(GLuint64));
+	writeValue(indexOffset);
+	s_file.write(s_stream.data(), s_stream.size());
+	s_file.close();
+	s_stream.clear();
+	std::cerr << "INF: Captured " << s_frameOffsets.size() - 1 << " frames (" << (s_streamOffset + s_stream.size()) / 1024 << " KB).\n";
+	s_mappings.clear();
+}
+
+bool gpupro::GLTrace::isCapturing()
+{
+	return s_capturing;
+}
+
+void gpupro::GLTrace::markFrame()
+{
+	if(!s_capturing) return;
+
+	// Persistent mappings are never unmapped
+	for(auto& it : s_mappings)
+		if((it.second.access & GL_MAP_PERSISTENT_BIT) && !(it.second.access & GL_MAP_FLUSH_EXPLICIT_BIT))
+			writeMapped(it.first, 0, it.second.length);
+
+	s_frameOffsets.push_back(streamPosition());
+	if(s_framesLeft && --s_framesLeft == 0)
+		endCapture();
+}
+
+// ************************************************************************* //
+// Replay
+
+struct gpupro::GLTraceReplayer::State
+{
+	typedef void (*ReplayFunction)(State&);
+
+	std::vector<char> data;
+	size_t position = 0;
+	bool error = false;
+	std::vector<GLuint64> frameOffsets;
+	std::vector<ReplayFunction> functions;		// By id in the trace
+	std::vector<GLFunction> functionIds;
+	GLsizei width = 0, height = 0;
+
+	// Translation of recorded names per object type (class character)
+	std::unordered_map<GLuint, GLuint> names[128];
+	// Sync objects and mapped pointers
+	std::unordered_map<GLuint64, GLuint64> handles;
+	std::vector<char> parameterData[MAX_PARAMETERS];
+	std::vector<const GLchar*> strings;
+
+	bool callTiming = false;
+	GLuint64 numCalls[NUM_FUNCTIONS];
+	double totalTime[NUM_FUNCTIONS];
+	double maxTime[NUM_FUNCTIONS];
+	bool warned[NUM_FUNCTIONS];
+
+	const char* readBytes(size_t _size)
+	{
+		if(position + _size > data.size()) {
+			error = true;
+			return nullptr;
+		}
+		const char* bytes = data.data() + position;
+		position += _size;
+		return bytes;
+	}
+
+	template<typename T>
+	T read()
+	{
+		T value = T();
+		const char* bytes = readBytes(sizeof(T));
+		if(bytes) memcpy(&value, bytes, sizeof(T));
+		return value;
+	}
+
+	GLuint translate(char _class, GLuint _name) const
+	{
+		auto& map = names[int(_class)];
+		auto it = map.find(_name);
+		return it == map.end() ? _name : it->second;
+	}
+
+	GLuint64 translateHandle(GLuint64 _handle) const
+	{
+		auto it = handles.find(_handle);
+		return it == handles.end() ? _handle : it->second;
+	}
+
+	// Copy pointer data into the parameter memory. Returns the pointer
+	// argument for the call.
+	GLuint64 readData(size_t _index, size_t _minSize = 0)
+	{
+		uint32_t size = read<uint32_t>();
+		if(size == NULL_POINTER) return 0;
+		if(size == BUFFER_OFFSET) return read<GLuint64>();
+		std::vector<char>& memory = parameterData[_index];
+		if(size == UNKNOWN_SIZE) {
+			memory.assign(SCRATCH_SIZE, 0);
+			return toWord(memory.data());
+		}
+		const char* bytes = readBytes(size);
+		if(!bytes) return 0;
+		// Zero termination for strings
+		memory.assign(std::max(size_t(size) + 1, _minSize), 0);
+		memcpy(memory.data(), bytes, size);
+		return toWord(memory.data());
+	}
+
+	GLuint64 readArgument(GLFunction _function, size_t _index, const GLuint64* _words, size_t _size, bool _isPointer, bool _isOutput, size_t _pointeeSize)
+	{
+		const char* params = glFunctionParameters(_function) + 1;
+		const char c = params[_index];
+		if(!_isPointer)
+		{
+			GLuint64 word = 0;
+			const char* bytes = readBytes(_size);
+			if(bytes) memcpy(&word, bytes, _size);
+			return isObjectName(c) ? translate(c, GLuint(word)) : word;
+		}
+		int count = findParameter(params, '#');
+		size_t numElements = count >= 0 && size_t(count) < _index ? size_t(_words[count]) : 1;
+		switch(c)
+		{
+		case 'n': return 0;
+		case 'o': return read<GLuint64>();
+		case 'y': return translateHandle(read<GLuint64>());
+		case 'S': {
+			uint32_t numStrings = read<uint32_t>();
+			if(numStrings == NULL_POINTER) return 0;
+			std::vector<char>& memory = parameterData[_index];
+			memory.clear();
+			std::vector<size_t> offsets;
+			for(uint32_t s = 0; s < numStrings && !error; ++s)
+			{
+				uint32_t length = read<uint32_t>();
+				if(length == NULL_POINTER) length = 0;
+				const char* bytes = readBytes(length);
+				offsets.push_back(memory.size());
+				if(bytes) memory.insert(memory.end(), bytes, bytes + length);
+				memory.push_back('\0');
+			}
+			strings.clear();
+			for(size_t offset : offsets)
+				strings.push_back(memory.data() + offset);
+			return toWord(strings.data());
+		}
+		case '*': {
+			uint32_t size = read<uint32_t>();
+			if(size == NULL_POINTER) return 0;
+			if(size == BUFFER_OFFSET) return read<GLuint64>();
+			parameterData[_index].assign(std::max(size_t(size), SCRATCH_SIZE), 0);
+			return toWord(parameterData[_index].data());
+		}
+		default:
+			if(isObjectName(c))
+			{
+				if(_isOutput) {
+					parameterData[_index].assign(std::max(numElements * sizeof(GLuint), SCRATCH_SIZE), 0);
+					return toWord(parameterData[_index].data());
+				}
+				GLuint64 pointer = readData(_index);
+				GLuint* ids = fromWord<GLuint*>(pointer);
+				for(size_t i = 0; ids && i < numElements; ++i)
+					ids[i] = translate(c, ids[i]);
+				return pointer;
+			}
+			// 'a', 'c', 'd'
+			return readData(_index, numElements * _pointeeSize);
+		}
+	}
+
+	// Map the names which were generated by the function.
+	void readOutputs(GLFunction _function, size_t _numArgs, const GLuint64* _words, const bool* _isOutput, bool _called)
+	{
+		const char* params = glFunctionParameters(_function) + 1;
+		int count = findParameter(params, '#');
+		size_t numElements = count >= 0 ? size_t(_words[count]) : 1;
+		for(size_t i = 0; i < _numArgs; ++i)
+		{
+			if(!isObjectName(params[i]) || !_isOutput[i]) continue;
+			const char* recorded = readBytes(numElements * sizeof(GLuint));
+			const GLuint* created = fromWord<const GLuint*>(_words[i]);
+			for(size_t n = 0; recorded && _called && n < numElements; ++n)
+			{
+				GLuint name;
+				memcpy(&name, recorded + n * sizeof(GLuint), sizeof(GLuint));
+				names[int(params[i])][name] = created[n];
+			}
+		}
+	}
+
+	void readResult(GLFunction _function, size_t _size, GLuint64 _result, bool _called)
+	{
+		GLuint64 recorded = 0;
+		const char* bytes = readBytes(_size);
+		if(bytes) memcpy(&recorded, bytes, _size);
+		if(!_called) return;
+		const char c = glFunctionParameters(_function)[0];
+		if(isObjectName(c))
+			names[int(c)][GLuint(recorded)] = GLuint(_result);
+		else if(c == 'y' || c == 'm')
+			handles[recorded] = _result;
+	}
+
+	void replayMappedWrite()
+	{
+		GLuint64 pointer = read<GLuint64>();
+		GLuint64 offset = read<GLuint64>();
+		uint32_t size = read<uint32_t>();
+		const char* bytes = size == NULL_POINTER ? nullptr : readBytes(size);
+		auto it = handles.find(pointer);
+		if(bytes && it != handles.end() && it->second)
+			memcpy(fromWord<char*>(it->second) + offset, bytes, size);
+	}
+};
+
+namespace gpupro {
+
+	// Calls the function and returns the result as word.
+	template<typename Ret>
+	struct ReplayResult
+	{
+		template<typename Fn, typename... Args>
+		static GLuint64 call(Fn _function, Args... _args) { return toWord(_function(_args...)); }
+	};
+
+	template<>
+	struct ReplayResult<void>
+	{
+		template<typename Fn, typename... Args>
+		static GLuint64 call(Fn _function, Args... _args) { _function(_args...); return 0; }
+	};
+
+	template<typename Ret> struct ResultSize { static const size_t value = sizeof(Ret); };
+	template<> struct ResultSize<void> { static const size_t value = 0; };
+
+	template<GLFunction F, typename Fn, Fn* Pointer>
+	struct ReplayCall
+	{
+		template<typename T> struct Invoke;
+		template<typename Ret, typename... Args>
+		struct Invoke<Ret (APIENTRY*)(Args...)>
+		{
+			template<size_t... I>
+			static void call(GLTraceReplayer::State& _state, std::index_sequence<I...>)
+			{
+				static_assert(sizeof...(Args) <= MAX_PARAMETERS, "Too many parameters");
+				static const size_t sizes[] = { sizeof(Args)..., 0 };
+				static const bool isPointer[] = { std::is_pointer<Args>::value..., false };
+				static const bool isOutput[] = { IsOutput<Args>::value..., false };
+				static const size_t pointeeSizes[] = { PointeeSize<Args>::value..., 0 };
+				GLuint64 words[sizeof...(Args) + 1] = { 0 };
+				for(size_t i = 0; i < sizeof...(Args); ++i)
+					words[i] = _state.readArgument(F, i, words, sizes[i], isPointer[i], isOutput[i], pointeeSizes[i]);
+				if(_state.error) return;
+
+				const size_t index = size_t(F);
+				const bool available = *Pointer != nullptr;
+				GLuint64 result = 0;
+				if(available)
+				{
+					if(_state.callTiming)
+					{
+						auto start = std::chrono::high_resolution_clock::now();
+						result = ReplayResult<Ret>::call(*Pointer, fromWord<Args>(words[I])...);
+						double time = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+						_state.totalTime[index] += time;
+						_state.maxTime[index] = std::max(_state.maxTime[index], time);
+					}
+					else
+						result = ReplayResult<Ret>::call(*Pointer, fromWord<Args>(words[I])...);
+					++_state.numCalls[index];
+				} else if(!_state.warned[index]) {
+					std::cerr << "WAR: " << glFunctionName(F) << " is not available and will be skipped.\n";
+					_state.warned[index] = true;
+				}
+				_state.readOutputs(F, sizeof...(Args), words, isOutput, available);
+				_state.readResult(F, ResultSize<Ret>::value, result, available);
+			}
+		};
+
+		template<typename Ret, typename... Args>
+		static void invoke(GLTraceReplayer::State& _state, Ret (APIENTRY*)(Args...))
+		{
+			Invoke<Fn>::call(_state, std::index_sequence_for<Args...>());
+		}
+
+		static void call(GLTraceReplayer::State& _state)
+		{
+			invoke(_state, Fn());
+		}
+	};
+
+} // namespace gpupro
+
+gpupro::GLTraceReplayer::GLTraceReplayer(const char* _fileName) :
+	m_state(new State)
+{
+	resetStats();
+	State& s = *m_state;
+	std::ifstream file(_fileName, std::ios::binary | std::ios::ate);
+	if(!file) {
+		std::cerr << "ERR: GLTraceReplayer cannot open " << _fileName << ".\n";
+		s.error = true;
+		return;
+	}
+	s.data.resize(size_t(file.tellg()));
+	file.seekg(0);
+	file.read(s.data.data(), s.data.size());
+
+	if(s.read<uint32_t>() != TRACE_MAGIC || s.read<uint32_t>() != TRACE_VERSION) {
+		std::cerr << "ERR: " << _fileName << " is not a trace of this version.\n";
+		s.error = true;
+		return;
+	}
+
+	// Map the function names of the trace to the local functions
+	static const State::ReplayFunction s_replayFunctions[] = {
+	#define GL_FUNCTION(name, type, params) &ReplayCall<GLFunction::name, type, &name>::call,
+	#include "glfunctions.inl"
+	#undef GL_FUNCTION
+	};
+	std::unordered_map<std::string, size_t> localIds;
+	for(size_t i = 0; i < NUM_FUNCTIONS; ++i)
+		localIds[glFunctionName(GLFunction(i))] = i;
+	uint32_t numFunctions = s.read<uint32_t>();
+	for(uint32_t i = 0; i < numFunctions && !s.error; ++i)
+	{
+		uint16_t length = s.read<uint16_t>();
+		const char* name = s.readBytes(length);
+		auto it = name ? localIds.find(std::string(name, length)) : localIds.end();
+		s.functions.push_back(it == localIds.end() ? nullptr : s_replayFunctions[it->second]);
+		s.functionIds.push_back(it == localIds.end() ? GLFunction::NUM_FUNCTIONS : GLFunction(it->second));
+	}
+	s.width = s.read<int32_t>();
+	s.height = s.read<int32_t>();
+
+	// Frame index
+	if(s.error || s.data.size() < sizeof(GLuint64)) {
+		std::cerr << "ERR: " << _fileName << " is incomplete.\n";
+		s.error = true;
+		return;
+	}
+	s.position = s.data.size() - sizeof(GLuint64);
+	s.position = size_t(s.read<GLuint64>());
+	uint32_t numFrames = s.read<uint32_t>();
+	for(uint32_t i = 0; i <= numFrames && !s.error; ++i)
+		s.frameOffsets.push_back(s.read<GLuint64>());
+	if(s.error)
+		std::cerr << "ERR: " << _fileName << " has a corrupt frame index.\n";
+}
+
+gpupro::GLTraceReplayer::~GLTraceReplayer()
+{
+}
+
+bool gpupro::GLTraceReplayer::isValid() const
+{
+	return !m_state->error;
+}
+
+GLuint gpupro::GLTraceReplayer::numFrames() const
+{
+	return m_state->frameOffsets.empty() ? 0 : GLuint(m_state->frameOffsets.size() - 1);
+}
+
+GLsizei gpupro::GLTraceReplayer::width() const
+{
+	return m_state->width;
+}
+
+GLsizei gpupro::GLTraceReplayer::height() const
+{
+	return m_state->height;
+}
+
+double gpupro::GLTraceReplayer::replayFrame(GLuint _frame)
+{
+	State& s = *m_state;
+	if(s.error) return -1.0;
+	if(_frame >= numFrames()) {
+		std::cerr << "ERR: GLTraceReplayer::replayFrame: frame " << _frame << " does not exist.\n";
+		return -1.0;
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+	s.position = size_t(s.frameOffsets[_frame]);
+	const size_t end = size_t(s.frameOffsets[_frame + 1]);
+	while(s.position < end && !s.error)
+	{
+		uint16_t id = s.read<uint16_t>();
+		if(id == MAPPED_WRITE)
+			s.replayMappedWrite();
+		else if(id < s.functions.size() && s.functions[id])
+			s.functions[id](s);
+		else {
+			std::cerr << "ERR: GLTraceReplayer: unknown function in the trace.\n";
+			s.error = true;
+		}
+	}
+	if(s.error) {
+		std::cerr << "ERR: GLTraceReplayer: trace is corrupt.\n";
+		return -1.0;
+	}
+	return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+void gpupro::GLTraceReplayer::setCallTiming(bool _enable)
+{
+	m_state->callTiming = _enable;
+}
+
+std::vector<gpupro::GLTraceReplayer::CallStats> gpupro::GLTraceReplayer::callStats() const
+{
+	std::vector<CallStats> stats;
+	for(size_t i = 0; i < NUM_FUNCTIONS; ++i)
+		if(m_state->numCalls[i])
+			stats.push_back(CallStats{ GLFunction(i), m_state->numCalls[i], m_state->totalTime[i], m_state->maxTime[i] });
+	std::sort(stats.begin(), stats.end(), [](const CallStats& _a, const CallStats& _b) {
+		return _a.totalTime > _b.totalTime || (_a.totalTime == _b.totalTime && _a.numCalls > _b.numCalls);
+	});
+	return stats;
+}
+
+void gpupro::GLTraceReplayer::resetStats()
+{
+	State& s = *m_state;
+	memset(s.numCalls, 0, sizeof(s.numCalls));
+	memset(s.totalTime, 0, sizeof(s.totalTime));
+	memset(s.maxTime, 0, sizeof(s.maxTime));
+	memset(s.warned, 0, sizeof(s.warned));
+}
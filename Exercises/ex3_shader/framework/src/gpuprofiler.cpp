@@ -0,0 +1,321 @@
+#include "gpuprofiler.hpp"
+#include "deletionqueue.hpp"
+#include "timeline.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+	struct Scope
+	{
+		std::string name;
+		int parent;
+		int depth;
+		std::vector<int> children;
+		std::vector<float> window;	///< Ring buffer of the last frames in ms
+		size_t nextSample;
+		double latest;
+	};
+
+	// One measured interval. begin and end are indices into the query pool
+	// of the frame.
+	struct Record
+	{
+		int scope;
+		GLuint begin, end;
+	};
+
+	struct Frame
+	{
+		std::vector<GLuint> queries;	///< Pool, grows with the number of scopes
+		GLuint numUsedQueries;
+		std::vector<Record> records;	///< The first one is the frame itself
+		bool pending;					///< Closed but not read yet
+	};
+
+	// Open scopes. Scopes started while the measurement was disabled have
+	// no record.
+	const int NO_RECORD = -1;
+
+}
+
+static bool s_enabled = false;
+static size_t s_windowSize = 240;
+static GLuint s_numDroppedFrames = 0;
+static std::vector<Scope> s_scopes;
+static Frame s_frames[gpupro::GpuProfiler::LATENCY];
+static GLuint s_currentFrame = 0;
+static std::vector<int> s_stack;
+static std::vector<double> s_frameSums;
+
+static int findScope(int _parent, const char* _name)
+{
+	if(s_scopes.empty())
+	{
+		Scope frame;
+		frame.name = "Frame";
+		frame.parent = -1;
+		frame.depth = 0;
+		frame.nextSample = 0;
+		frame.latest = 0.0;
+		s_scopes.push_back(std::move(frame));
+	}
+	if(_parent < 0)
+		return 0;
+
+	for(int child : s_scopes[_parent].children)
+		if(strcmp(s_scopes[child].name.c_str(), _name) == 0)
+			return child;
+
+	Scope scope;
+	scope.name = _name;
+	scope.parent = _parent;
+	scope.depth = s_scopes[_parent].depth + 1;
+	scope.nextSample = 0;
+	scope.latest = 0.0;
+	int index = static_cast<int>(s_scopes.size());
+	s_scopes.push_back(std::move(scope));
+	s_scopes[_parent].children.push_back(index);
+	return index;
+}
+
+// Issue a timestamp with the next query of the pool and return its index.
+static GLuint writeTimestamp(Frame& _frame)
+{
+	if(_frame.numUsedQueries == _frame.queries.size())
+	{
+		// Grow in batches, the first frames determine the size.
+		size_t oldSize = _frame.queries.size();
+		_frame.queries.resize(std::max<size_t>(oldSize * 2, 16));
+		glGenQueries(static_cast<GLsizei>(_frame.queries.size() - oldSize), _frame.queries.data() + oldSize);
+	}
+	glQueryCounter(_frame.queries[_frame.numUsedQueries], GL_TIMESTAMP);
+	return _frame.numUsedQueries++;
+}
+
+static void addSample(Scope& _scope, double _time)
+{
+	_scope.latest = _time;
+	if(_scope.window.size() < s_windowSize)
+		_scope.window.push_back(static_cast<float>(_time));
+	else
+		_scope.window[_scope.nextSample] = static_cast<float>(_time);
+	_scope.nextSample = (_scope.nextSample + 1) % s_windowSize;
+}
+
+// Read the results if the GPU is done with the frame.
+static bool collect(Frame& _frame)
+{
+	// Timestamps complete in order. If the last one (the end of the frame)
+	// is available, all others are as well.
+	GLuint available = 0;
+	glGetQueryObjectuiv(_frame.queries[_frame.numUsedQueries - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+	if(!available)
+		return false;
+
+	std::vector<GLuint64> timestamps(_frame.numUsedQueries, 0);
+	for(GLuint i = 0; i < _frame.numUsedQueries; ++i)
+		glGetQueryObjectui64v(_frame.queries[i], GL_QUERY_RESULT, &timestamps[i]);
+
+	s_frameSums.assign(s_scopes.size(), -1.0);
+	for(auto& record : _frame.records)
+	{
+		double time = (timestamps[record.end] - timestamps[record.begin]) / 1000000.0;
+		double& sum = s_frameSums[record.scope];
+		sum = sum < 0.0 ? time : sum + time;
+		gpupro::Timeline::addGpuZone(s_scopes[record.scope].name, timestamps[record.begin], timestamps[record.end]);
+	}
+	for(size_t i = 0; i < s_frameSums.size(); ++i)
+		if(s_frameSums[i] >= 0.0)
+			addSample(s_scopes[i], s_frameSums[i]);
+	return true;
+}
+
+static void releaseQueries()
+{
+	for(auto& frame : s_frames)
+	{
+		for(GLuint query : frame.queries)
+			gpupro::DeletionQueue::release(gpupro::DeletionQueue::ObjectType::QUERY, query);
+		frame.queries.clear();
+		frame.numUsedQueries = 0;
+		frame.records.clear();
+		frame.pending = false;
+	}
+	// The open scopes end without a measurement.
+	std::fill(s_stack.begin(), s_stack.end(), NO_RECORD);
+}
+
+void gpupro::GpuProfiler::setEnabled(bool _enable)
+{
+	if(s_enabled && !_enable)
+		releaseQueries();
+	s_enabled = _enable;
+}
+
+bool gpupro::GpuProfiler::isEnabled()
+{
+	return s_enabled;
+}
+
+void gpupro::GpuProfiler::setWindowSize(size_t _numFrames)
+{
+	if(_numFrames == 0)
+	{
+		std::cerr << "ERR: The window of the GpuProfiler must contain at least one frame.\n";
+		return;
+	}
+	s_windowSize = _numFrames;
+	// Start the windows again, the ring order would be wrong otherwise.
+	for(auto& scope : s_scopes)
+	{
+		scope.window.clear();
+		scope.nextSample = 0;
+	}
+}
+
+void gpupro::GpuProfiler::beginScope(const char* _name)
+{
+	glPushDebugGroup(GL_DEBUG_SOURCE_APPLICATION, 0, -1, _name);
+	if(!s_enabled)
+	{
+		s_stack.push_back(NO_RECORD);
+		return;
+	}
+
+	Frame& frame = s_frames[s_currentFrame];
+	if(frame.records.empty())
+	{
+		Record record = {findScope(-1, nullptr), writeTimestamp(frame), 0};
+		frame.records.push_back(record);
+	}
+	// Scopes without record (from the time before enabling) are skipped
+	// in the hierarchy.
+	int parent = 0;
+	for(auto it = s_stack.rbegin(); it != s_stack.rend(); ++it)
+		if(*it != NO_RECORD)
+		{
+			parent = frame.records[*it].scope;
+			break;
+		}
+	Record record = {findScope(parent, _name), writeTimestamp(frame), 0};
+	s_stack.push_back(static_cast<int>(frame.records.size()));
+	frame.records.push_back(record);
+}
+
+void gpupro::GpuProfiler::endScope()
+{
+	if(s_stack.empty())
+	{
+		std::cerr << "ERR: GpuProfiler::endScope() without beginScope().\n";
+		return;
+	}
+	int record = s_stack.back();
+	s_stack.pop_back();
+	if(record != NO_RECORD)
+	{
+		Frame& frame = s_frames[s_currentFrame];
+		frame.records[record].end = writeTimestamp(frame);
+	}
+	glPopDebugGroup();
+}
+
+void gpupro::GpuProfiler::endFrame()
+{
+	if(!s_enabled)
+		return;
+
+	Frame& frame = s_frames[s_currentFrame];
+	if(!frame.records.empty())
+	{
+		// Scopes must not span frames. Cut them at the end of the frame,
+		// they are not measured any further.
+		GLuint end = writeTimestamp(frame);
+		for(int& record : s_stack)
+			if(record != NO_RECORD)
+			{
+				std::cerr << "WAR: GPU scope " << s_scopes[frame.records[record].scope].name << " is still open at the end of the frame.\n";
+				frame.records[record].end = end;
+				record = NO_RECORD;
+			}
+		frame.records[0].end = end;
+		frame.pending = true;
+	}
+	s_currentFrame = (s_currentFrame + 1) % LATENCY;
+
+	// Collect in order, starting with the oldest frame (the next one).
+	for(GLuint i = 0; i < LATENCY; ++i)
+	{
+		Frame& oldFrame = s_frames[(s_currentFrame + i) % LATENCY];
+		if(!oldFrame.pending) continue;
+		if(!collect(oldFrame)) break;
+		oldFrame.pending = false;
+	}
+
+	Frame& next = s_frames[s_currentFrame];
+	if(next.pending)
+		++s_numDroppedFrames;
+	next.numUsedQueries = 0;
+	next.records.clear();
+	next.pending = false;
+}
+
+std::vector<gpupro::GpuProfiler::ScopeStatistics> gpupro::GpuProfiler::statistics()
+{
+	std::vector<ScopeStatistics> statistics;
+	if(s_scopes.empty())
+		return statistics;
+
+	std::vector<int> stack(1, 0);
+	std::vector<float> sorted;
+	while(!stack.empty())
+	{
+		const Scope& scope = s_scopes[stack.back()];
+		stack.pop_back();
+		stack.insert(stack.end(), scope.children.rbegin(), scope.children.rend());
+		if(scope.window.empty())
+			continue;
+
+		// Nearest rank percentiles
+		sorted = scope.window;
+		std::sort(sorted.begin(), sorted.end());
+		auto percentile = [&sorted](double _p) {
+			size_t rank = static_cast<size_t>(std::ceil(_p * sorted.size()));
+			return static_cast<double>(sorted[std::max<size_t>(rank, 1) - 1]);
+		};
+		ScopeStatistics entry;
+		entry.name = scope.name;
+		entry.depth = scope.depth;
+		entry.numSamples = sorted.size();
+		entry.latest = scope.latest;
+		entry.p50 = percentile(0.5);
+		entry.p95 = percentile(0.95);
+		entry.p99 = percentile(0.99);
+		statistics.push_back(std::move(entry));
+	}
+	return statistics;
+}
+
+void gpupro::GpuProfiler::printStatistics()
+{
+	std::cerr << "INF: GPU time in ms (p50 / p95 / p99) over the last " << s_windowSize << " frames:\n";
+	for(auto& scope : statistics())
+	{
+		std::string name = std::string(scope.depth * 2, ' ') + scope.name;
+		std::cerr << "  " << std::left << std::setw(32) << name << std::right << std::fixed << std::setprecision(3)
+			<< std::setw(9) << scope.p50 << std::setw(9) << scope.p95 << std::setw(9) << scope.p99
+			<< "  (" << scope.numSamples << " frames)\n";
+	}
+	std::cerr.unsetf(std::ios::floatfield);
+	if(s_numDroppedFrames)
+		std::cerr << "  " << s_numDroppedFrames << " frames dropped (results not available in time)\n";
+}
+
+GLuint gpupro::GpuProfiler::numDroppedFrames()
+{
+	return s_numDroppedFrames;
+}
@@ -1,4 +1,5 @@
 #include "model.hpp"
+#include "commandbuffer.hpp"
 
 using namespace glm;
 
@@ -31,3 +32,19 @@ void gpupro::Model::draw(DrawPrimitiveType _primType) const
 {
 	glDrawElements(static_cast<GLenum>(_primType), m_indices.numElements(), GL_UNSIGNED_INT, nullptr);
 }
+
+void gpupro::Model::bind(CommandBuffer& _commands, int _posBindIdx, int _tsBindIdx, int _texBindIdx)
+{
+	if(_posBindIdx >= 0)
+		_commands.bindVertexBuffer(_posBindIdx, m_positions);
+	if(_tsBindIdx >= 0)
+		_commands.bindVertexBuffer(_tsBindIdx, m_tangentSpaces);
+	if(_texBindIdx >= 0)
+		_commands.bindVertexBuffer(_texBindIdx, m_texCoords);
+	_commands.bindIndexBuffer(m_indices);
+}
+
+void gpupro::Model::draw(CommandBuffer& _commands, DrawPrimitiveType _primType) const
+{
+	_commands.drawIndexed(_primType, m_indices.numElements());
+}
@@ -0,0 +1,506 @@
+#include "nullgl.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+#include <unordered_map>
+
+using gpupro::NullGL;
+
+namespace {
+
+	const size_t NUM_FUNCTIONS = size_t(NullGL::Function::NUM_FUNCTIONS);
+
+	bool s_loaded = false;
+	bool s_recording = true;
+	std::vector<NullGL::Call> s_calls;
+	std::vector<GLuint64> s_arguments;
+	GLuint64 s_counts[NUM_FUNCTIONS];
+	GLuint64 s_numCalls = 0;
+	std::chrono::high_resolution_clock::time_point s_start;
+
+	// All objects share one name space, names are never reused.
+	GLuint s_nextName = 0;
+	GLuint64 s_nextHandle = 0;
+	// Memory returned by the map functions, per buffer name.
+	std::unordered_map<GLuint, std::vector<char>> s_bufferMemory;
+	// Buffer bindings for the non-DSA map functions.
+	std::unordered_map<GLenum, GLuint> s_boundBuffers;
+
+	template<typename T>
+	typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value, GLuint64>::type toWord(T _value)
+	{
+		return static_cast<GLuint64>(_value);
+	}
+
+	GLuint64 toWord(float _value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &_value, sizeof(bits));
+		return bits;
+	}
+
+	GLuint64 toWord(double _value)
+	{
+		GLuint64 bits;
+		memcpy(&bits, &_value, sizeof(bits));
+		return bits;
+	}
+
+	// Data and function pointers (GLDEBUGPROC)
+	template<typename T>
+	GLuint64 toWord(T* _pointer)
+	{
+		return static_cast<GLuint64>(reinterpret_cast<uintptr_t>(_pointer));
+	}
+
+	void record(NullGL::Function _function, std::initializer_list<GLuint64> _arguments)
+	{
+		++s_counts[size_t(_function)];
+		++s_numCalls;
+		if(!s_recording) return;
+
+		NullGL::Call call;
+		call.function = _function;
+		call.firstArgument = static_cast<GLuint>(s_arguments.size());
+		call.numArguments = static_cast<GLuint>(_arguments.size());
+		call.timestamp = static_cast<GLuint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::high_resolution_clock::now() - s_start).count());
+		s_arguments.insert(s_arguments.end(), _arguments.begin(), _arguments.end());
+		s_calls.push_back(call);
+	}
+
+	template<typename... Args>
+	void recordCall(NullGL::Function _function, Args... _args)
+	{
+		record(_function, { toWord(_args)... });
+	}
+
+	// Default for all functions: record and return 0/nothing.
+	template<NullGL::Function F, typename Fn> struct Stub;
+	template<NullGL::Function F, typename Ret, typename... Args>
+	struct Stub<F, Ret (APIENTRY*)(Args...)>
+	{
+		static Ret APIENTRY call(Args... _args)
+		{
+			recordCall(F, _args...);
+			return Ret();
+		}
+	};
+
+	// ********************************************************************* //
+	// Functions with plausible results
+
+	template<NullGL::Function F>
+	void APIENTRY genNames(GLsizei _n, GLuint* _names)
+	{
+		recordCall(F, _n, _names);
+		for(GLsizei i = 0; i < _n; ++i)
+			_names[i] = ++s_nextName;
+	}
+
+	template<NullGL::Function F>
+	void APIENTRY createNames(GLenum _target, GLsizei _n, GLuint* _names)
+	{
+		recordCall(F, _target, _n, _names);
+		for(GLsizei i = 0; i < _n; ++i)
+			_names[i] = ++s_nextName;
+	}
+
+	GLuint APIENTRY createProgram()
+	{
+		recordCall(NullGL::Function::glad_glCreateProgram);
+		return ++s_nextName;
+	}
+
+	GLuint APIENTRY createShader(GLenum _type)
+	{
+		recordCall(NullGL::Function::glad_glCreateShader, _type);
+		return ++s_nextName;
+	}
+
+	GLuint APIENTRY createShaderProgramv(GLenum _type, GLsizei _count, const GLchar* const* _strings)
+	{
+		recordCall(NullGL::Function::glad_glCreateShaderProgramv, _type, _count, _strings);
+		return ++s_nextName;
+	}
+
+	void APIENTRY deleteBuffers(GLsizei _n, const GLuint* _buffers)
+	{
+		recordCall(NullGL::Function::glad_glDeleteBuffers, _n, _buffers);
+		for(GLsizei i = 0; i < _n; ++i)
+			s_bufferMemory.erase(_buffers[i]);
+	}
+
+	GLsync APIENTRY fenceSync(GLenum _condition, GLbitfield _flags)
+	{
+		recordCall(NullGL::Function::glad_glFenceSync, _condition, _flags);
+		return reinterpret_cast<GLsync>(static_cast<uintptr_t>(++s_nextHandle));
+	}
+
+	GLenum APIENTRY clientWaitSync(GLsync _sync, GLbitfield _flags, GLuint64 _timeout)
+	{
+		recordCall(NullGL::Function::glad_glClientWaitSync, _sync, _flags, _timeout);
+		return GL_ALREADY_SIGNALED;
+	}
+
+	void APIENTRY getSynciv(GLsync _sync, GLenum _pname, GLsizei _bufSize, GLsizei* _length, GLint* _values)
+	{
+		recordCall(NullGL::Function::glad_glGetSynciv, _sync, _pname, _bufSize, _length, _values);
+		if(_length) *_length = 1;
+		if(_bufSize < 1) return;
+		switch(_pname)
+		{
+		case GL_OBJECT_TYPE: *_values = GL_SYNC_FENCE; break;
+		case GL_SYNC_STATUS: *_values = GL_SIGNALED; break;
+		case GL_SYNC_CONDITION: *_values = GL_SYNC_GPU_COMMANDS_COMPLETE; break;
+		default: *_values = 0;
+		}
+	}
+
+	GLenum APIENTRY checkFramebufferStatus(GLenum _target)
+	{
+		recordCall(NullGL::Function::glad_glCheckFramebufferStatus, _target);
+		return GL_FRAMEBUFFER_COMPLETE;
+	}
+
+	GLenum APIENTRY checkNamedFramebufferStatus(GLuint _framebuffer, GLenum _target)
+	{
+		recordCall(NullGL::Function::glad_glCheckNamedFramebufferStatus, _framebuffer, _target);
+		return GL_FRAMEBUFFER_COMPLETE;
+	}
+
+	// Shaders compile and programs link without any log.
+	template<NullGL::Function F>
+	void APIENTRY getObjectiv(GLuint _object, GLenum _pname, GLint* _params)
+	{
+		recordCall(F, _object, _pname, _params);
+		switch(_pname)
+		{
+		case GL_COMPILE_STATUS:
+		case GL_LINK_STATUS:
+		case GL_VALIDATE_STATUS:
+		case GL_COMPLETION_STATUS_KHR:
+			*_params = GL_TRUE; break;
+		default: *_params = 0;
+		}
+	}
+
+	template<NullGL::Function F>
+	void APIENTRY getInfoLog(GLuint _object, GLsizei _bufSize, GLsizei* _length, GLchar* _infoLog)
+	{
+		recordCall(F, _object, _bufSize, _length, _infoLog);
+		if(_length) *_length = 0;
+		if(_bufSize > 0) *_infoLog = '\0';
+	}
+
+	template<NullGL::Function F, typename T>
+	void APIENTRY getQueryObject(GLuint _id, GLenum _pname, T* _params)
+	{
+		recordCall(F, _id, _pname, _params);
+		*_params = _pname == GL_QUERY_RESULT_AVAILABLE ? T(GL_TRUE) : T(0);
+	}
+
+	// Limits of a typical 4.5 desktop GPU. Only single valued states are
+	// supported, everything else returns 0.
+	GLint64 integerState(GLenum _pname)
+	{
+		switch(_pname)
+		{
+		case GL_MAJOR_VERSION: return 4;
+		case GL_MINOR_VERSION: return 5;
+		case GL_CONTEXT_PROFILE_MASK: return GL_CONTEXT_CORE_PROFILE_BIT;
+		case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT: return 256;
+		case GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT: return 256;
+		case GL_MAX_UNIFORM_BLOCK_SIZE: return 65536;
+		case GL_MAX_UNIFORM_BUFFER_BINDINGS: return 84;
+		case GL_MAX_SHADER_STORAGE_BUFFER_BINDINGS: return 96;
+		case GL_MAX_SHADER_STORAGE_BLOCK_SIZE: return 1 << 27;
+		case GL_MAX_TEXTURE_IMAGE_UNITS: return 32;
+		case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS: return 192;
+		case GL_MAX_IMAGE_UNITS: return 8;
+		case GL_MAX_TEXTURE_SIZE: return 16384;
+		case GL_MAX_3D_TEXTURE_SIZE: return 2048;
+		case GL_MAX_ARRAY_TEXTURE_LAYERS: return 2048;
+		case GL_MAX_CUBE_MAP_TEXTURE_SIZE: return 16384;
+		case GL_MAX_RENDERBUFFER_SIZE: return 16384;
+		case GL_MAX_COLOR_ATTACHMENTS: return 8;
+		case GL_MAX_DRAW_BUFFERS: return 8;
+		case GL_MAX_SAMPLES: return 8;
+		case GL_MAX_VERTEX_ATTRIBS: return 16;
+		case GL_MAX_VERTEX_ATTRIB_BINDINGS: return 16;
+		case GL_MAX_VERTEX_ATTRIB_STRIDE: return 2048;
+		case GL_MAX_VIEWPORTS: return 16;
+		case GL_MAX_COMPUTE_SHARED_MEMORY_SIZE: return 32768;
+		case GL_MAX_COMPUTE_WORK_GROUP_INVOCATIONS: return 1024;
+		case GL_MAX_DEBUG_MESSAGE_LENGTH: return 1024;
+		case GL_MAX_LABEL_LENGTH: return 256;
+		case GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT: return 16;
+		default: return 0;
+		}
+	}
+
+	void APIENTRY getIntegerv(GLenum _pname, GLint* _data)
+	{
+		recordCall(NullGL::Function::glad_glGetIntegerv, _pname, _data);
+		*_data = static_cast<GLint>(integerState(_pname));
+	}
+
+	void APIENTRY getInteger64v(GLenum _pname, GLint64* _data)
+	{
+		recordCall(NullGL::Function::glad_glGetInteger64v, _pname, _data);
+		*_data = integerState(_pname);
+	}
+
+	void APIENTRY getFloatv(GLenum _pname, GLfloat* _data)
+	{
+		recordCall(NullGL::Function::glad_glGetFloatv, _pname, _data);
+		*_data = static_cast<GLfloat>(integerState(_pname));
+	}
+
+	void APIENTRY getBooleanv(GLenum _pname, GLboolean* _data)
+	{
+		recordCall(NullGL::Function::glad_glGetBooleanv, _pname, _data);
+		*_data = integerState(_pname) ? GL_TRUE : GL_FALSE;
+	}
+
+	const GLubyte* APIENTRY getString(GLenum _name)
+	{
+		recordCall(NullGL::Function::glad_glGetString, _name);
+		switch(_name)
+		{
+		case GL_VENDOR: return reinterpret_cast<const GLubyte*>("gpupro");
+		case GL_RENDERER: return reinterpret_cast<const GLubyte*>("NullGL");
+		case GL_VERSION: return reinterpret_cast<const GLubyte*>("4.5.0 NullGL");
+		case GL_SHADING_LANGUAGE_VERSION: return reinterpret_cast<const GLubyte*>("4.50 NullGL");
+		default: return reinterpret_cast<const GLubyte*>("");
+		}
+	}
+
+	const GLubyte* APIENTRY getStringi(GLenum _name, GLuint _index)
+	{
+		recordCall(NullGL::Function::glad_glGetStringi, _name, _index);
+		return reinterpret_cast<const GLubyte*>("");
+	}
+
+	void* mapMemory(GLuint _buffer, GLintptr _offset, GLsizeiptr _length)
+	{
+		// A buffer cannot be mapped twice, so resizing does not invalidate
+		// a previous mapping.
+		std::vector<char>& memory = s_bufferMemory[_buffer];
+		if(memory.size() < size_t(_offset + _length))
+			memory.resize(size_t(_offset + _length));
+		return memory.data() + _offset;
+	}
+
+	void* APIENTRY mapBufferRange(GLenum _target, GLintptr _offset, GLsizeiptr _length, GLbitfield _access)
+	{
+		recordCall(NullGL::Function::glad_glMapBufferRange, _target, _offset, _length, _access);
+		return mapMemory(s_boundBuffers[_target], _offset, _length);
+	}
+
+	void* APIENTRY mapNamedBufferRange(GLuint _buffer, GLintptr _offset, GLsizeiptr _length, GLbitfield _access)
+	{
+		recordCall(NullGL::Function::glad_glMapNamedBufferRange, _buffer, _offset, _length, _access);
+		return mapMemory(_buffer, _offset, _length);
+	}
+
+	GLboolean APIENTRY unmapBuffer(GLenum _target)
+	{
+		recordCall(NullGL::Function::glad_glUnmapBuffer, _target);
+		return GL_TRUE;
+	}
+
+	GLboolean APIENTRY unmapNamedBuffer(GLuint _buffer)
+	{
+		recordCall(NullGL::Function::glad_glUnmapNamedBuffer, _buffer);
+		return GL_TRUE;
+	}
+
+	void APIENTRY bindBuffer(GLenum _target, GLuint _buffer)
+	{
+		recordCall(NullGL::Function::glad_glBindBuffer, _target, _buffer);
+		s_boundBuffers[_target] = _buffer;
+	}
+
+	void APIENTRY bindBufferBase(GLenum _target, GLuint _index, GLuint _buffer)
+	{
+		recordCall(NullGL::Function::glad_glBindBufferBase, _target, _index, _buffer);
+		s_boundBuffers[_target] = _buffer;
+	}
+
+	void APIENTRY bindBufferRange(GLenum _target, GLuint _index, GLuint _buffer, GLintptr _offset, GLsizeiptr _size)
+	{
+		recordCall(NullGL::Function::glad_glBindBufferRange, _target, _index, _buffer, _offset, _size);
+		s_boundBuffers[_target] = _buffer;
+	}
+
+	GLuint64 APIENTRY getTextureHandle(GLuint _texture)
+	{
+		recordCall(NullGL::Function::glad_glGetTextureHandleARB, _texture);
+		return ++s_nextHandle;
+	}
+
+	GLuint64 APIENTRY getTextureSamplerHandle(GLuint _texture, GLuint _sampler)
+	{
+		recordCall(NullGL::Function::glad_glGetTextureSamplerHandleARB, _texture, _sampler);
+		return ++s_nextHandle;
+	}
+
+	GLuint64 APIENTRY getImageHandle(GLuint _texture, GLint _level, GLboolean _layered, GLint _layer, GLenum _format)
+	{
+		recordCall(NullGL::Function::glad_glGetImageHandleARB, _texture, _level, _layered, _layer, _format);
+		return ++s_nextHandle;
+	}
+
+} // namespace
+
+void gpupro::NullGL::load()
+{
+	// Record everything
+	#define GL_FUNCTION(name, type, params) name = &Stub<Function::name, type>::call;
+	#include "glfunctions.inl"
+	#undef GL_FUNCTION
+
+	// Object names and handles
+	glad_glGenBuffers = &genNames<Function::glad_glGenBuffers>;
+	glad_glGenTextures = &genNames<Function::glad_glGenTextures>;
+	glad_glGenSamplers = &genNames<Function::glad_glGenSamplers>;
+	glad_glGenVertexArrays = &genNames<Function::glad_glGenVertexArrays>;
+	glad_glGenFramebuffers = &genNames<Function::glad_glGenFramebuffers>;
+	glad_glGenRenderbuffers = &genNames<Function::glad_glGenRenderbuffers>;
+	glad_glGenQueries = &genNames<Function::glad_glGenQueries>;
+	glad_glGenProgramPipelines = &genNames<Function::glad_glGenProgramPipelines>;
+	glad_glGenTransformFeedbacks = &genNames<Function::glad_glGenTransformFeedbacks>;
+	glad_glCreateBuffers = &genNames<Function::glad_glCreateBuffers>;
+	glad_glCreateSamplers = &genNames<Function::glad_glCreateSamplers>;
+	glad_glCreateVertexArrays = &genNames<Function::glad_glCreateVertexArrays>;
+	glad_glCreateFramebuffers = &genNames<Function::glad_glCreateFramebuffers>;
+	glad_glCreateRenderbuffers = &genNames<Function::glad_glCreateRenderbuffers>;
+	glad_glCreateProgramPipelines = &genNames<Function::glad_glCreateProgramPipelines>;
+	glad_glCreateTransformFeedbacks = &genNames<Function::glad_glCreateTransformFeedbacks>;
+	glad_glCreateTextures = &createNames<Function::glad_glCreateTextures>;
+	glad_glCreateQueries = &createNames<Function::glad_glCreateQueries>;
+	glad_glCreateProgram = &createProgram;
+	glad_glCreateShader = &createShader;
+	glad_glCreateShaderProgramv = &createShaderProgramv;
+	glad_glDeleteBuffers = &deleteBuffers;
+	glad_glGetTextureHandleARB = &getTextureHandle;
+	glad_glGetTextureSamplerHandleARB = &getTextureSamplerHandle;
+	glad_glGetImageHandleARB = &getImageHandle;
+
+	// Synchronization: the "GPU" is always done.
+	glad_glFenceSync = &fenceSync;
+	glad_glClientWaitSync = &clientWaitSync;
+	glad_glGetSynciv = &getSynciv;
+	glad_glGetQueryObjectiv = &getQueryObject<Function::glad_glGetQueryObjectiv, GLint>;
+	glad_glGetQueryObjectuiv = &getQueryObject<Function::glad_glGetQueryObjectuiv, GLuint>;
+	glad_glGetQueryObjecti64v = &getQueryObject<Function::glad_glGetQueryObjecti64v, GLint64>;
+	glad_glGetQueryObjectui64v = &getQueryObject<Function::glad_glGetQueryObjectui64v, GLuint64>;
+
+	// Object states
+	glad_glCheckFramebufferStatus = &checkFramebufferStatus;
+	glad_glCheckNamedFramebufferStatus = &checkNamedFramebufferStatus;
+	glad_glGetShaderiv = &getObjectiv<Function::glad_glGetShaderiv>;
+	glad_glGetProgramiv = &getObjectiv<Function::glad_glGetProgramiv>;
+	glad_glGetShaderInfoLog = &getInfoLog<Function::glad_glGetShaderInfoLog>;
+	glad_glGetProgramInfoLog = &getInfoLog<Function::glad_glGetProgramInfoLog>;
+
+	// Context states
+	glad_glGetIntegerv = &getIntegerv;
+	glad_glGetInteger64v = &getInteger64v;
+	glad_glGetFloatv = &getFloatv;
+	glad_glGetBooleanv = &getBooleanv;
+	glad_glGetString = &getString;
+	glad_glGetStringi = &getStringi;
+
+	// Buffer mapping
+	glad_glMapBufferRange = &mapBufferRange;
+	glad_glMapNamedBufferRange = &mapNamedBufferRange;
+	glad_glUnmapBuffer = &unmapBuffer;
+	glad_glUnmapNamedBuffer = &unmapNamedBuffer;
+	glad_glBindBuffer = &bindBuffer;
+	glad_glBindBufferBase = &bindBufferBase;
+	glad_glBindBufferRange = &bindBufferRange;
+
+	GLVersion.major = 4;
+	GLVersion.minor = 5;
+	GLAD_GL_VERSION_1_0 = GLAD_GL_VERSION_1_1 = GLAD_GL_VERSION_1_2 = GLAD_GL_VERSION_1_3 = 1;
+	GLAD_GL_VERSION_1_4 = GLAD_GL_VERSION_1_5 = GLAD_GL_VERSION_2_0 = GLAD_GL_VERSION_2_1 = 1;
+	GLAD_GL_VERSION_3_0 = GLAD_GL_VERSION_3_1 = GLAD_GL_VERSION_3_2 = GLAD_GL_VERSION_3_3 = 1;
+	GLAD_GL_VERSION_4_0 = GLAD_GL_VERSION_4_1 = GLAD_GL_VERSION_4_2 = GLAD_GL_VERSION_4_3 = 1;
+	GLAD_GL_VERSION_4_4 = GLAD_GL_VERSION_4_5 = 1;
+	GLAD_GL_ARB_bindless_texture = 1;
+	GLAD_GL_EXT_debug_label = 1;
+	GLAD_GL_EXT_debug_marker = 1;
+	GLAD_GL_EXT_texture_filter_anisotropic = 1;
+	GLAD_GL_ARB_parallel_shader_compile = 1;
+	GLAD_GL_KHR_parallel_shader_compile = 1;
+	GLAD_GL_ARB_pipeline_statistics_query = 1;
+
+	s_loaded = true;
+	s_start = std::chrono::high_resolution_clock::now();
+	s_bufferMemory.clear();
+	s_boundBuffers.clear();
+	reset();
+}
+
+bool gpupro::NullGL::isLoaded()
+{
+	return s_loaded;
+}
+
+void gpupro::NullGL::setRecording(bool _enable)
+{
+	s_recording = _enable;
+}
+
+void gpupro::NullGL::reset()
+{
+	s_calls.clear();
+	s_arguments.clear();
+	memset(s_counts, 0, sizeof(s_counts));
+	s_numCalls = 0;
+}
+
+const std::vector<NullGL::Call>& gpupro::NullGL::calls()
+{
+	return s_calls;
+}
+
+const GLuint64* gpupro::NullGL::arguments(const Call& _call)
+{
+	return s_arguments.data() + _call.firstArgument;
+}
+
+float gpupro::NullGL::argumentAsFloat(GLuint64 _argument)
+{
+	uint32_t bits = static_cast<uint32_t>(_argument);
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+double gpupro::NullGL::argumentAsDouble(GLuint64 _argument)
+{
+	double value;
+	memcpy(&value, &_argument, sizeof(value));
+	return value;
+}
+
+GLuint64 gpupro::NullGL::numCalls(Function _function)
+{
+	return s_counts[size_t(_function)];
+}
+
+GLuint64 gpupro::NullGL::numCalls()
+{
+	return s_numCalls;
+}
+
+const char* gpupro::NullGL::name(Function _function)
+{
+	return glFunctionName(_function);
+}
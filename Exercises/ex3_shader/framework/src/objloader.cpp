@@ -1,5 +1,6 @@
 /* Generated by re2c 0.16 on Fri Oct 14 09:43:20 2016 */
 #include "objloader.hpp"
+#include "timeline.hpp"
 
 #include <iostream>
 #include <unordered_map>
@@ -241,6 +242,7 @@ yy47:
 // http://www.opengl-tutorial.org/beginners-tutorials/tutorial-7-model-loading/
 void gpupro::OBJLoader::load(const char* _fileName, bool _computeTangentSpace)
 {
+	CPU_ZONE("OBJLoader::load");
 	m_positions.clear();
 	m_tangentSpaces.clear();
 	m_texCoords.clear();
@@ -1,4 +1,5 @@
 #include "objloader.hpp"
+#include "timeline.hpp"
 
 #include <iostream>
 #include <unordered_map>
@@ -113,6 +114,7 @@ static void parseIndices(const unsigned char * _string, ivec3& _vertexIndex, ive
 // http://www.opengl-tutorial.org/beginners-tutorials/tutorial-7-model-loading/
 void gpupro::OBJLoader::load(const char* _fileName, bool _computeTangentSpace)
 {
+	CPU_ZONE("OBJLoader::load");
 	m_positions.clear();
 	m_tangentSpaces.clear();
 	m_texCoords.clear();
@@ -0,0 +1,210 @@
+#include "occlusionculler.hpp"
+#include "context.hpp"
+#include "programcache.hpp"
+#include "timeline.hpp"
+#include "vertexformat.hpp"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <iostream>
+
+using namespace glm;
+
+static const char* BOX_VERTEX_SHADER =
+	"#version 440 core\n"
+	"layout(location = 0) in vec3 in_position;\n"
+	"uniform mat4 u_boxToClip;\n"
+	"void main() { gl_Position = u_boxToClip * vec4(in_position, 1.0); }\n";
+// Only the depth test matters, there are no color writes.
+static const char* BOX_FRAGMENT_SHADER =
+	"#version 440 core\n"
+	"layout(early_fragment_tests) in;\n"
+	"void main() {}\n";
+
+// Unit cube: corner i is (i & 1, (i >> 1) & 1, (i >> 2) & 1).
+static const GLuint BOX_INDICES[36] = {
+	0, 2, 1,  1, 2, 3,	// z = 0
+	4, 5, 6,  5, 7, 6,	// z = 1
+	0, 1, 4,  1, 5, 4,	// y = 0
+	2, 6, 3,  3, 6, 7,	// y = 1
+	0, 4, 2,  2, 4, 6,	// x = 0
+	1, 3, 5,  3, 7, 5	// x = 1
+};
+
+static std::vector<vec3> boxCorners()
+{
+	std::vector<vec3> corners;
+	for(int i = 0; i < 8; ++i)
+		corners.push_back(vec3(float(i & 1), float((i >> 1) & 1), float((i >> 2) & 1)));
+	return corners;
+}
+
+// True if a part of the box is in front of the near plane or behind the
+// camera. The box would be clipped and may report 0 samples even though
+// the camera is inside the object.
+static bool intersectsNearPlane(const mat4& _boxToClip)
+{
+	for(int i = 0; i < 8; ++i)
+	{
+		vec4 clip = _boxToClip * vec4(float(i & 1), float((i >> 1) & 1), float((i >> 2) & 1), 1.0f);
+		if(clip.z < -clip.w || clip.w <= 0.0f)
+			return true;
+	}
+	return false;
+}
+
+gpupro::OcclusionCuller::OcclusionCuller(Query::Type _type) :
+	m_type(_type),
+	m_boxVertices(Buffer::Type::VERTEX, static_cast<GLuint>(sizeof(vec3)), 8, Buffer::Usage(), boxCorners().data()),
+	m_boxIndices(Buffer::Type::INDEX, 4, 36, Buffer::Usage(), BOX_INDICES),
+	m_frame(0)
+{
+	if(_type != Query::Type::SAMPLES_PASSED && _type != Query::Type::ANY_SAMPLES_PASSED
+		&& _type != Query::Type::ANY_SAMPLES_PASSED_CONSERVATIVE)
+	{
+		std::cerr << "ERR: OcclusionCuller needs an occlusion query type. Using ANY_SAMPLES_PASSED_CONSERVATIVE.\n";
+		m_type = Query::Type::ANY_SAMPLES_PASSED_CONSERVATIVE;
+	}
+
+	m_boxProgram = ProgramCache::get({
+		{Shader::Type::VERTEX, BOX_VERTEX_SHADER, "occlusion box"},
+		{Shader::Type::FRAGMENT, BOX_FRAGMENT_SHADER, "occlusion box"}
+	});
+	m_boxToClipLocation = m_boxProgram.uniformLocation("u_boxToClip");
+
+	VertexAttribute position = {0, 0, 3, VertexAttribute::Type::FLOAT, GL_FALSE, 0, 0};
+	m_boxFormat = VertexFormatCache::get(std::vector<VertexAttribute>(1, position));
+
+	Pipeline pipeline;
+	pipeline.rasterizer.cullMode = RasterizerState::CullMode::NONE;
+	pipeline.rasterizer.colorWrite = false;
+	pipeline.depthStencil.depthTest = true;
+	pipeline.depthStencil.depthWrite = false;
+	pipeline.shader = &m_boxProgram;
+	pipeline.vertexFormat = m_boxFormat.get();
+	m_boxPipeline.reset(new CompiledPipeline(pipeline));
+}
+
+GLuint gpupro::OcclusionCuller::addObject(const vec3& _bbMin, const vec3& _bbMax)
+{
+	Object object;
+	for(GLuint i = 0; i < LATENCY; ++i)
+	{
+		object.queries.emplace_back(m_type);
+		object.issued[i] = 0;
+	}
+	object.resultFrame = 0;
+	object.visible = true;
+	object.box = translate(mat4(1.0f), _bbMin) * scale(mat4(1.0f), _bbMax - _bbMin);
+	m_objects.push_back(std::move(object));
+	return static_cast<GLuint>(m_objects.size() - 1);
+}
+
+void gpupro::OcclusionCuller::submit(GLuint _object, const mat4& _world, const CompiledPipeline& _pipeline, const BindingTable* _bindings,
+	std::function<void()> _draw)
+{
+	if(_object >= m_objects.size())
+	{
+		std::cerr << "ERR: Unknown object " << _object << " in OcclusionCuller::submit().\n";
+		return;
+	}
+	Draw draw = {_object, _world * m_objects[_object].box, &_pipeline, _bindings, std::move(_draw)};
+	m_draws.push_back(std::move(draw));
+}
+
+// Read all available results in the order they were issued. Stops at the
+// first one which is not ready, later ones cannot be ready either.
+void gpupro::OcclusionCuller::readResults(Object& _object)
+{
+	for(GLuint n = 0; n < LATENCY; ++n)
+	{
+		GLuint oldest = 0;
+		for(GLuint i = 1; i < LATENCY; ++i)
+			if(_object.issued[i] && (!_object.issued[oldest] || _object.issued[i] < _object.issued[oldest]))
+				oldest = i;
+		if(!_object.issued[oldest] || !_object.queries[oldest].available())
+			return;
+		_object.queries[oldest].receive();
+		_object.visible = _object.queries[oldest].latest() > 0.0;
+		_object.resultFrame = _object.issued[oldest];
+		_object.issued[oldest] = 0;
+	}
+}
+
+void gpupro::OcclusionCuller::draw(OGLContext& _context, const Draw& _draw)
+{
+	_context.setState(*_draw.pipeline);
+	if(_draw.bindings)
+		_context.setBindings(*_draw.bindings);
+	_draw.draw();
+}
+
+void gpupro::OcclusionCuller::execute(OGLContext& _context, const mat4& _viewProjection)
+{
+	CPU_ZONE("OcclusionCuller::execute");
+	m_stats = Stats();
+	m_stats.numSubmitted = static_cast<GLuint>(m_draws.size());
+	++m_frame;
+	const GLuint slot = m_frame % LATENCY;
+
+	// Phase 1: everything which was visible (or is new)
+	std::vector<bool> drawn(m_draws.size(), false);
+	std::vector<bool> tested(m_draws.size(), false);
+	for(size_t i = 0; i < m_draws.size(); ++i)
+	{
+		Object& object = m_objects[m_draws[i].object];
+		readResults(object);
+		if(!object.visible)
+			++m_stats.numHiddenLastFrame;
+		if(object.visible || object.resultFrame == 0)
+		{
+			draw(_context, m_draws[i]);
+			drawn[i] = true;
+		}
+	}
+
+	// Phase 2: test all boxes against the depth buffer of phase 1. A
+	// pending query in the slot was not read in time, its result is lost.
+	_context.setState(*m_boxPipeline);
+	m_boxVertices.bindAsVertexBuffer(0);
+	m_boxIndices.bindAsIndexBuffer();
+	for(size_t i = 0; i < m_draws.size(); ++i)
+	{
+		Object& object = m_objects[m_draws[i].object];
+		mat4 boxToClip = _viewProjection * m_draws[i].boxToWorld;
+		if(intersectsNearPlane(boxToClip))
+		{
+			// Counts as visible, draw it in the next frame directly.
+			object.visible = true;
+			object.issued[slot] = 0;
+			continue;
+		}
+		m_boxProgram.setUniform(m_boxToClipLocation, boxToClip);
+		object.queries[slot].begin();
+		glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, nullptr);
+		object.queries[slot].end();
+		object.issued[slot] = m_frame;
+		tested[i] = true;
+		++m_stats.numTested;
+	}
+
+	// Phase 3: the GPU draws the hidden ones if their box passed.
+	for(size_t i = 0; i < m_draws.size(); ++i)
+	{
+		if(drawn[i]) continue;
+		if(!tested[i])
+		{
+			draw(_context, m_draws[i]);
+			continue;
+		}
+		const GLuint query = m_objects[m_draws[i].object].queries[slot].glID();
+		_context.setState(*m_draws[i].pipeline);
+		if(m_draws[i].bindings)
+			_context.setBindings(*m_draws[i].bindings);
+		glBeginConditionalRender(query, GL_QUERY_WAIT);
+		m_draws[i].draw();
+		glEndConditionalRender();
+		++m_stats.numConditional;
+	}
+	m_stats.numDrawnVisible = m_stats.numSubmitted - m_stats.numConditional;
+	m_draws.clear();
+}
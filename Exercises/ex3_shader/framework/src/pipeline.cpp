@@ -1,4 +1,67 @@
 #include "pipeline.hpp"
+#include "deletionqueue.hpp"
+#include <cstring>
+#include <unordered_map>
+
+bool gpupro::SamplerState::Desc::operator == (const Desc& _rhs) const
+{
+	return minFilter == _rhs.minFilter
+		&& magFilter == _rhs.magFilter
+		&& mipFilter == _rhs.mipFilter
+		&& maxAnisotropy == _rhs.maxAnisotropy
+		&& depthCmpFunc == _rhs.depthCmpFunc
+		&& borderHandling == _rhs.borderHandling
+		&& memcmp(borderColor, _rhs.borderColor, sizeof(borderColor)) == 0;
+}
+
+GLuint64 gpupro::SamplerState::Desc::hash() const
+{
+	// FNV-1a over all parameters
+	GLuint64 hash = 0xcbf29ce484222325ull;
+	auto hashValue = [&hash](GLuint64 _value) {
+		for(int i = 0; i < 8; ++i)
+		{
+			hash ^= (_value >> (i * 8)) & 0xff;
+			hash *= 0x100000001b3ull;
+		}
+	};
+	GLuint bits;
+	hashValue(static_cast<GLuint64>(minFilter) | (static_cast<GLuint64>(magFilter) << 16)
+		| (static_cast<GLuint64>(mipFilter) << 32));
+	hashValue(static_cast<GLuint64>(depthCmpFunc) | (static_cast<GLuint64>(borderHandling) << 32));
+	memcpy(&bits, &maxAnisotropy, sizeof(bits));
+	hashValue(bits);
+	for(int i = 0; i < 4; ++i)
+	{
+		memcpy(&bits, &borderColor[i], sizeof(bits));
+		hashValue(bits);
+	}
+	return hash;
+}
+
+static gpupro::SamplerState::Desc makeSamplerDesc(
+	gpupro::SamplerState::Filter _minFilter,
+	gpupro::SamplerState::Filter _magFilter,
+	gpupro::SamplerState::Filter _mipFilter,
+	float _maxAnisotropy,
+	gpupro::SamplerState::DepthCompareFunc _depthCmpFunc,
+	gpupro::SamplerState::BorderHandling _borderHandling,
+	const float _borderColor[4]
+)
+{
+	gpupro::SamplerState::Desc desc;
+	desc.minFilter = _minFilter;
+	desc.magFilter = _magFilter;
+	desc.mipFilter = _mipFilter;
+	// All values <= 1 disable anisotropic filtering. Store one value such
+	// that they map to the same cached sampler.
+	desc.maxAnisotropy = _maxAnisotropy > 1.0f ? _maxAnisotropy : 1.0f;
+	desc.depthCmpFunc = _depthCmpFunc;
+	desc.borderHandling = _borderHandling;
+	if(_borderColor)
+		memcpy(desc.borderColor, _borderColor, sizeof(desc.borderColor));
+	return desc;
+}
 
 gpupro::SamplerState::SamplerState(
 	Filter _minFilter,
@@ -8,74 +71,205 @@ gpupro::SamplerState::SamplerState(
 	DepthCompareFunc _depthCmpFunc,
 	BorderHandling _borderHandling,
 	float _borderColor[4]
-)
-#ifdef DEBUG
-	: m_minFilter(_minFilter),
-	m_magFilter(_magFilter),
-	m_mipFilter(_mipFilter),
-	m_depthCmpFunc(_depthCmpFunc),
-	m_borderHandling(_borderHandling)
-#endif
+) :
+	SamplerState(makeSamplerDesc(_minFilter, _magFilter, _mipFilter, _maxAnisotropy, _depthCmpFunc, _borderHandling, _borderColor))
 {
-	glGenSamplers(1, &m_id);
+}
 
-	glSamplerParameteri(m_id, GL_TEXTURE_WRAP_R, static_cast<GLint>(_borderHandling));
-	glSamplerParameteri(m_id, GL_TEXTURE_WRAP_S, static_cast<GLint>(_borderHandling));
-	glSamplerParameteri(m_id, GL_TEXTURE_WRAP_T, static_cast<GLint>(_borderHandling));
+gpupro::SamplerState::SamplerState(const Desc& _desc) :
+	m_desc(_desc)
+{
+	if(hasDSA())
+		glCreateSamplers(1, &m_id);
+	else
+		glGenSamplers(1, &m_id);
 
-	if(_mipFilter ==  Filter::NONE)
-		glSamplerParameteri(m_id, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(_minFilter));
+	glSamplerParameteri(m_id, GL_TEXTURE_WRAP_R, static_cast<GLint>(_desc.borderHandling));
+	glSamplerParameteri(m_id, GL_TEXTURE_WRAP_S, static_cast<GLint>(_desc.borderHandling));
+	glSamplerParameteri(m_id, GL_TEXTURE_WRAP_T, static_cast<GLint>(_desc.borderHandling));
+
+	if(_desc.mipFilter ==  Filter::NONE)
+		glSamplerParameteri(m_id, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(_desc.minFilter));
 	else
-		glSamplerParameteri(m_id, GL_TEXTURE_MIN_FILTER, _minFilter == Filter::NEAREST ?
-			(_mipFilter == Filter::NEAREST ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST_MIPMAP_LINEAR) : 
-			(_mipFilter == Filter::NEAREST ? GL_LINEAR_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR)
+		glSamplerParameteri(m_id, GL_TEXTURE_MIN_FILTER, _desc.minFilter == Filter::NEAREST ?
+			(_desc.mipFilter == Filter::NEAREST ? GL_NEAREST_MIPMAP_NEAREST : GL_NEAREST_MIPMAP_LINEAR) : 
+			(_desc.mipFilter == Filter::NEAREST ? GL_LINEAR_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR)
 		);
-	glSamplerParameteri(m_id, GL_TEXTURE_MAG_FILTER, static_cast<GLint>(_magFilter));
+	glSamplerParameteri(m_id, GL_TEXTURE_MAG_FILTER, static_cast<GLint>(_desc.magFilter));
 
-	if(_maxAnisotropy > 1.0f)
-		glSamplerParameterf(m_id, GL_TEXTURE_MAX_ANISOTROPY_EXT, _maxAnisotropy);
+	if(_desc.maxAnisotropy > 1.0f)
+		glSamplerParameterf(m_id, GL_TEXTURE_MAX_ANISOTROPY_EXT, _desc.maxAnisotropy);
 
-	if(_depthCmpFunc != DepthCompareFunc::DISABLE)
+	if(_desc.depthCmpFunc != DepthCompareFunc::DISABLE)
 	{
 		glSamplerParameteri(m_id, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
-		glSamplerParameteri(m_id, GL_TEXTURE_COMPARE_FUNC, static_cast<GLint>(_depthCmpFunc));
+		glSamplerParameteri(m_id, GL_TEXTURE_COMPARE_FUNC, static_cast<GLint>(_desc.depthCmpFunc));
 	}
 
-	if(_borderColor)
-		glSamplerParameterfv(m_id, GL_TEXTURE_BORDER_COLOR, _borderColor);
+	// The initial border color is (0,0,0,0).
+	const float black[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	if(memcmp(_desc.borderColor, black, sizeof(black)) != 0)
+		glSamplerParameterfv(m_id, GL_TEXTURE_BORDER_COLOR, _desc.borderColor);
 }
 
 gpupro::SamplerState::~SamplerState()
 {
-	glDeleteSamplers(1, &m_id);
+	DeletionQueue::release(DeletionQueue::ObjectType::SAMPLER, m_id);
 }
 
 gpupro::SamplerState::SamplerState(SamplerState&& _rhs) :
-	m_id(_rhs.m_id)
-#ifdef DEBUG
-	, m_minFilter(_rhs.m_minFilter),
-	m_magFilter(_rhs.m_magFilter),
-	m_mipFilter(_rhs.m_mipFilter),
-	m_depthCmpFunc(_rhs.m_depthCmpFunc),
-	m_borderHandling(_rhs.m_borderHandling)
-#endif
+	m_id(_rhs.m_id),
+	m_desc(_rhs.m_desc)
 {
 	_rhs.m_id = 0;
 }
 
 gpupro::SamplerState& gpupro::SamplerState::operator=(SamplerState&& _rhs)
 {
-	glDeleteSamplers(1, &m_id);
+	DeletionQueue::release(DeletionQueue::ObjectType::SAMPLER, m_id);
 
 	m_id = _rhs.m_id;
-#ifdef DEBUG
-	m_minFilter = _rhs.m_minFilter;
-	m_magFilter = _rhs.m_magFilter;
-	m_mipFilter = _rhs.m_mipFilter;
-	m_depthCmpFunc = _rhs.m_depthCmpFunc;
-	m_borderHandling = _rhs.m_borderHandling;
-#endif
+	m_desc = _rhs.m_desc;
 	_rhs.m_id = 0;
 
 	return *this;
 }
+
+
+// The cache only holds weak references. Expired entries are replaced when
+// the same descriptor is requested again. The number of distinct
+// descriptors in an application is small, so they are never erased.
+struct SamplerDescHash
+{
+	size_t operator()(const gpupro::SamplerState::Desc& _desc) const { return static_cast<size_t>(_desc.hash()); }
+};
+static std::unordered_map<gpupro::SamplerState::Desc, std::weak_ptr<gpupro::SamplerState>, SamplerDescHash> s_samplerCache;
+
+std::shared_ptr<gpupro::SamplerState> gpupro::SamplerCache::get(const SamplerState::Desc& _desc)
+{
+	// Normalize the anisotropy as the SamplerState constructor does.
+	SamplerState::Desc desc = _desc;
+	if(desc.maxAnisotropy < 1.0f)
+		desc.maxAnisotropy = 1.0f;
+
+	std::weak_ptr<SamplerState>& entry = s_samplerCache[desc];
+	std::shared_ptr<SamplerState> sampler = entry.lock();
+	if(!sampler)
+	{
+		sampler = std::make_shared<SamplerState>(desc);
+		entry = sampler;
+	}
+	return sampler;
+}
+
+std::shared_ptr<gpupro::SamplerState> gpupro::SamplerCache::get(
+	SamplerState::Filter _minFilter,
+	SamplerState::Filter _magFilter,
+	SamplerState::Filter _mipFilter,
+	float _maxAnisotropy,
+	SamplerState::DepthCompareFunc _depthCmpFunc,
+	SamplerState::BorderHandling _borderHandling,
+	const float _borderColor[4]
+)
+{
+	return get(makeSamplerDesc(_minFilter, _magFilter, _mipFilter, _maxAnisotropy, _depthCmpFunc, _borderHandling, _borderColor));
+}
+
+size_t gpupro::SamplerCache::numSamplers()
+{
+	size_t num = 0;
+	for(auto& it : s_samplerCache)
+		if(!it.second.expired())
+			++num;
+	return num;
+}
+
+
+// Pack up to four 16 bit values into one key. All enums used in the
+// pipeline are smaller than 0x10000.
+static GLuint64 packKey(GLuint64 _a, GLuint64 _b = 0, GLuint64 _c = 0, GLuint64 _d = 0)
+{
+	return _a | (_b << 16) | (_c << 32) | (_d << 48);
+}
+
+gpupro::CompiledPipeline::CompiledPipeline(const Pipeline& _pipeline) :
+	m_ignoreMask(0),
+	m_samplerMask(0),
+	m_bindings(_pipeline.bindings)
+{
+	const RasterizerState& rs = _pipeline.rasterizer;
+	m_keys[CULL_MODE] = static_cast<GLuint64>(rs.cullMode);
+	m_keys[FRONT_FACE] = static_cast<GLuint64>(rs.frontFaceWinding);
+	m_keys[POLYGON_MODE] = static_cast<GLuint64>(rs.fillMode);
+	GLuint lineWidthBits;
+	memcpy(&lineWidthBits, &rs.lineWidth, sizeof(float));
+	m_keys[LINE_WIDTH] = lineWidthBits;
+	m_keys[RASTERIZER_DISCARD] = rs.discard;
+	m_keys[COLOR_MASK] = rs.colorWrite;
+	m_keys[DITHER] = rs.dithering;
+
+	const DepthStencilState& ds = _pipeline.depthStencil;
+	m_keys[DEPTH_TEST] = ds.depthTest;
+	m_keys[DEPTH_FUNC] = static_cast<GLuint64>(ds.depthCmpFunc);
+	m_keys[DEPTH_MASK] = ds.depthWrite;
+	if(!ds.depthTest)
+		m_ignoreMask |= 1ull << DEPTH_FUNC;
+	m_keys[STENCIL_TEST] = ds.stencilTest;
+	m_keys[STENCIL_FUNC_FRONT] = packKey(static_cast<GLuint64>(ds.stencilCmpFuncFront)) | (static_cast<GLuint64>(static_cast<GLuint>(ds.stencilRefFront)) << 32);
+	m_keys[STENCIL_FUNC_BACK] = packKey(static_cast<GLuint64>(ds.stencilCmpFuncBack)) | (static_cast<GLuint64>(static_cast<GLuint>(ds.stencilRefBack)) << 32);
+	m_keys[STENCIL_OP_FRONT] = packKey(static_cast<GLuint64>(ds.stencilFailOpFront), static_cast<GLuint64>(ds.zfailOpFront), static_cast<GLuint64>(ds.passOpFront));
+	m_keys[STENCIL_OP_BACK] = packKey(static_cast<GLuint64>(ds.stencilFailOpBack), static_cast<GLuint64>(ds.zfailOpBack), static_cast<GLuint64>(ds.passOpBack));
+	if(!ds.stencilTest)
+		m_ignoreMask |= (1ull << STENCIL_FUNC_FRONT) | (1ull << STENCIL_FUNC_BACK) | (1ull << STENCIL_OP_FRONT) | (1ull << STENCIL_OP_BACK);
+
+	const BlendState& bs = _pipeline.blendState;
+	m_keys[BLEND_MODE] = static_cast<GLuint64>(bs.enableBlending);
+	for(int i = 0; i < 8; ++i)
+	{
+		m_keys[BLEND_EQUATION0 + i] = packKey(static_cast<GLuint64>(bs.buf[i].colorBlendOp), static_cast<GLuint64>(bs.buf[i].alphaBlendOp));
+		m_keys[BLEND_FUNC0 + i] = packKey(static_cast<GLuint64>(bs.buf[i].srcColorFactor), static_cast<GLuint64>(bs.buf[i].dstColorFactor),
+			static_cast<GLuint64>(bs.buf[i].srcAlphaFactor), static_cast<GLuint64>(bs.buf[i].dstAlphaFactor));
+		if(bs.enableBlending != BlendState::BlendMode::BLEND)
+			m_ignoreMask |= (1ull << (BLEND_EQUATION0 + i)) | (1ull << (BLEND_FUNC0 + i));
+	}
+	m_keys[LOGIC_OP] = static_cast<GLuint64>(bs.logicOp);
+	m_keys[ALPHA_TO_COVERAGE] = bs.alphaToCoverage;
+
+	// Without a shader the current program remains bound. Stage programs
+	// are only used while program 0 is bound.
+	m_keys[PROGRAM] = _pipeline.shader ? _pipeline.shader->glID() : 0;
+	if(!_pipeline.shader && !_pipeline.programs)
+		m_ignoreMask |= 1ull << PROGRAM;
+	for(int i = 0; i < ProgramPipeline::NUM_STAGES; ++i)
+	{
+		if(!_pipeline.shader && _pipeline.programs)
+			m_keys[STAGE_PROGRAM0 + i] = _pipeline.programs->glID(static_cast<ProgramPipeline::Stage>(i));
+		else
+		{
+			m_keys[STAGE_PROGRAM0 + i] = 0;
+			m_ignoreMask |= 1ull << (STAGE_PROGRAM0 + i);
+		}
+	}
+	// 0 is replaced by a dummy vertex array in the context.
+	m_keys[VERTEX_ARRAY] = _pipeline.vertexFormat ? _pipeline.vertexFormat->glID() : 0;
+
+	for(int i = 0; i < 64; ++i)
+	{
+		m_samplers[i] = _pipeline.samplerState[i] ? _pipeline.samplerState[i]->glID() : 0;
+		if(m_samplers[i])
+			m_samplerMask |= 1ull << i;
+	}
+
+	// FNV-1a over all keys and used sampler slots
+	m_hash = 14695981039346656037ull;
+	auto hashValue = [this](GLuint64 _value) {
+		m_hash = (m_hash ^ _value) * 1099511628211ull;
+	};
+	for(int i = 0; i < NUM_SLOTS; ++i)
+		hashValue((m_ignoreMask & (1ull << i)) ? 0 : m_keys[i]);
+	hashValue(m_ignoreMask);
+	hashValue(m_samplerMask);
+	for(int i = 0; i < 64; ++i)
+		if(m_samplers[i])
+			hashValue((static_cast<GLuint64>(i) << 32) | m_samplers[i]);
+}
@@ -0,0 +1,205 @@
+#include "pipelinestatistics.hpp"
+#include "deletionqueue.hpp"
+
+#include <iomanip>
+#include <iostream>
+
+namespace {
+
+	// Query targets in the order of PipelineStatistics::Counter
+	const GLenum COUNTER_TARGETS[] = {
+		GL_VERTICES_SUBMITTED_ARB,
+		GL_PRIMITIVES_SUBMITTED_ARB,
+		GL_VERTEX_SHADER_INVOCATIONS_ARB,
+		GL_TESS_CONTROL_SHADER_PATCHES_ARB,
+		GL_TESS_EVALUATION_SHADER_INVOCATIONS_ARB,
+		GL_GEOMETRY_SHADER_INVOCATIONS,
+		GL_GEOMETRY_SHADER_PRIMITIVES_EMITTED_ARB,
+		GL_FRAGMENT_SHADER_INVOCATIONS_ARB,
+		GL_COMPUTE_SHADER_INVOCATIONS_ARB,
+		GL_CLIPPING_INPUT_PRIMITIVES_ARB,
+		GL_CLIPPING_OUTPUT_PRIMITIVES_ARB
+	};
+	static_assert(sizeof(COUNTER_TARGETS) / sizeof(GLenum) == gpupro::PipelineStatistics::NUM_COUNTERS, "Missing query target.");
+
+	// The queries of pass i are [i * NUM_COUNTERS, (i + 1) * NUM_COUNTERS).
+	struct Frame
+	{
+		std::vector<GLuint> queries;
+		std::vector<gpupro::PipelineStatistics::PassStatistics> passes;	///< Counters are filled on collection
+		bool pending;
+	};
+
+}
+
+static bool s_enabled = false;
+static bool s_inPass = false;
+static Frame s_frames[gpupro::PipelineStatistics::LATENCY];
+static GLuint s_currentFrame = 0;
+static std::vector<gpupro::PipelineStatistics::PassStatistics> s_latest;
+
+// Read the results if all queries of the frame are finished.
+static bool collect(Frame& _frame)
+{
+	const size_t numQueries = _frame.passes.size() * gpupro::PipelineStatistics::NUM_COUNTERS;
+	// Different targets may finish in any order, check all of them.
+	for(size_t i = 0; i < numQueries; ++i)
+	{
+		GLuint available = 0;
+		glGetQueryObjectuiv(_frame.queries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+		if(!available)
+			return false;
+	}
+
+	for(size_t p = 0; p < _frame.passes.size(); ++p)
+		for(int c = 0; c < gpupro::PipelineStatistics::NUM_COUNTERS; ++c)
+		{
+			GLuint64& counter = _frame.passes[p].counters[c];
+			counter = 0;
+			glGetQueryObjectui64v(_frame.queries[p * gpupro::PipelineStatistics::NUM_COUNTERS + c], GL_QUERY_RESULT, &counter);
+		}
+	s_latest.swap(_frame.passes);
+	return true;
+}
+
+double gpupro::PipelineStatistics::PassStatistics::overdraw() const
+{
+	return numPixels ? counters[FRAGMENT_SHADER_INVOCATIONS] / static_cast<double>(numPixels) : 0.0;
+}
+
+double gpupro::PipelineStatistics::PassStatistics::vertexReuse() const
+{
+	return counters[VERTEX_SHADER_INVOCATIONS] ? counters[VERTICES_SUBMITTED] / static_cast<double>(counters[VERTEX_SHADER_INVOCATIONS]) : 0.0;
+}
+
+bool gpupro::PipelineStatistics::isSupported()
+{
+	return GLAD_GL_ARB_pipeline_statistics_query || GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 6);
+}
+
+void gpupro::PipelineStatistics::setEnabled(bool _enable)
+{
+	if(_enable && !isSupported())
+	{
+		std::cerr << "WAR: Pipeline statistics queries are not supported by the driver.\n";
+		return;
+	}
+	if(s_inPass)
+		endPass();
+	if(s_enabled && !_enable)
+	{
+		for(auto& frame : s_frames)
+		{
+			for(GLuint query : frame.queries)
+				DeletionQueue::release(DeletionQueue::ObjectType::QUERY, query);
+			frame.queries.clear();
+			frame.passes.clear();
+			frame.pending = false;
+		}
+	}
+	s_enabled = _enable;
+}
+
+bool gpupro::PipelineStatistics::isEnabled()
+{
+	return s_enabled;
+}
+
+void gpupro::PipelineStatistics::beginPass(const char* _name, GLuint64 _numPixels)
+{
+	if(!s_enabled)
+		return;
+	if(s_inPass)
+	{
+		std::cerr << "ERR: Pipeline statistics pass " << _name << " begins inside another pass.\n";
+		return;
+	}
+
+	Frame& frame = s_frames[s_currentFrame];
+	const size_t first = frame.passes.size() * NUM_COUNTERS;
+	if(frame.queries.size() < first + NUM_COUNTERS)
+	{
+		// Grow by a few passes at once.
+		size_t oldSize = frame.queries.size();
+		frame.queries.resize(first + NUM_COUNTERS * 4);
+		glGenQueries(static_cast<GLsizei>(frame.queries.size() - oldSize), frame.queries.data() + oldSize);
+	}
+	PassStatistics pass;
+	pass.name = _name;
+	pass.numPixels = _numPixels;
+	frame.passes.push_back(std::move(pass));
+	for(int c = 0; c < NUM_COUNTERS; ++c)
+		glBeginQuery(COUNTER_TARGETS[c], frame.queries[first + c]);
+	s_inPass = true;
+}
+
+void gpupro::PipelineStatistics::endPass()
+{
+	if(!s_inPass)
+		return;
+	for(int c = 0; c < NUM_COUNTERS; ++c)
+		glEndQuery(COUNTER_TARGETS[c]);
+	s_inPass = false;
+}
+
+void gpupro::PipelineStatistics::endFrame()
+{
+	if(!s_enabled)
+		return;
+	if(s_inPass)
+	{
+		std::cerr << "WAR: Pipeline statistics pass " << s_frames[s_currentFrame].passes.back().name << " is still open at the end of the frame.\n";
+		endPass();
+	}
+
+	if(!s_frames[s_currentFrame].passes.empty())
+		s_frames[s_currentFrame].pending = true;
+	s_currentFrame = (s_currentFrame + 1) % LATENCY;
+
+	// Collect in order, starting with the oldest frame (the next one). The
+	// latest collected frame wins.
+	for(GLuint i = 0; i < LATENCY; ++i)
+	{
+		Frame& oldFrame = s_frames[(s_currentFrame + i) % LATENCY];
+		if(!oldFrame.pending) continue;
+		if(!collect(oldFrame)) break;
+		oldFrame.pending = false;
+	}
+
+	// Results which were not available in time are lost.
+	Frame& next = s_frames[s_currentFrame];
+	next.passes.clear();
+	next.pending = false;
+}
+
+const std::vector<gpupro::PipelineStatistics::PassStatistics>& gpupro::PipelineStatistics::statistics()
+{
+	return s_latest;
+}
+
+void gpupro::PipelineStatistics::printStatistics()
+{
+	std::cerr << "INF: Pipeline statistics of the latest finished frame:\n"
+		<< "  " << std::left << std::setw(24) << "Pass" << std::right
+		<< std::setw(12) << "Vertices" << std::setw(12) << "VS inv." << std::setw(12) << "Clip in"
+		<< std::setw(12) << "Clip out" << std::setw(12) << "FS inv." << std::setw(12) << "CS inv."
+		<< std::setw(10) << "Overdraw" << std::setw(10) << "Reuse" << '\n';
+	for(auto& pass : s_latest)
+	{
+		std::cerr << "  " << std::left << std::setw(24) << pass.name << std::right
+			<< std::setw(12) << pass.counters[VERTICES_SUBMITTED]
+			<< std::setw(12) << pass.counters[VERTEX_SHADER_INVOCATIONS]
+			<< std::setw(12) << pass.counters[CLIPPING_INPUT_PRIMITIVES]
+			<< std::setw(12) << pass.counters[CLIPPING_OUTPUT_PRIMITIVES]
+			<< std::setw(12) << pass.counters[FRAGMENT_SHADER_INVOCATIONS]
+			<< std::setw(12) << pass.counters[COMPUTE_SHADER_INVOCATIONS]
+			<< std::fixed << std::setprecision(2)
+			<< std::setw(10) << pass.overdraw() << std::setw(10) << pass.vertexReuse() << '\n';
+		std::cerr.unsetf(std::ios::floatfield);
+		if(pass.counters[TESS_CONTROL_SHADER_PATCHES] || pass.counters[GEOMETRY_SHADER_INVOCATIONS])
+			std::cerr << "    tessellation: " << pass.counters[TESS_CONTROL_SHADER_PATCHES] << " patches, "
+				<< pass.counters[TESS_EVALUATION_SHADER_INVOCATIONS] << " evaluations; geometry shader: "
+				<< pass.counters[GEOMETRY_SHADER_INVOCATIONS] << " invocations, "
+				<< pass.counters[GEOMETRY_SHADER_PRIMITIVES_EMITTED] << " primitives\n";
+	}
+}
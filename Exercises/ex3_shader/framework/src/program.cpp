@@ -1,8 +1,106 @@
 #include "program.hpp"
+#include "deletionqueue.hpp"
 #include "shader.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
-gpupro::Program::Program()
+static GLuint64 s_numRedundantUniforms = 0;
+
+// Size of the scalars, rows and columns of the non-opaque GLSL types.
+struct TypeInfo
+{
+	GLenum type;
+	GLint scalarSize;
+	GLint rows;
+	GLint columns;
+};
+
+static const TypeInfo TYPE_INFOS[] = {
+	{GL_FLOAT, 4, 1, 1}, {GL_FLOAT_VEC2, 4, 2, 1}, {GL_FLOAT_VEC3, 4, 3, 1}, {GL_FLOAT_VEC4, 4, 4, 1},
+	{GL_DOUBLE, 8, 1, 1}, {GL_DOUBLE_VEC2, 8, 2, 1}, {GL_DOUBLE_VEC3, 8, 3, 1}, {GL_DOUBLE_VEC4, 8, 4, 1},
+	{GL_INT, 4, 1, 1}, {GL_INT_VEC2, 4, 2, 1}, {GL_INT_VEC3, 4, 3, 1}, {GL_INT_VEC4, 4, 4, 1},
+	{GL_UNSIGNED_INT, 4, 1, 1}, {GL_UNSIGNED_INT_VEC2, 4, 2, 1}, {GL_UNSIGNED_INT_VEC3, 4, 3, 1}, {GL_UNSIGNED_INT_VEC4, 4, 4, 1},
+	{GL_BOOL, 4, 1, 1}, {GL_BOOL_VEC2, 4, 2, 1}, {GL_BOOL_VEC3, 4, 3, 1}, {GL_BOOL_VEC4, 4, 4, 1},
+	// GL_<type>_MATcxr has c columns and r rows.
+	{GL_FLOAT_MAT2, 4, 2, 2}, {GL_FLOAT_MAT3, 4, 3, 3}, {GL_FLOAT_MAT4, 4, 4, 4},
+	{GL_FLOAT_MAT2x3, 4, 3, 2}, {GL_FLOAT_MAT2x4, 4, 4, 2}, {GL_FLOAT_MAT3x2, 4, 2, 3},
+	{GL_FLOAT_MAT3x4, 4, 4, 3}, {GL_FLOAT_MAT4x2, 4, 2, 4}, {GL_FLOAT_MAT4x3, 4, 3, 4},
+	{GL_DOUBLE_MAT2, 8, 2, 2}, {GL_DOUBLE_MAT3, 8, 3, 3}, {GL_DOUBLE_MAT4, 8, 4, 4},
+	{GL_DOUBLE_MAT2x3, 8, 3, 2}, {GL_DOUBLE_MAT2x4, 8, 4, 2}, {GL_DOUBLE_MAT3x2, 8, 2, 3},
+	{GL_DOUBLE_MAT3x4, 8, 4, 3}, {GL_DOUBLE_MAT4x2, 8, 2, 4}, {GL_DOUBLE_MAT4x3, 8, 3, 4},
+};
+
+// nullptr for opaque types (samplers, images, atomic counters).
+static const TypeInfo* typeInfo(GLenum _type)
+{
+	for(auto& info : TYPE_INFOS)
+		if(info.type == _type)
+			return &info;
+	return nullptr;
+}
+
+static std::string resourceName(GLuint _program, GLenum _interface, GLuint _index, GLint _length)
+{
+	if(_length <= 1) return std::string();
+	std::string name;
+	name.resize(_length);
+	glGetProgramResourceName(_program, _interface, _index, _length, nullptr, &name[0]);
+	// The length includes the terminating 0.
+	name.resize(_length - 1);
+	return name;
+}
+
+static void reflectBlocks(GLuint _program, GLenum _blockInterface, GLenum _memberInterface, std::vector<gpupro::ProgramBlock>& _blocks)
+{
+	GLint numBlocks = 0;
+	glGetProgramInterfaceiv(_program, _blockInterface, GL_ACTIVE_RESOURCES, &numBlocks);
+	_blocks.resize(numBlocks);
+	for(GLint i = 0; i < numBlocks; ++i)
+	{
+		const GLenum BLOCK_PROPS[] = {GL_NAME_LENGTH, GL_BUFFER_BINDING, GL_BUFFER_DATA_SIZE, GL_NUM_ACTIVE_VARIABLES};
+		GLint values[4] = {0};
+		glGetProgramResourceiv(_program, _blockInterface, i, 4, BLOCK_PROPS, 4, nullptr, values);
+		gpupro::ProgramBlock& block = _blocks[i];
+		block.name = resourceName(_program, _blockInterface, i, values[0]);
+		block.binding = values[1];
+		block.dataSize = values[2];
+
+		std::vector<GLint> variables(values[3]);
+		const GLenum VARIABLES_PROP = GL_ACTIVE_VARIABLES;
+		if(!variables.empty())
+			glGetProgramResourceiv(_program, _blockInterface, i, 1, &VARIABLES_PROP, static_cast<GLsizei>(variables.size()), nullptr, variables.data());
+		block.members.resize(variables.size());
+		for(size_t j = 0; j < variables.size(); ++j)
+		{
+			const GLenum MEMBER_PROPS[] = {GL_NAME_LENGTH, GL_TYPE, GL_ARRAY_SIZE, GL_OFFSET, GL_ARRAY_STRIDE, GL_MATRIX_STRIDE};
+			GLint member[6] = {0};
+			glGetProgramResourceiv(_program, _memberInterface, variables[j], 6, MEMBER_PROPS, 6, nullptr, member);
+			block.members[j] = gpupro::ProgramUniform{
+				resourceName(_program, _memberInterface, variables[j], member[0]),
+				static_cast<GLenum>(member[1]), member[2], -1, -1, member[3], member[4], member[5]};
+		}
+		std::sort(block.members.begin(), block.members.end(), [](const gpupro::ProgramUniform& _a, const gpupro::ProgramUniform& _b) {
+			return _a.offset < _b.offset;
+		});
+	}
+}
+
+// Bytes a block member occupies (without padding behind it). 0 for
+// runtime sized arrays.
+static GLint memberSize(const gpupro::ProgramUniform& _member)
+{
+	const TypeInfo* info = typeInfo(_member.type);
+	if(!info) return 0;
+	GLint elementSize = info->columns > 1 ? info->columns * _member.matrixStride : info->scalarSize * info->rows;
+	if(_member.arraySize == 1 && _member.arrayStride == 0)
+		return elementSize;
+	return _member.arraySize * _member.arrayStride;
+}
+
+gpupro::Program::Program() :
+	m_separable(false)
 {
 	m_id = glCreateProgram();
 }
@@ -54,20 +152,32 @@ gpupro::Program::Program(Shader & _vertShader, Shader & _tessEvaShader, Shader &
 
 gpupro::Program::~Program()
 {
-	glDeleteProgram(m_id);
+	DeletionQueue::release(DeletionQueue::ObjectType::PROGRAM, m_id);
 }
 
 gpupro::Program::Program(Program&& _rhs) :
-	m_id(_rhs.m_id)
+	m_id(_rhs.m_id),
+	m_separable(_rhs.m_separable),
+	m_uniforms(std::move(_rhs.m_uniforms)),
+	m_uniformBlocks(std::move(_rhs.m_uniformBlocks)),
+	m_storageBlocks(std::move(_rhs.m_storageBlocks)),
+	m_uniformSlots(std::move(_rhs.m_uniformSlots)),
+	m_uniformValues(std::move(_rhs.m_uniformValues))
 {
 	_rhs.m_id = 0;
 }
 
 gpupro::Program& gpupro::Program::operator=(Program&& _rhs)
 {
-	glDeleteProgram(m_id);
+	DeletionQueue::release(DeletionQueue::ObjectType::PROGRAM, m_id);
 
 	m_id = _rhs.m_id;
+	m_separable = _rhs.m_separable;
+	m_uniforms = std::move(_rhs.m_uniforms);
+	m_uniformBlocks = std::move(_rhs.m_uniformBlocks);
+	m_storageBlocks = std::move(_rhs.m_storageBlocks);
+	m_uniformSlots = std::move(_rhs.m_uniformSlots);
+	m_uniformValues = std::move(_rhs.m_uniformValues);
 	_rhs.m_id = 0;
 	return *this;
 }
@@ -77,10 +187,26 @@ void gpupro::Program::attach(Shader& _shader)
 	glAttachShader(m_id, _shader.glID());
 }
 
+void gpupro::Program::setSeparable(bool _separable)
+{
+	glProgramParameteri(m_id, GL_PROGRAM_SEPARABLE, _separable ? GL_TRUE : GL_FALSE);
+	m_separable = _separable;
+}
+
 void gpupro::Program::link()
+{
+	submitLink();
+	checkStatus();
+}
+
+void gpupro::Program::submitLink()
 {
 	// Link all attached shaders (if possible)
 	glLinkProgram(m_id);
+}
+
+void gpupro::Program::checkStatus()
+{
 	// Check success
 	GLint isLinked = 0;
 	glGetProgramiv(m_id, GL_LINK_STATUS, &isLinked);
@@ -90,17 +216,33 @@ void gpupro::Program::link()
 		GLint length = 0;
 		glGetProgramiv(m_id, GL_INFO_LOG_LENGTH, &length);
 		std::string errorLog;
-		errorLog.reserve(length);
+		errorLog.resize(length);
 		glGetProgramInfoLog(m_id, length, &length, &errorLog[0]);
 		throw std::exception(errorLog.c_str());
 	} else {
 		std::cerr << "INF: Successfully linked program " << m_id << "\n";
+		reflect();
 	}
 }
 
-void gpupro::Program::loadFromBinary(GLenum _binaryFormat, const std::vector<unsigned char>& _binary)
+bool gpupro::Program::isReady() const
+{
+	if(!hasParallelShaderCompile())
+		return true;
+	GLint isCompleted = GL_TRUE;
+	glGetProgramiv(m_id, GL_COMPLETION_STATUS_KHR, &isCompleted);
+	return isCompleted == GL_TRUE;
+}
+
+bool gpupro::Program::loadFromBinary(GLenum _binaryFormat, const std::vector<unsigned char>& _binary)
 {
 	glProgramBinary(m_id, _binaryFormat, _binary.data(), static_cast<GLsizei>(_binary.size()));
+	GLint isLinked = 0;
+	glGetProgramiv(m_id, GL_LINK_STATUS, &isLinked);
+	if(isLinked != GL_TRUE)
+		return false;
+	reflect();
+	return true;
 }
 
 std::vector<unsigned char> gpupro::Program::getBinary(GLenum& _binaryFormat)
@@ -115,3 +257,272 @@ std::vector<unsigned char> gpupro::Program::getBinary(GLenum& _binaryFormat)
 	glGetProgramBinary(m_id, static_cast<GLsizei>(data.size()), nullptr, &_binaryFormat, data.data());
 	return std::move(data);
 }
+
+const gpupro::ProgramBlock* gpupro::Program::findBlock(const char* _name) const
+{
+	for(auto& block : m_uniformBlocks)
+		if(block.name == _name)
+			return &block;
+	for(auto& block : m_storageBlocks)
+		if(block.name == _name)
+			return &block;
+	return nullptr;
+}
+
+GLint gpupro::Program::uniformLocation(const char* _name) const
+{
+	// Arrays are reported as "name[0]", members of struct arrays as
+	// "name[i].member". Try the full name first.
+	const std::string name = _name;
+	for(auto& uniform : m_uniforms)
+	{
+		if(uniform.location < 0)
+			continue;
+		if(uniform.name == name
+			|| (uniform.name.size() == name.size() + 3 && uniform.name.compare(0, name.size(), name) == 0
+				&& uniform.name.compare(name.size(), 3, "[0]") == 0))
+			return uniform.location;
+	}
+
+	// Split a trailing "[i]" into array name and element.
+	if(name.empty() || name.back() != ']')
+		return -1;
+	size_t bracket = name.rfind('[');
+	if(bracket == std::string::npos || bracket + 2 >= name.size()
+		|| name.find_first_not_of("0123456789", bracket + 1) != name.size() - 1)
+		return -1;
+	const GLint element = atoi(name.c_str() + bracket + 1);
+	const std::string arrayName = name.substr(0, bracket) + "[0]";
+	for(auto& uniform : m_uniforms)
+	{
+		if(uniform.location >= 0 && uniform.name == arrayName)
+			return element < uniform.arraySize ? uniform.location + element : -1;
+	}
+	return -1;
+}
+
+bool gpupro::Program::validateBlock(const char* _blockName, size_t _structSize, std::initializer_list<BlockMemberLayout> _members) const
+{
+	const ProgramBlock* block = findBlock(_blockName);
+	if(!block)
+	{
+		std::cerr << "ERR: Program " << m_id << " has no block " << _blockName << ".\n";
+		return false;
+	}
+
+	bool isValid = true;
+	for(auto& member : _members)
+	{
+		auto it = std::find_if(block->members.begin(), block->members.end(), [&member](const ProgramUniform& _uniform) {
+			return _uniform.name == member.name;
+		});
+		if(it == block->members.end())
+		{
+			std::cerr << "ERR: Block " << _blockName << " has no member " << member.name << ".\n";
+			isValid = false;
+			continue;
+		}
+		if(static_cast<size_t>(it->offset) != member.offset)
+		{
+			std::cerr << "ERR: " << _blockName << '.' << member.name << " is at offset " << it->offset << " in GLSL but at " << member.offset << " in C++.\n";
+			isValid = false;
+		}
+		GLint size = memberSize(*it);
+		if(size > 0 && static_cast<size_t>(size) != member.size)
+		{
+			std::cerr << "ERR: " << _blockName << '.' << member.name << " has " << size << " bytes in GLSL but " << member.size << " in C++.\n";
+			isValid = false;
+		}
+	}
+	for(auto& uniform : block->members)
+	{
+		bool isListed = false;
+		for(auto& member : _members)
+			isListed |= uniform.name == member.name;
+		if(!isListed)
+		{
+			std::cerr << "ERR: " << _blockName << '.' << uniform.name << " is missing in the C++ struct.\n";
+			isValid = false;
+		}
+	}
+	if(_structSize < static_cast<size_t>(block->dataSize))
+	{
+		std::cerr << "ERR: Block " << _blockName << " needs " << block->dataSize << " bytes, but the C++ struct has " << _structSize << ".\n";
+		isValid = false;
+	}
+	return isValid;
+}
+
+void gpupro::Program::setUniform(GLint _location, float _value)
+{
+	if(updateUniform(_location, GL_FLOAT, &_value, sizeof(_value)))
+		glProgramUniform1f(m_id, _location, _value);
+}
+
+void gpupro::Program::setUniform(GLint _location, const glm::vec2& _value)
+{
+	if(updateUniform(_location, GL_FLOAT_VEC2, &_value, sizeof(_value)))
+		glProgramUniform2fv(m_id, _location, 1, &_value.x);
+}
+
+void gpupro::Program::setUniform(GLint _location, const glm::vec3& _value)
+{
+	if(updateUniform(_location, GL_FLOAT_VEC3, &_value, sizeof(_value)))
+		glProgramUniform3fv(m_id, _location, 1, &_value.x);
+}
+
+void gpupro::Program::setUniform(GLint _location, const glm::vec4& _value)
+{
+	if(updateUniform(_location, GL_FLOAT_VEC4, &_value, sizeof(_value)))
+		glProgramUniform4fv(m_id, _location, 1, &_value.x);
+}
+
+void gpupro::Program::setUniform(GLint _location, GLint _value)
+{
+	if(updateUniform(_location, GL_INT, &_value, sizeof(_value)))
+		glProgramUniform1i(m_id, _location, _value);
+}
+
+void gpupro::Program::setUniform(GLint _location, const glm::ivec2& _value)
+{
+	if(updateUniform(_location, GL_INT_VEC2, &_value, sizeof(_value)))
+		glProgramUniform2iv(m_id, _location, 1, &_value.x);
+}
+
+void gpupro::Program::setUniform(GLint _location, const glm::ivec3& _value)
+{
+	if(updateUniform(_location, GL_INT_VEC3, &_value, sizeof(_value)))
+		glProgramUniform3iv(m_id, _location, 1, &_value.x);
+}
+
+void gpupro::Program::setUniform(GLint _location, const glm::ivec4& _value)
+{
+	if(updateUniform(_location, GL_INT_VEC4, &_value, sizeof(_value)))
+		glProgramUniform4iv(m_id, _location, 1, &_value.x);
+}
+
+void gpupro::Program::setUniform(GLint _location, GLuint _value)
+{
+	if(updateUniform(_location, GL_UNSIGNED_INT, &_value, sizeof(_value)))
+		glProgramUniform1ui(m_id, _location, _value);
+}
+
+void gpupro::Program::setUniform(GLint _location, const glm::mat3& _value)
+{
+	if(updateUniform(_location, GL_FLOAT_MAT3, &_value, sizeof(_value)))
+		glProgramUniformMatrix3fv(m_id, _location, 1, GL_FALSE, &_value[0][0]);
+}
+
+void gpupro::Program::setUniform(GLint _location, const glm::mat4& _value)
+{
+	if(updateUniform(_location, GL_FLOAT_MAT4, &_value, sizeof(_value)))
+		glProgramUniformMatrix4fv(m_id, _location, 1, GL_FALSE, &_value[0][0]);
+}
+
+GLuint64 gpupro::Program::numRedundantUniforms()
+{
+	return s_numRedundantUniforms;
+}
+
+void gpupro::Program::reflect()
+{
+	reflectBlocks(m_id, GL_UNIFORM_BLOCK, GL_UNIFORM, m_uniformBlocks);
+	reflectBlocks(m_id, GL_SHADER_STORAGE_BLOCK, GL_BUFFER_VARIABLE, m_storageBlocks);
+
+	// Uniforms of the default block. GL_UNIFORM also lists all members of
+	// uniform blocks, skip them.
+	m_uniforms.clear();
+	m_uniformSlots.clear();
+	m_uniformValues.clear();
+	GLint numUniforms = 0;
+	glGetProgramInterfaceiv(m_id, GL_UNIFORM, GL_ACTIVE_RESOURCES, &numUniforms);
+	for(GLint i = 0; i < numUniforms; ++i)
+	{
+		const GLenum PROPS[] = {GL_NAME_LENGTH, GL_TYPE, GL_ARRAY_SIZE, GL_LOCATION, GL_BLOCK_INDEX};
+		GLint values[5] = {0};
+		glGetProgramResourceiv(m_id, GL_UNIFORM, i, 5, PROPS, 5, nullptr, values);
+		if(values[4] != -1)
+			continue;
+		ProgramUniform uniform = {resourceName(m_id, GL_UNIFORM, i, values[0]),
+			static_cast<GLenum>(values[1]), values[2], values[3], -1, -1, 0, 0};
+		const TypeInfo* info = typeInfo(uniform.type);
+		if(!info && uniform.location >= 0)
+			glGetUniformiv(m_id, uniform.location, &uniform.binding);
+
+		// One slot with a shadow value per location (array element).
+		if(uniform.location >= 0)
+		{
+			GLuint elementSize = info ? info->scalarSize * info->rows * info->columns : sizeof(GLint);
+			size_t numSlots = static_cast<size_t>(uniform.location + uniform.arraySize);
+			if(m_uniformSlots.size() < numSlots)
+				m_uniformSlots.resize(numSlots, UniformSlot{-1, 0, false});
+			for(GLint e = 0; e < uniform.arraySize; ++e)
+			{
+				m_uniformSlots[uniform.location + e] = UniformSlot{static_cast<GLint>(m_uniforms.size()), static_cast<GLuint>(m_uniformValues.size()), false};
+				m_uniformValues.resize(m_uniformValues.size() + elementSize);
+			}
+		}
+		m_uniforms.push_back(std::move(uniform));
+	}
+}
+
+bool gpupro::Program::updateUniform(GLint _location, GLenum _type, const void* _value, size_t _size)
+{
+	// Unused uniforms have location -1, GL ignores them as well.
+	if(_location < 0)
+		return false;
+	if(_location >= static_cast<GLint>(m_uniformSlots.size()) || m_uniformSlots[_location].uniform < 0)
+	{
+		std::cerr << "ERR: Program " << m_id << " has no uniform at location " << _location << ".\n";
+		return false;
+	}
+	UniformSlot& slot = m_uniformSlots[_location];
+	ProgramUniform& uniform = m_uniforms[slot.uniform];
+	const TypeInfo* info = typeInfo(uniform.type);
+	// Integers also set bools and the units of opaque types.
+	if(uniform.type != _type && !(_type == GL_INT && (uniform.type == GL_BOOL || !info)))
+	{
+		std::cerr << "ERR: The value for uniform " << uniform.name << " of program " << m_id << " has the wrong type.\n";
+		return false;
+	}
+
+	unsigned char* shadow = &m_uniformValues[slot.valueOffset];
+	if(slot.known && memcmp(shadow, _value, _size) == 0)
+	{
+		++s_numRedundantUniforms;
+		return false;
+	}
+	memcpy(shadow, _value, _size);
+	slot.known = true;
+	if(!info && _location == uniform.location)
+		uniform.binding = *static_cast<const GLint*>(_value);
+	return true;
+}
+
+gpupro::ProgramPipeline::ProgramPipeline()
+{
+	for(int i = 0; i < NUM_STAGES; ++i)
+		m_programs[i] = 0;
+}
+
+void gpupro::ProgramPipeline::setStage(Shader::Type _stage, Program* _program)
+{
+	Stage stage;
+	switch(_stage)
+	{
+	case Shader::Type::VERTEX: stage = VERTEX; break;
+	case Shader::Type::TESS_CONTROL: stage = TESS_CONTROL; break;
+	case Shader::Type::TESS_EVALUATION: stage = TESS_EVALUATION; break;
+	case Shader::Type::GEOMETRY: stage = GEOMETRY; break;
+	case Shader::Type::FRAGMENT: stage = FRAGMENT; break;
+	default:
+		std::cerr << "ERR: Compute shaders cannot be part of a ProgramPipeline. Use a ComputePipeline.\n";
+		return;
+	}
+	if(_program && !_program->isSeparable())
+	{
+		std::cerr << "ERR: Program " << _program->glID() << " is not separable and cannot be used in a ProgramPipeline.\n";
+		return;
+	}
+	m_programs[stage] = _program ? _program->glID() : 0;
+}
@@ -0,0 +1,250 @@
+#include "programcache.hpp"
+#include "shaderpreprocessor.hpp"
+#include "timeline.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
+static std::string s_directory;
+static GLuint s_numHits = 0;
+static GLuint s_numMisses = 0;
+
+// "GPPB": GPU Pro program binary
+static const GLuint FILE_MAGIC = 0x42505047;
+static const GLuint FILE_VERSION = 1;
+
+struct FileHeader
+{
+	GLuint magic;
+	GLuint version;
+	GLuint64 key;			///< Repeated to detect collisions of file names
+	GLenum binaryFormat;
+	GLuint binarySize;
+};
+
+// FNV-1a
+static void hashBytes(GLuint64& _hash, const void* _data, size_t _size)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(_data);
+	for(size_t i = 0; i < _size; ++i)
+	{
+		_hash ^= bytes[i];
+		_hash *= 0x100000001b3ull;
+	}
+}
+
+static void hashString(GLuint64& _hash, const char* _string)
+{
+	if(!_string) _string = "";
+	// Include the terminating 0, such that "ab"+"c" != "a"+"bc".
+	hashBytes(_hash, _string, strlen(_string) + 1);
+}
+
+// Hash over everything which invalidates a binary: the driver and the
+// sources. Returns 0 if the driver cannot store binaries.
+static GLuint64 computeKey(const std::vector<gpupro::ShaderSource>& _stages, bool _separable)
+{
+	GLint numFormats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+	if(numFormats <= 0)
+		return 0;
+	std::vector<GLint> formats(numFormats);
+	glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data());
+
+	GLuint64 hash = 0xcbf29ce484222325ull;
+	hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+	hashString(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+	hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+	hashBytes(hash, formats.data(), formats.size() * sizeof(GLint));
+	hashBytes(hash, &_separable, sizeof(_separable));
+	for(auto& stage : _stages)
+	{
+		GLenum type = static_cast<GLenum>(stage.type);
+		hashBytes(hash, &type, sizeof(type));
+		hashBytes(hash, stage.source.data(), stage.source.size());
+		hashBytes(hash, "", 1);
+	}
+	return hash ? hash : 1;
+}
+
+static std::string fileName(GLuint64 _key)
+{
+	char name[32];
+	snprintf(name, sizeof(name), "/%016llx.bin", static_cast<unsigned long long>(_key));
+	return s_directory + name;
+}
+
+static bool readBinary(const std::string& _fileName, GLuint64 _key, GLenum& _binaryFormat, std::vector<unsigned char>& _binary)
+{
+	FILE* file = fopen(_fileName.c_str(), "rb");
+	if(!file) return false;
+
+	FileHeader header;
+	bool valid = fread(&header, sizeof(header), 1, file) == 1
+		&& header.magic == FILE_MAGIC
+		&& header.version == FILE_VERSION
+		&& header.key == _key
+		&& header.binarySize > 0;
+	if(valid)
+	{
+		_binaryFormat = header.binaryFormat;
+		_binary.resize(header.binarySize);
+		valid = fread(_binary.data(), header.binarySize, 1, file) == 1;
+	}
+	fclose(file);
+	if(!valid)
+		std::cerr << "WAR: Ignoring corrupt program cache file " << _fileName << '\n';
+	return valid;
+}
+
+static void writeBinary(const std::string& _fileName, GLuint64 _key, GLenum _binaryFormat, const std::vector<unsigned char>& _binary)
+{
+	FILE* file = fopen(_fileName.c_str(), "wb");
+	if(!file)
+	{
+		std::cerr << "WAR: Cannot write program cache file " << _fileName << '\n';
+		return;
+	}
+	FileHeader header = {FILE_MAGIC, FILE_VERSION, _key, _binaryFormat, static_cast<GLuint>(_binary.size())};
+	bool written = fwrite(&header, sizeof(header), 1, file) == 1
+		&& fwrite(_binary.data(), _binary.size(), 1, file) == 1;
+	fclose(file);
+	if(!written)
+	{
+		std::cerr << "WAR: Failed to write program cache file " << _fileName << '\n';
+		remove(_fileName.c_str());
+	}
+}
+
+static std::string stageNames(const std::vector<gpupro::ShaderSource>& _stages)
+{
+	std::string names;
+	for(auto& stage : _stages)
+	{
+		if(!names.empty()) names += ", ";
+		names += stage.name.empty() ? "unnamed" : stage.name;
+	}
+	return names;
+}
+
+gpupro::ShaderSource gpupro::ShaderSource::fromFile(Shader::Type _type, const char* _fileName, const ShaderDefines& _defines)
+{
+	return ShaderPreprocessor::get(_type, _fileName, _defines);
+}
+
+void gpupro::ProgramCache::setDirectory(const char* _path)
+{
+	s_directory = _path ? _path : "";
+	if(s_directory.empty())
+		return;
+	// Fails harmlessly if the directory exists already.
+#ifdef _WIN32
+	_mkdir(_path);
+#else
+	mkdir(_path, 0755);
+#endif
+}
+
+gpupro::Program gpupro::ProgramCache::get(const std::vector<ShaderSource>& _stages, bool _separable)
+{
+	PendingProgram pending = request(_stages, _separable);
+	pending.program();
+	return std::move(pending.m_program);
+}
+
+gpupro::PendingProgram gpupro::ProgramCache::request(const std::vector<ShaderSource>& _stages, bool _separable)
+{
+	CPU_ZONE("ProgramCache::request");
+	PendingProgram pending;
+	// Must be set before the binary is loaded or the program is linked.
+	if(_separable)
+		pending.m_program.setSeparable(true);
+	GLuint64 key = s_directory.empty() ? 0 : computeKey(_stages, _separable);
+	if(key)
+	{
+		pending.m_cacheFile = fileName(key);
+		GLenum binaryFormat;
+		std::vector<unsigned char> binary;
+		if(readBinary(pending.m_cacheFile, key, binaryFormat, binary))
+		{
+			if(pending.m_program.loadFromBinary(binaryFormat, binary))
+			{
+				++s_numHits;
+				std::cerr << "INF: Loaded program " << pending.m_program.glID() << " (" << stageNames(_stages) << ") from the cache\n";
+				pending.m_checked = true;
+				return pending;
+			}
+			std::cerr << "WAR: The driver rejected the cached program (" << stageNames(_stages) << "). Compiling it again.\n";
+			pending.m_program = Program();
+			if(_separable)
+				pending.m_program.setSeparable(true);
+		}
+		pending.m_cacheKey = key;
+		glProgramParameteri(pending.m_program.glID(), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	}
+
+	++s_numMisses;
+	// Submit everything without checking the status in between. The
+	// shaders must live until the status is checked.
+	pending.m_shaders.reserve(_stages.size());
+	for(auto& stage : _stages)
+	{
+		pending.m_shaders.emplace_back(stage.type);
+		pending.m_shaders.back().submit(stage.source.c_str(), stage.name.empty() ? nullptr : stage.name.c_str());
+		pending.m_program.attach(pending.m_shaders.back());
+	}
+	pending.m_program.submitLink();
+	return pending;
+}
+
+GLuint gpupro::ProgramCache::numHits()
+{
+	return s_numHits;
+}
+
+GLuint gpupro::ProgramCache::numMisses()
+{
+	return s_numMisses;
+}
+
+bool gpupro::PendingProgram::isReady() const
+{
+	// Linking completes after the compilation of all shaders.
+	return m_checked || m_program.isReady();
+}
+
+gpupro::Program& gpupro::PendingProgram::program()
+{
+	if(!m_checked)
+	{
+		CPU_ZONE("PendingProgram::program");
+		// A failed compilation makes the linking fail. Check the shaders
+		// first to report the more helpful compile log.
+		for(auto& shader : m_shaders)
+			shader.checkStatus();
+		m_program.checkStatus();
+		m_shaders.clear();
+		m_checked = true;
+
+		if(m_cacheKey)
+		{
+			GLenum binaryFormat = 0;
+			std::vector<unsigned char> binary = m_program.getBinary(binaryFormat);
+			if(!binary.empty())
+				writeBinary(m_cacheFile, m_cacheKey, binaryFormat, binary);
+		}
+	}
+	return m_program;
+}
+
+gpupro::Program* gpupro::PendingProgram::programOr(Program* _fallback)
+{
+	return isReady() ? &program() : _fallback;
+}
@@ -1,4 +1,5 @@
 #include "query.hpp"
+#include "deletionqueue.hpp"
 
 #include <algorithm>
 
@@ -14,7 +15,7 @@ gpupro::Query::Query(Type _type) :
 
 gpupro::Query::~Query()
 {
-	glDeleteQueries(1, &m_id);
+	DeletionQueue::release(DeletionQueue::ObjectType::QUERY, m_id);
 }
 
 gpupro::Query::Query(Query && _rhs) :
@@ -30,7 +31,7 @@ gpupro::Query::Query(Query && _rhs) :
 
 gpupro::Query& gpupro::Query::operator = (Query && _rhs)
 {
-	glDeleteQueries(1, &m_id);
+	DeletionQueue::release(DeletionQueue::ObjectType::QUERY, m_id);
 
 	m_id = _rhs.m_id;
 	m_type = _rhs.m_type;
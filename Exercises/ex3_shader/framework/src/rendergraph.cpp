@@ -0,0 +1,541 @@
+#include "rendergraph.hpp"
+#include "context.hpp"
+#include "deletionqueue.hpp"
+#include "gpuprofiler.hpp"
+#include "pipelinestatistics.hpp"
+#include "timeline.hpp"
+#include "texture.hpp"
+#include "buffer.hpp"
+#include <algorithm>
+#include <iostream>
+
+// Marks passes without render targets.
+static const GLuint NO_FRAMEBUFFER = ~0u;
+
+gpupro::RenderGraph::PassBuilder& gpupro::RenderGraph::PassBuilder::sampleTexture(ResourceHandle _texture)
+{
+	Access access(_texture, AccessType::SAMPLED);
+	m_graph.addAccess(m_pass, access);
+	return *this;
+}
+
+gpupro::RenderGraph::PassBuilder& gpupro::RenderGraph::PassBuilder::readImage(ResourceHandle _texture)
+{
+	Access access(_texture, AccessType::IMAGE_READ);
+	m_graph.addAccess(m_pass, access);
+	return *this;
+}
+
+gpupro::RenderGraph::PassBuilder& gpupro::RenderGraph::PassBuilder::writeImage(ResourceHandle _texture)
+{
+	Access access(_texture, AccessType::IMAGE_WRITE);
+	m_graph.addAccess(m_pass, access);
+	return *this;
+}
+
+gpupro::RenderGraph::PassBuilder& gpupro::RenderGraph::PassBuilder::readBuffer(ResourceHandle _buffer, BufferAccess _access)
+{
+	Access access(_buffer, AccessType::BUFFER_READ, _access);
+	m_graph.addAccess(m_pass, access);
+	return *this;
+}
+
+gpupro::RenderGraph::PassBuilder& gpupro::RenderGraph::PassBuilder::writeBuffer(ResourceHandle _buffer)
+{
+	Access access(_buffer, AccessType::BUFFER_WRITE, BufferAccess::STORAGE);
+	m_graph.addAccess(m_pass, access);
+	return *this;
+}
+
+gpupro::RenderGraph::PassBuilder& gpupro::RenderGraph::PassBuilder::colorTarget(ResourceHandle _texture, GLuint _slot, LoadOp _load, const glm::vec4& _clearColor)
+{
+	Access access(_texture, AccessType::COLOR_TARGET, BufferAccess::UNIFORM, _slot, _load, _clearColor);
+	m_graph.addAccess(m_pass, access);
+	return *this;
+}
+
+gpupro::RenderGraph::PassBuilder& gpupro::RenderGraph::PassBuilder::depthStencilTarget(ResourceHandle _texture, LoadOp _load, float _clearDepth, GLint _clearStencil)
+{
+	Access access(_texture, AccessType::DEPTH_STENCIL_TARGET, BufferAccess::UNIFORM, 0, _load, glm::vec4(0.0f), _clearDepth, _clearStencil);
+	m_graph.addAccess(m_pass, access);
+	return *this;
+}
+
+gpupro::RenderGraph::PassBuilder& gpupro::RenderGraph::PassBuilder::sideEffects()
+{
+	m_graph.m_passes[m_pass].sideEffects = true;
+	return *this;
+}
+
+
+gpupro::RenderGraph::RenderGraph() :
+	m_textureGeneration(DeletionQueue::generation(DeletionQueue::ObjectType::TEXTURE))
+{
+}
+
+gpupro::RenderGraph::~RenderGraph()
+{
+	for(auto& fb : m_framebuffers)
+		DeletionQueue::release(DeletionQueue::ObjectType::FRAMEBUFFER, fb.second);
+}
+
+gpupro::RenderGraph::ResourceHandle gpupro::RenderGraph::addResource(const Resource& _resource)
+{
+	m_resources.push_back(_resource);
+	return static_cast<ResourceHandle>(m_resources.size() - 1);
+}
+
+gpupro::RenderGraph::ResourceHandle gpupro::RenderGraph::createTexture(const char* _name, GLsizei _width, GLsizei _height, InternalFormat _format)
+{
+	Resource res(_name, ResourceType::TEXTURE, nullptr, nullptr, _width, _height, _format, true, false);
+	return addResource(res);
+}
+
+gpupro::RenderGraph::ResourceHandle gpupro::RenderGraph::importTexture(const char* _name, Texture& _texture)
+{
+	Resource res(_name, ResourceType::TEXTURE, &_texture, nullptr, _texture.width(), _texture.height(), _texture.format(), false, false);
+	return addResource(res);
+}
+
+gpupro::RenderGraph::ResourceHandle gpupro::RenderGraph::importBuffer(const char* _name, Buffer& _buffer)
+{
+	Resource res(_name, ResourceType::BUFFER, nullptr, &_buffer, 0, 0, InternalFormat::R8, false, false);
+	return addResource(res);
+}
+
+gpupro::RenderGraph::ResourceHandle gpupro::RenderGraph::importBackbuffer(GLsizei _width, GLsizei _height)
+{
+	Resource res("Backbuffer", ResourceType::BACKBUFFER, nullptr, nullptr, _width, _height, InternalFormat::DEPTH24_STENCIL8, false, true);
+	return addResource(res);
+}
+
+void gpupro::RenderGraph::markOutput(ResourceHandle _resource)
+{
+	if(_resource >= m_resources.size())
+	{
+		std::cerr << "ERR: Invalid render graph resource handle.\n";
+		return;
+	}
+	m_resources[_resource].output = true;
+}
+
+gpupro::RenderGraph::PassBuilder gpupro::RenderGraph::addPass(const char* _name, PassType _type, std::function<void()> _execute)
+{
+	Pass pass;
+	pass.name = _name;
+	pass.type = _type;
+	pass.execute = std::move(_execute);
+	pass.sideEffects = false;
+	pass.alive = true;
+	pass.barrierBits = 0;
+	pass.framebuffer = NO_FRAMEBUFFER;
+	pass.viewport[0] = pass.viewport[1] = 0;
+	m_passes.push_back(std::move(pass));
+	return PassBuilder(*this, static_cast<GLuint>(m_passes.size() - 1));
+}
+
+void gpupro::RenderGraph::addAccess(GLuint _pass, const Access& _access)
+{
+	Pass& pass = m_passes[_pass];
+	if(_access.resource >= m_resources.size())
+	{
+		std::cerr << "ERR: Invalid resource handle in pass " << pass.name << ".\n";
+		return;
+	}
+	const Resource& res = m_resources[_access.resource];
+	bool isBufferAccess = _access.type == AccessType::BUFFER_READ || _access.type == AccessType::BUFFER_WRITE;
+	if((res.type == ResourceType::BUFFER) != isBufferAccess
+		|| (res.type == ResourceType::BACKBUFFER && !isTarget(_access.type)))
+	{
+		std::cerr << "ERR: Resource " << res.name << " cannot be accessed this way in pass " << pass.name << ".\n";
+		return;
+	}
+	if(isTarget(_access.type) && pass.type != PassType::GRAPHICS)
+	{
+		std::cerr << "ERR: Compute pass " << pass.name << " cannot have render targets.\n";
+		return;
+	}
+	pass.accesses.push_back(_access);
+}
+
+gpupro::Texture& gpupro::RenderGraph::texture(ResourceHandle _resource)
+{
+	return *m_resources[_resource].texture;
+}
+
+gpupro::Buffer& gpupro::RenderGraph::buffer(ResourceHandle _resource)
+{
+	return *m_resources[_resource].buffer;
+}
+
+void gpupro::RenderGraph::compile()
+{
+	CPU_ZONE("RenderGraph::compile");
+	m_stats = Stats();
+	m_stats.numPasses = static_cast<GLuint>(m_passes.size());
+	cullPasses();
+	assignTransientTextures();
+	computeBarriers();
+	createFramebuffers();
+}
+
+void gpupro::RenderGraph::cullPasses()
+{
+	// Walk backwards and keep passes which write something needed later.
+	std::vector<bool> needed(m_resources.size());
+	for(size_t i = 0; i < m_resources.size(); ++i)
+		needed[i] = m_resources[i].output;
+
+	for(size_t p = m_passes.size(); p-- > 0; )
+	{
+		Pass& pass = m_passes[p];
+		pass.alive = pass.sideEffects;
+		for(auto& access : pass.accesses)
+			if(isWrite(access.type) && needed[access.resource])
+				pass.alive = true;
+		if(!pass.alive)
+		{
+			++m_stats.numCulledPasses;
+			continue;
+		}
+		// Render targets which are cleared or invalidated are overwritten
+		// entirely. Earlier writes to them are not required.
+		for(auto& access : pass.accesses)
+			if(isTarget(access.type) && access.load != LoadOp::LOAD)
+				needed[access.resource] = false;
+		// Everything else depends on the previous content. This includes
+		// storage writes, which may be partial.
+		for(auto& access : pass.accesses)
+			if(!isTarget(access.type) || access.load == LoadOp::LOAD)
+				needed[access.resource] = true;
+	}
+}
+
+void gpupro::RenderGraph::assignTransientTextures()
+{
+	for(auto& res : m_resources)
+		res.firstPass = res.lastPass = -1;
+	for(int p = 0; p < static_cast<int>(m_passes.size()); ++p)
+	{
+		if(!m_passes[p].alive) continue;
+		for(auto& access : m_passes[p].accesses)
+		{
+			Resource& res = m_resources[access.resource];
+			if(res.firstPass == -1) res.firstPass = p;
+			res.lastPass = p;
+		}
+	}
+
+	for(auto& pooled : m_pool)
+		pooled.lastPass = -1;
+	std::vector<bool> poolUsed(m_pool.size(), false);
+
+	// Assign in order of first use. A pooled texture is free again after the
+	// last pass of its previous user.
+	for(int p = 0; p < static_cast<int>(m_passes.size()); ++p)
+	{
+		for(auto& res : m_resources)
+		{
+			if(!res.transient || res.firstPass != p) continue;
+			++m_stats.numTransientTextures;
+			size_t match = m_pool.size();
+			for(size_t i = 0; i < m_pool.size(); ++i)
+			{
+				Texture& tex = *m_pool[i].texture;
+				if(m_pool[i].lastPass < p && tex.width() == res.width && tex.height() == res.height && tex.format() == res.format)
+				{
+					match = i;
+					break;
+				}
+			}
+			if(match == m_pool.size())
+			{
+				PoolTexture pooled;
+				pooled.texture.reset(new Texture(Texture::Layout::TEX_2D, res.width, res.height, res.format, 1));
+				m_pool.push_back(std::move(pooled));
+				poolUsed.push_back(false);
+			}
+			m_pool[match].lastPass = res.lastPass;
+			poolUsed[match] = true;
+			res.texture = m_pool[match].texture.get();
+		}
+	}
+
+	// Release textures which were not required in this frame (e.g. after a
+	// resize) together with the framebuffers using them.
+	for(size_t i = m_pool.size(); i-- > 0; )
+	{
+		if(poolUsed[i]) continue;
+		GLuint id = m_pool[i].texture->glID();
+		for(auto it = m_framebuffers.begin(); it != m_framebuffers.end(); )
+		{
+			if(std::find(it->first.begin(), it->first.end(), id) != it->first.end())
+			{
+				DeletionQueue::release(DeletionQueue::ObjectType::FRAMEBUFFER, it->second);
+				it = m_framebuffers.erase(it);
+			} else ++it;
+		}
+		m_pool.erase(m_pool.begin() + i);
+	}
+	m_stats.numPoolTextures = static_cast<GLuint>(m_pool.size());
+}
+
+GLbitfield gpupro::RenderGraph::requiredBarrier(const Access& _access)
+{
+	switch(_access.type)
+	{
+	case AccessType::SAMPLED: return GL_TEXTURE_FETCH_BARRIER_BIT;
+	case AccessType::IMAGE_READ:
+	case AccessType::IMAGE_WRITE: return GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+	case AccessType::BUFFER_WRITE: return GL_SHADER_STORAGE_BARRIER_BIT;
+	case AccessType::BUFFER_READ:
+		switch(_access.bufferAccess)
+		{
+		case BufferAccess::UNIFORM: return GL_UNIFORM_BARRIER_BIT;
+		case BufferAccess::STORAGE: return GL_SHADER_STORAGE_BARRIER_BIT;
+		case BufferAccess::VERTEX: return GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+		case BufferAccess::INDEX: return GL_ELEMENT_ARRAY_BARRIER_BIT;
+		case BufferAccess::INDIRECT: return GL_COMMAND_BARRIER_BIT;
+		}
+		return 0;
+	default: return GL_FRAMEBUFFER_BARRIER_BIT;
+	}
+}
+
+void gpupro::RenderGraph::computeBarriers()
+{
+	// Image and storage buffer writes are incoherent. Track per physical
+	// object which barrier bits were issued since the last such write.
+	struct WriteState { bool dirty = false; GLbitfield issued = 0; };
+	std::map<const void*, WriteState> states;
+
+	for(auto& pass : m_passes)
+	{
+		pass.barrierBits = 0;
+		if(!pass.alive) continue;
+
+		for(auto& access : pass.accesses)
+		{
+			const Resource& res = m_resources[access.resource];
+			const void* object = res.type == ResourceType::BUFFER ? static_cast<const void*>(res.buffer) : static_cast<const void*>(res.texture);
+			auto it = states.find(object);
+			if(it == states.end() || !it->second.dirty) continue;
+			GLbitfield bit = requiredBarrier(access);
+			if(!(it->second.issued & bit))
+				pass.barrierBits |= bit;
+		}
+
+		// A barrier is global. It covers all pending writes.
+		if(pass.barrierBits)
+		{
+			++m_stats.numBarriers;
+			for(auto& state : states)
+				state.second.issued |= pass.barrierBits;
+		}
+
+		for(auto& access : pass.accesses)
+		{
+			if(access.type != AccessType::IMAGE_WRITE && access.type != AccessType::BUFFER_WRITE) continue;
+			const Resource& res = m_resources[access.resource];
+			const void* object = res.type == ResourceType::BUFFER ? static_cast<const void*>(res.buffer) : static_cast<const void*>(res.texture);
+			WriteState& state = states[object];
+			state.dirty = true;
+			state.issued = 0;
+		}
+	}
+}
+
+void gpupro::RenderGraph::createFramebuffers()
+{
+	// Imported textures may have been deleted since the last compile and
+	// their names reused by new textures. Drop the framebuffers which
+	// reference a deleted name.
+	const GLuint textureGeneration = DeletionQueue::generation(DeletionQueue::ObjectType::TEXTURE);
+	if(textureGeneration != m_textureGeneration)
+	{
+		for(auto it = m_framebuffers.begin(); it != m_framebuffers.end(); )
+		{
+			bool deleted = false;
+			for(size_t i = 1; i < it->first.size() && !deleted; i += 2)
+				deleted = DeletionQueue::wasDeleted(DeletionQueue::ObjectType::TEXTURE, it->first[i], m_textureGeneration);
+			if(deleted)
+			{
+				DeletionQueue::release(DeletionQueue::ObjectType::FRAMEBUFFER, it->second);
+				it = m_framebuffers.erase(it);
+			} else ++it;
+		}
+		m_textureGeneration = textureGeneration;
+	}
+
+	for(auto& pass : m_passes)
+	{
+		pass.framebuffer = NO_FRAMEBUFFER;
+		if(!pass.alive || pass.type != PassType::GRAPHICS) continue;
+
+		// Key: pairs of attachment point and texture name.
+		std::vector<GLuint> key;
+		bool backbuffer = false;
+		for(auto& access : pass.accesses)
+		{
+			const Resource& res = m_resources[access.resource];
+			if(isTarget(access.type))
+			{
+				pass.viewport[0] = res.width;
+				pass.viewport[1] = res.height;
+				if(res.type == ResourceType::BACKBUFFER)
+				{
+					backbuffer = true;
+					continue;
+				}
+				GLuint attachment;
+				if(access.type == AccessType::COLOR_TARGET)
+					attachment = GL_COLOR_ATTACHMENT0 + access.slot;
+				else if(isDepthFormat(res.format) && isStencilFormat(res.format))
+					attachment = GL_DEPTH_STENCIL_ATTACHMENT;
+				else if(isDepthFormat(res.format))
+					attachment = GL_DEPTH_ATTACHMENT;
+				else
+					attachment = GL_STENCIL_ATTACHMENT;
+				key.push_back(attachment);
+				key.push_back(res.texture->glID());
+			}
+		}
+		if(backbuffer)
+		{
+			if(!key.empty())
+				std::cerr << "ERR: Pass " << pass.name << " mixes the backbuffer with other render targets.\n";
+			pass.framebuffer = 0;
+			continue;
+		}
+		if(key.empty()) continue;
+
+		auto it = m_framebuffers.find(key);
+		if(it != m_framebuffers.end())
+		{
+			pass.framebuffer = it->second;
+			continue;
+		}
+
+		// Create a new framebuffer. Color outputs map to their slots.
+		GLenum drawBuffers[8] = {GL_NONE, GL_NONE, GL_NONE, GL_NONE, GL_NONE, GL_NONE, GL_NONE, GL_NONE};
+		GLsizei numDrawBuffers = 0;
+		for(size_t i = 0; i < key.size(); i += 2)
+		{
+			GLuint slot = key[i] - GL_COLOR_ATTACHMENT0;
+			if(slot < 8)
+			{
+				drawBuffers[slot] = key[i];
+				numDrawBuffers = std::max(numDrawBuffers, static_cast<GLsizei>(slot + 1));
+			}
+		}
+		GLuint fb;
+		GLenum status;
+		if(hasDSA())
+		{
+			glCreateFramebuffers(1, &fb);
+			for(size_t i = 0; i < key.size(); i += 2)
+				glNamedFramebufferTexture(fb, key[i], key[i+1], 0);
+			glNamedFramebufferDrawBuffers(fb, numDrawBuffers, drawBuffers);
+			status = glCheckNamedFramebufferStatus(fb, GL_FRAMEBUFFER);
+		} else {
+			glGenFramebuffers(1, &fb);
+			glBindFramebuffer(GL_FRAMEBUFFER, fb);
+			for(size_t i = 0; i < key.size(); i += 2)
+				glFramebufferTexture(GL_FRAMEBUFFER, key[i], key[i+1], 0);
+			glDrawBuffers(numDrawBuffers, drawBuffers);
+			status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		}
+		if(status != GL_FRAMEBUFFER_COMPLETE)
+			std::cerr << "ERR: Render targets of pass " << pass.name << " are incomplete (status " << status << ").\n";
+		m_framebuffers[key] = fb;
+		pass.framebuffer = fb;
+	}
+}
+
+void gpupro::RenderGraph::clearTargets(OGLContext& _context, const Pass& _pass)
+{
+	GLenum invalidate[10];
+	GLsizei numInvalidate = 0;
+	for(auto& access : _pass.accesses)
+	{
+		if(!isTarget(access.type))
+			continue;
+		const Resource& res = m_resources[access.resource];
+		bool isBackbuffer = res.type == ResourceType::BACKBUFFER;
+		bool hasDepth = isBackbuffer || isDepthFormat(res.format);
+		bool hasStencil = isBackbuffer || isStencilFormat(res.format);
+
+		if(access.load == LoadOp::CLEAR)
+		{
+			// Clears are affected by the write masks of the current state.
+			_context.prepareClear(access.type == AccessType::COLOR_TARGET ? GL_COLOR_BUFFER_BIT
+				: (hasDepth ? GL_DEPTH_BUFFER_BIT : 0) | (hasStencil ? GL_STENCIL_BUFFER_BIT : 0));
+			if(access.type == AccessType::COLOR_TARGET)
+				glClearBufferfv(GL_COLOR, isBackbuffer ? 0 : access.slot, &access.clearColor[0]);
+			else if(hasDepth && hasStencil)
+				glClearBufferfi(GL_DEPTH_STENCIL, 0, access.clearDepth, access.clearStencil);
+			else if(hasDepth)
+				glClearBufferfv(GL_DEPTH, 0, &access.clearDepth);
+			else
+				glClearBufferiv(GL_STENCIL, 0, &access.clearStencil);
+		} else if(access.load == LoadOp::DONT_CARE) {
+			if(access.type == AccessType::COLOR_TARGET)
+				invalidate[numInvalidate++] = isBackbuffer ? GL_COLOR : GL_COLOR_ATTACHMENT0 + access.slot;
+			else if(isBackbuffer) {
+				invalidate[numInvalidate++] = GL_DEPTH;
+				invalidate[numInvalidate++] = GL_STENCIL;
+			} else if(hasDepth && hasStencil)
+				invalidate[numInvalidate++] = GL_DEPTH_STENCIL_ATTACHMENT;
+			else
+				invalidate[numInvalidate++] = hasDepth ? GL_DEPTH_ATTACHMENT : GL_STENCIL_ATTACHMENT;
+			if(numInvalidate > 8)
+			{
+				glInvalidateFramebuffer(GL_FRAMEBUFFER, numInvalidate, invalidate);
+				numInvalidate = 0;
+			}
+		}
+	}
+	if(numInvalidate)
+		glInvalidateFramebuffer(GL_FRAMEBUFFER, numInvalidate, invalidate);
+}
+
+void gpupro::RenderGraph::execute(OGLContext& _context)
+{
+	CPU_ZONE("RenderGraph::execute");
+	GLuint currentFramebuffer = NO_FRAMEBUFFER;
+	for(auto& pass : m_passes)
+	{
+		if(!pass.alive) continue;
+
+		// Barriers and clears count towards the pass.
+		GpuScope scope(pass.name.c_str());
+		PipelineStatisticsScope statistics(pass.name.c_str(),
+			pass.framebuffer != NO_FRAMEBUFFER ? GLuint64(pass.viewport[0]) * pass.viewport[1] : 0);
+		if(pass.barrierBits)
+			glMemoryBarrier(pass.barrierBits);
+
+		if(pass.framebuffer != NO_FRAMEBUFFER)
+		{
+			if(pass.framebuffer != currentFramebuffer)
+			{
+				glBindFramebuffer(GL_FRAMEBUFFER, pass.framebuffer);
+				currentFramebuffer = pass.framebuffer;
+			}
+			glViewport(0, 0, pass.viewport[0], pass.viewport[1]);
+			clearTargets(_context, pass);
+		}
+
+		if(pass.execute)
+			pass.execute();
+	}
+	if(currentFramebuffer != 0 && currentFramebuffer != NO_FRAMEBUFFER)
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void gpupro::RenderGraph::reset()
+{
+	m_passes.clear();
+	m_resources.clear();
+	m_stats = Stats();
+}
@@ -1,4 +1,5 @@
 #include "shader.hpp"
+#include "shaderpreprocessor.hpp"
 
 #include <string>
 #include <vector>
@@ -23,7 +24,8 @@ gpupro::Shader::~Shader()
 
 gpupro::Shader::Shader(Shader&& _rhs) :
 	m_id(_rhs.m_id),
-	m_type(_rhs.m_type)
+	m_type(_rhs.m_type),
+	m_debugName(std::move(_rhs.m_debugName))
 {
 	_rhs.m_id = 0;
 }
@@ -34,17 +36,29 @@ gpupro::Shader& gpupro::Shader::operator=(Shader&& _rhs)
 
 	m_id = _rhs.m_id;
 	m_type = _rhs.m_type;
+	m_debugName = std::move(_rhs.m_debugName);
 	_rhs.m_id = 0;
 	return *this;
 }
 
 void gpupro::Shader::loadFromSource(const char* _source, const char* _debugName)
 {
+	submit(_source, _debugName);
+	checkStatus();
+}
+
+void gpupro::Shader::submit(const char* _source, const char* _debugName)
+{
+	m_debugName = _debugName ? _debugName : "";
 	// Attach one or multiple strings as source code.
 	glShaderSource(m_id, 1, &_source, nullptr);
 
 	// Compile
 	glCompileShader(m_id);
+}
+
+void gpupro::Shader::checkStatus()
+{
 	// Check success
 	GLint isCompiled = 0;
 	glGetShaderiv(m_id, GL_COMPILE_STATUS, &isCompiled);
@@ -56,17 +70,32 @@ void gpupro::Shader::loadFromSource(const char* _source, const char* _debugName)
 		std::string errorLog;
 		errorLog.resize(length);
 		glGetShaderInfoLog(m_id, length, &length, &errorLog[0]);
-		if(_debugName)
-			errorLog = "Failed to compile " + std::string(_debugName) + '\n' + errorLog;
+		if(!m_debugName.empty())
+			errorLog = "Failed to compile " + m_debugName + '\n' + errorLog;
 		else
 			errorLog = "Failed to compile shader " + std::to_string(m_id) + '\n' + errorLog;
 		throw std::exception(errorLog.c_str());
 	} else {
-		std::cerr << "INF: Successfully compiled " << (_debugName ? _debugName : "shader") << "\n";
+		std::cerr << "INF: Successfully compiled " << (m_debugName.empty() ? "shader" : m_debugName.c_str()) << "\n";
 	}
 }
 
-void gpupro::Shader::loadFromFile(const char* _fileName)
+bool gpupro::Shader::isReady() const
+{
+	if(!hasParallelShaderCompile())
+		return true;
+	GLint isCompleted = GL_TRUE;
+	glGetShaderiv(m_id, GL_COMPLETION_STATUS_KHR, &isCompleted);
+	return isCompleted == GL_TRUE;
+}
+
+void gpupro::Shader::loadFromFile(const char* _fileName, const ShaderDefines& _defines)
+{
+	const ShaderSource& source = ShaderPreprocessor::get(static_cast<Type>(m_type), _fileName, _defines);
+	loadFromSource(source.source.c_str(), source.name.c_str());
+}
+
+std::string gpupro::Shader::readFile(const char* _fileName)
 {
 	// Open the file
 	FILE* file = fopen(_fileName, "rb");
@@ -77,12 +106,11 @@ void gpupro::Shader::loadFromFile(const char* _fileName)
 	unsigned length = ftell(file);
 	fseek(file, 0, SEEK_SET);
 	std::string source;
-	source.resize(length + 1);
+	source.resize(length);
 
-	// Read file and add 0-termination
+	// Read file
 	fread(&source[0], length, 1, file);
-	source[length] = 0;
 	fclose(file);
 
-	loadFromSource(source.c_str(), _fileName);
+	return source;
 }
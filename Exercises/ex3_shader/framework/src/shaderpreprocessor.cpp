@@ -0,0 +1,243 @@
+#include "shaderpreprocessor.hpp"
+#include "timeline.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+
+namespace {
+
+	// A file with all includes resolved but without any defines.
+	struct ExpandedFile
+	{
+		std::string source;
+		GLuint64 hash;
+		size_t versionEnd;			///< Offset behind the #version line, 0 if there is none
+		GLuint versionLine;			///< Line number behind the #version line
+		std::string includeNames;	///< Source string numbers of the included files
+	};
+
+	struct VariantKey
+	{
+		GLuint64 sourceHash;
+		GLenum type;
+		gpupro::ShaderDefines defines;
+
+		bool operator == (const VariantKey& _other) const
+		{
+			return sourceHash == _other.sourceHash && type == _other.type && defines == _other.defines;
+		}
+	};
+
+	// FNV-1a
+	void hashBytes(GLuint64& _hash, const void* _data, size_t _size)
+	{
+		const unsigned char* bytes = static_cast<const unsigned char*>(_data);
+		for(size_t i = 0; i < _size; ++i)
+		{
+			_hash ^= bytes[i];
+			_hash *= 0x100000001b3ull;
+		}
+	}
+
+	struct VariantKeyHash
+	{
+		size_t operator () (const VariantKey& _key) const
+		{
+			GLuint64 hash = 0xcbf29ce484222325ull;
+			hashBytes(hash, &_key.sourceHash, sizeof(_key.sourceHash));
+			hashBytes(hash, &_key.type, sizeof(_key.type));
+			// Include the terminating 0, such that "ab"+"c" != "a"+"bc".
+			for(auto& define : _key.defines)
+			{
+				hashBytes(hash, define.first.c_str(), define.first.size() + 1);
+				hashBytes(hash, define.second.c_str(), define.second.size() + 1);
+			}
+			return static_cast<size_t>(hash);
+		}
+	};
+
+}
+
+static std::unordered_map<std::string, ExpandedFile> s_files;
+static std::unordered_map<VariantKey, gpupro::ShaderSource, VariantKeyHash> s_variants;
+
+static std::string directoryOf(const std::string& _fileName)
+{
+	size_t slash = _fileName.find_last_of("/\\");
+	return slash == std::string::npos ? std::string() : _fileName.substr(0, slash + 1);
+}
+
+// If _line is the given directive, returns the first character behind its
+// name, otherwise nullptr.
+static const char* matchDirective(const char* _line, const char* _directive)
+{
+	while(*_line == ' ' || *_line == '\t') ++_line;
+	if(*_line != '#') return nullptr;
+	++_line;
+	while(*_line == ' ' || *_line == '\t') ++_line;
+	size_t length = strlen(_directive);
+	if(strncmp(_line, _directive, length) != 0) return nullptr;
+	_line += length;
+	// E.g. #includes is not an #include.
+	if(isalnum(static_cast<unsigned char>(*_line)) || *_line == '_') return nullptr;
+	return _line;
+}
+
+// Append the file to _out.source and recursively resolve its includes.
+// _files contains all files seen so far, their index is the source string
+// number used in #line directives.
+static void expand(const std::string& _fileName, GLuint _fileIndex, std::vector<std::string>& _files, ExpandedFile& _out)
+{
+	std::string text = gpupro::Shader::readFile(_fileName.c_str());
+	GLuint lineNumber = 0;
+	size_t pos = 0;
+	while(pos < text.size())
+	{
+		size_t end = text.find('\n', pos);
+		if(end == std::string::npos) end = text.size();
+		std::string line = text.substr(pos, end - pos);
+		if(!line.empty() && line.back() == '\r') line.pop_back();
+		pos = end + 1;
+		++lineNumber;
+
+		if(const char* arguments = matchDirective(line.c_str(), "include"))
+		{
+			const char* begin = strpbrk(arguments, "\"<");
+			const char* close = begin ? strchr(begin + 1, *begin == '"' ? '"' : '>') : nullptr;
+			if(close)
+			{
+				std::string path = directoryOf(_fileName) + std::string(begin + 1, close);
+				if(std::find(_files.begin(), _files.end(), path) == _files.end())
+				{
+					GLuint index = static_cast<GLuint>(_files.size());
+					_files.push_back(path);
+					_out.source += "#line 1 " + std::to_string(index) + '\n';
+					expand(path, index, _files, _out);
+					_out.source += "#line " + std::to_string(lineNumber + 1) + ' ' + std::to_string(_fileIndex) + '\n';
+				} else
+					_out.source += '\n';
+				continue;
+			}
+			// Keep the line, the compiler reports it with the correct line.
+			std::cerr << "ERR: Malformed #include in " << _fileName << '(' << lineNumber << ")\n";
+		} else if(matchDirective(line.c_str(), "version"))
+		{
+			// Included files may have their own #version for editors and
+			// other tools. Only the first line of the main file counts.
+			if(_fileIndex == 0 && _out.versionEnd == 0)
+			{
+				_out.source += line + '\n';
+				_out.versionEnd = _out.source.size();
+				_out.versionLine = lineNumber + 1;
+			} else
+				_out.source += '\n';
+			continue;
+		}
+		_out.source += line + '\n';
+	}
+}
+
+static const ExpandedFile& expandFile(const char* _fileName)
+{
+	auto it = s_files.find(_fileName);
+	if(it != s_files.end())
+		return it->second;
+
+	CPU_ZONE("ShaderPreprocessor::expandFile");
+	ExpandedFile file;
+	file.versionEnd = 0;
+	file.versionLine = 1;
+	std::vector<std::string> files(1, _fileName);
+	expand(_fileName, 0, files, file);
+	for(size_t i = 1; i < files.size(); ++i)
+		file.includeNames += (i == 1 ? " (" : ", ") + std::to_string(i) + ": " + files[i];
+	if(files.size() > 1)
+		file.includeNames += ')';
+	file.hash = 0xcbf29ce484222325ull;
+	hashBytes(file.hash, file.source.data(), file.source.size());
+	return s_files.emplace(_fileName, std::move(file)).first->second;
+}
+
+const gpupro::ShaderSource& gpupro::ShaderPreprocessor::get(Shader::Type _type, const char* _fileName, const ShaderDefines& _defines)
+{
+	const ExpandedFile& file = expandFile(_fileName);
+	VariantKey key = {file.hash, static_cast<GLenum>(_type), _defines};
+	auto it = s_variants.find(key);
+	if(it != s_variants.end())
+		return it->second;
+
+	CPU_ZONE("ShaderPreprocessor::get");
+	ShaderSource variant;
+	variant.type = _type;
+	variant.name = _fileName;
+	if(_defines.empty())
+		variant.source = file.source;
+	else
+	{
+		std::string defines;
+		const char* separator = " [";
+		for(auto& define : _defines)
+		{
+			defines += "#define " + define.first;
+			if(!define.second.empty())
+				defines += ' ' + define.second;
+			defines += '\n';
+			variant.name += separator + define.first;
+			separator = ", ";
+			if(!define.second.empty())
+				variant.name += '=' + define.second;
+		}
+		variant.name += ']';
+		defines += "#line " + std::to_string(file.versionLine) + " 0\n";
+		variant.source.reserve(file.source.size() + defines.size());
+		variant.source.append(file.source, 0, file.versionEnd);
+		variant.source += defines;
+		variant.source.append(file.source, file.versionEnd, std::string::npos);
+	}
+	variant.name += file.includeNames;
+	return s_variants.emplace(std::move(key), std::move(variant)).first->second;
+}
+
+void gpupro::ShaderPreprocessor::clear()
+{
+	s_variants.clear();
+	s_files.clear();
+}
+
+size_t gpupro::ShaderPreprocessor::numVariants()
+{
+	return s_variants.size();
+}
+
+gpupro::ProgramVariants::ProgramVariants(std::vector<Stage> _stages, bool _separable) :
+	m_stages(std::move(_stages)),
+	m_separable(_separable)
+{
+}
+
+void gpupro::ProgramVariants::request(const ShaderDefines& _defines)
+{
+	find(_defines);
+}
+
+gpupro::Program& gpupro::ProgramVariants::get(const ShaderDefines& _defines)
+{
+	return find(_defines).program();
+}
+
+gpupro::PendingProgram& gpupro::ProgramVariants::find(const ShaderDefines& _defines)
+{
+	auto it = m_variants.find(_defines);
+	if(it == m_variants.end())
+	{
+		std::vector<ShaderSource> sources;
+		sources.reserve(m_stages.size());
+		for(auto& stage : m_stages)
+			sources.push_back(ShaderPreprocessor::get(stage.type, stage.fileName.c_str(), _defines));
+		it = m_variants.emplace(_defines, ProgramCache::request(sources, m_separable)).first;
+	}
+	return it->second;
+}
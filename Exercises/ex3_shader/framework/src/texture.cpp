@@ -1,4 +1,6 @@
 #include "texture.hpp"
+#include "deletionqueue.hpp"
+#include "timeline.hpp"
 
 #include <iostream>
 #include <algorithm>
@@ -16,6 +18,18 @@ static GLsizei computeCorrectedMipmapLevels(GLsizei _numMipLevels, GLsizei _maxR
 		return std::min(maxMip, _numMipLevels);
 }
 
+// Get a new texture name. With DSA the object is created immediately
+// (requires the target), otherwise it is created on first bind.
+static GLuint createTextureName(gpupro::Texture::Layout _layout)
+{
+	GLuint id;
+	if(gpupro::hasDSA())
+		glCreateTextures(static_cast<GLenum>(_layout), 1, &id);
+	else
+		glGenTextures(1, &id);
+	return id;
+}
+
 gpupro::Texture::Texture(Layout _layout, InternalFormat _format) :
 	m_id(0),
 	m_layout(_layout),
@@ -34,7 +48,7 @@ gpupro::Texture::Texture(Layout _layout, GLsizei _width, InternalFormat _format,
 	m_layout(_layout),
 	m_format(_format)
 {
-	glGenTextures(1, &m_id);
+	m_id = createTextureName(_layout);
 
 	m_numMipLevels = computeCorrectedMipmapLevels(_numMipLevels, _width);
 
@@ -64,7 +78,7 @@ gpupro::Texture::Texture(Layout _layout, GLsizei _width, GLsizei _height, Intern
 	m_layout(_layout),
 	m_format(_format)
 {
-	glGenTextures(1, &m_id);
+	m_id = createTextureName(_layout);
 
 	switch(_layout)
 	{
@@ -91,7 +105,7 @@ gpupro::Texture::Texture(Layout _layout, GLsizei _width, GLsizei _height, GLsize
 	m_layout(_layout),
 	m_format(_format)
 {
-	glGenTextures(1, &m_id);
+	m_id = createTextureName(_layout);
 
 	switch(_layout)
 	{
@@ -111,7 +125,7 @@ gpupro::Texture::Texture(Layout _layout, GLsizei _width, GLsizei _height, GLsize
 
 gpupro::Texture::~Texture()
 {
-	glDeleteTextures(1, &m_id);
+	DeletionQueue::release(DeletionQueue::ObjectType::TEXTURE, m_id);
 }
 
 gpupro::Texture::Texture(Texture&& _rhs) :
@@ -126,7 +140,7 @@ gpupro::Texture::Texture(Texture&& _rhs) :
 
 gpupro::Texture& gpupro::Texture::operator=(Texture&& _rhs)
 {
-	glDeleteTextures(1, &m_id);
+	DeletionQueue::release(DeletionQueue::ObjectType::TEXTURE, m_id);
 
 	m_id = _rhs.m_id;
 	m_layout = _rhs.m_layout;
@@ -140,6 +154,7 @@ gpupro::Texture& gpupro::Texture::operator=(Texture&& _rhs)
 
 void gpupro::Texture::load(const char* _fileName, GLuint _layer, bool _generateMipMaps)
 {
+	CPU_ZONE("Texture::load");
 	int width = -1;
 	int height = -1;
 	int numComps = -1;
@@ -165,7 +180,7 @@ void gpupro::Texture::load(const char* _fileName, GLuint _layer, bool _generateM
 			*this = std::move(Texture(m_layout, width, height, m_format, _generateMipMaps ? 0 : 1));
 		} else {
 			// Texture was created without allocation
-			glGenTextures(1, &m_id);
+			m_id = createTextureName(m_layout);
 			m_size[0] = width;
 			m_size[1] = height;
 			m_size[2] = 1;
@@ -189,14 +204,41 @@ void gpupro::Texture::load(const char* _fileName, GLuint _layer, bool _generateM
 	if(_generateMipMaps) {
 		if(m_layout != Layout::CUBE_MAP || _layer == 5)
 		{
-			glBindTexture(static_cast<GLenum>(m_layout), m_id);
-			glGenerateMipmap(static_cast<GLenum>(m_layout));
+			if(hasDSA())
+				glGenerateTextureMipmap(m_id);
+			else {
+				glBindTexture(static_cast<GLenum>(m_layout), m_id);
+				glGenerateMipmap(static_cast<GLenum>(m_layout));
+			}
 		}
 	}
 }
 
 void gpupro::Texture::setData(GLuint _mipLevel, GLuint _layer, SetDataFormat _format, SetDataType _type, const void* _data)
 {
+	if(hasDSA())
+	{
+		switch(m_layout)
+		{
+		case Layout::TEX_1D:
+			glTextureSubImage1D(m_id, _mipLevel, 0, m_size[0], static_cast<GLenum>(_format), static_cast<GLenum>(_type), _data);
+			break;
+		case Layout::TEX_2D:
+			glTextureSubImage2D(m_id, _mipLevel, 0, 0, m_size[0], m_size[1], static_cast<GLenum>(_format), static_cast<GLenum>(_type), _data);
+			break;
+		case Layout::TEX_3D:
+			glTextureSubImage3D(m_id, _mipLevel, 0, 0, 0, m_size[0], m_size[1], m_size[2], static_cast<GLenum>(_format), static_cast<GLenum>(_type), _data);
+			break;
+		// DSA treats the faces of a cube map like layers of an array.
+		case Layout::CUBE_MAP:
+		case Layout::TEX_2D_ARRAY:
+		case Layout::CUBE_MAP_ARRAY:
+			glTextureSubImage3D(m_id, _mipLevel, 0, 0, _layer, m_size[0], m_size[1], 1, static_cast<GLenum>(_format), static_cast<GLenum>(_type), _data);
+			break;
+		}
+		return;
+	}
+
 	glBindTexture(static_cast<GLenum>(m_layout), m_id);
 	switch(m_layout)
 	{
@@ -221,12 +263,43 @@ void gpupro::Texture::setData(GLuint _mipLevel, GLuint _layer, SetDataFormat _fo
 
 void gpupro::Texture::bindAsTexture(GLuint _bindingIndex)
 {
-	glActiveTexture(GL_TEXTURE0 + _bindingIndex);
-	glBindTexture(static_cast<GLenum>(m_layout), m_id);
+	if(hasDSA())
+		glBindTextureUnit(_bindingIndex, m_id);
+	else {
+		glActiveTexture(GL_TEXTURE0 + _bindingIndex);
+		glBindTexture(static_cast<GLenum>(m_layout), m_id);
+	}
+}
+
+void gpupro::Texture::bindAsImage(GLuint _bindingIndex, ImageAccess _access, GLuint _mipLevel)
+{
+	glBindImageTexture(_bindingIndex, m_id, _mipLevel, GL_TRUE, 0, static_cast<GLenum>(_access), static_cast<GLenum>(m_format));
 }
 
 void gpupro::Texture::allocateMemory()
 {
+	if(hasDSA())
+	{
+		switch(m_layout)
+		{
+		case Layout::TEX_1D:
+			glTextureStorage1D(m_id, m_numMipLevels, static_cast<GLenum>(m_format), m_size[0]);
+			break;
+		case Layout::TEX_2D:
+		case Layout::CUBE_MAP:
+			glTextureStorage2D(m_id, m_numMipLevels, static_cast<GLenum>(m_format), m_size[0], m_size[1]);
+			break;
+		case Layout::TEX_3D:
+		case Layout::TEX_2D_ARRAY:
+			glTextureStorage3D(m_id, m_numMipLevels, static_cast<GLenum>(m_format), m_size[0], m_size[1], m_size[2]);
+			break;
+		case Layout::CUBE_MAP_ARRAY:
+			glTextureStorage3D(m_id, m_numMipLevels, static_cast<GLenum>(m_format), m_size[0], m_size[1], m_size[2] * 6);
+			break;
+		}
+		return;
+	}
+
 	glBindTexture(static_cast<GLenum>(m_layout), m_id);
 
 	switch(m_layout)
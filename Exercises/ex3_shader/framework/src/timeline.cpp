@@ -0,0 +1,325 @@
+#include "timeline.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define GPUPRO_RDTSC
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+namespace {
+
+	enum class EventType : GLuint
+	{
+		BEGIN,
+		END,
+		FRAME
+	};
+
+	struct Event
+	{
+		const char* name;
+		GLint64 time;		///< Ticks, see ticks()
+		EventType type;
+	};
+
+	// Written by its thread only. The exporting thread reads from
+	// firstEvent up to numEvents. The buffer of a finished thread is reused
+	// by the next new thread (e.g. the workers of a DrawQueue).
+	struct ThreadBuffer
+	{
+		std::unique_ptr<Event[]> events;
+		std::atomic<GLuint64> numEvents;
+		GLuint64 firstEvent;
+		std::string name;
+		GLuint id;
+		bool inUse;
+	};
+
+	// Returns the buffer when the thread ends.
+	struct ThreadBufferOwner
+	{
+		ThreadBuffer* buffer;
+		~ThreadBufferOwner();
+	};
+
+	struct GpuEvent
+	{
+		std::string name;
+		GLint64 begin, end;	///< GPU ns
+	};
+
+	const GLuint EVENT_MASK = static_cast<GLuint>(gpupro::Timeline::EVENTS_PER_THREAD - 1);
+	// Frames between two calibrations of the GPU clock.
+	const GLuint CALIBRATION_INTERVAL = 256;
+	const GLuint GPU_THREAD_ID = 0;
+
+}
+
+static GLint64 now();
+static GLint64 ticks();
+
+static std::atomic<bool> s_enabled(false);
+static const std::chrono::high_resolution_clock::time_point s_start = std::chrono::high_resolution_clock::now();
+static const GLint64 s_startTicks = ticks();
+static std::mutex s_threadsMutex;
+static std::vector<std::unique_ptr<ThreadBuffer>> s_threads;
+// Plain pointer for fast access. The owner returns the buffer on exit.
+static thread_local ThreadBuffer* t_buffer = nullptr;
+static std::vector<GpuEvent> s_gpuEvents;
+static size_t s_nextGpuEvent = 0;
+static GLint64 s_gpuOffset = 0;			///< CPU time - GPU time
+static bool s_calibrated = false;
+static GLuint s_framesSinceCalibration = 0;
+
+// ns since the start of the program
+static GLint64 now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now() - s_start).count();
+}
+
+// Zones use the time stamp counter of the CPU where available. Reading it
+// is several times faster than the system clock. Its frequency is measured
+// against the system clock on export.
+static GLint64 ticks()
+{
+#ifdef GPUPRO_RDTSC
+	return static_cast<GLint64>(__rdtsc());
+#else
+	return now();
+#endif
+}
+
+static double nsPerTick()
+{
+#ifdef GPUPRO_RDTSC
+	GLint64 elapsedTicks = ticks() - s_startTicks;
+	return elapsedTicks > 0 ? static_cast<double>(now()) / elapsedTicks : 1.0;
+#else
+	return 1.0;
+#endif
+}
+
+ThreadBufferOwner::~ThreadBufferOwner()
+{
+	if(buffer)
+	{
+		std::lock_guard<std::mutex> lock(s_threadsMutex);
+		buffer->inUse = false;
+	}
+}
+
+static ThreadBuffer* registerThread()
+{
+	std::lock_guard<std::mutex> lock(s_threadsMutex);
+	for(auto& buffer : s_threads)
+		if(!buffer->inUse)
+		{
+			buffer->inUse = true;
+			return buffer.get();
+		}
+	std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer);
+	buffer->events.reset(new Event[gpupro::Timeline::EVENTS_PER_THREAD]);
+	buffer->numEvents = 0;
+	buffer->firstEvent = 0;
+	buffer->id = static_cast<GLuint>(s_threads.size()) + 1;
+	buffer->name = buffer->id == 1 ? "Main" : "Thread " + std::to_string(buffer->id);
+	buffer->inUse = true;
+	s_threads.push_back(std::move(buffer));
+	return s_threads.back().get();
+}
+
+static ThreadBuffer& threadBuffer()
+{
+	if(!t_buffer)
+	{
+		static thread_local ThreadBufferOwner owner = {nullptr};
+		t_buffer = owner.buffer = registerThread();
+	}
+	return *t_buffer;
+}
+
+static void record(const char* _name, EventType _type)
+{
+	ThreadBuffer& buffer = threadBuffer();
+	GLuint64 index = buffer.numEvents.load(std::memory_order_relaxed);
+	Event& event = buffer.events[index & EVENT_MASK];
+	event.name = _name;
+	event.time = ticks();
+	event.type = _type;
+	buffer.numEvents.store(index + 1, std::memory_order_release);
+}
+
+static void calibrate()
+{
+	// The query returns the current GPU time without waiting for queued
+	// commands. Take the middle of the CPU times around it.
+	GLint64 cpuBefore = now();
+	GLint64 gpuTime = 0;
+	glGetInteger64v(GL_TIMESTAMP, &gpuTime);
+	GLint64 cpuAfter = now();
+	s_gpuOffset = (cpuBefore + cpuAfter) / 2 - gpuTime;
+	s_calibrated = true;
+	s_framesSinceCalibration = 0;
+}
+
+// Names of zones may contain anything.
+static void writeString(FILE* _file, const char* _string)
+{
+	fputc('"', _file);
+	for(; *_string; ++_string)
+	{
+		unsigned char c = static_cast<unsigned char>(*_string);
+		if(c == '"' || c == '\\')
+			fprintf(_file, "\\%c", c);
+		else if(c < 0x20)
+			fprintf(_file, "\\u%04x", c);
+		else
+			fputc(c, _file);
+	}
+	fputc('"', _file);
+}
+
+void gpupro::Timeline::setEnabled(bool _enable)
+{
+	s_enabled.store(_enable, std::memory_order_relaxed);
+	// The GPU clock is calibrated with the next frame, there might be no
+	// context yet.
+	s_calibrated = false;
+}
+
+bool gpupro::Timeline::isEnabled()
+{
+	return s_enabled.load(std::memory_order_relaxed);
+}
+
+void gpupro::Timeline::setThreadName(const char* _name)
+{
+	ThreadBuffer& buffer = threadBuffer();
+	std::lock_guard<std::mutex> lock(s_threadsMutex);
+	buffer.name = _name;
+}
+
+void gpupro::Timeline::beginZone(const char* _name)
+{
+	if(s_enabled.load(std::memory_order_relaxed))
+		record(_name, EventType::BEGIN);
+}
+
+void gpupro::Timeline::endZone()
+{
+	// Zones which began before the recording was enabled create an
+	// unmatched end. The export ignores these.
+	if(s_enabled.load(std::memory_order_relaxed))
+		record(nullptr, EventType::END);
+}
+
+void gpupro::Timeline::endFrame()
+{
+	if(!isEnabled())
+		return;
+	record(nullptr, EventType::FRAME);
+	if(!s_calibrated || ++s_framesSinceCalibration >= CALIBRATION_INTERVAL)
+		calibrate();
+}
+
+void gpupro::Timeline::addGpuZone(const std::string& _name, GLuint64 _begin, GLuint64 _end)
+{
+	if(!isEnabled() || !s_calibrated)
+		return;
+	GpuEvent event = {_name, static_cast<GLint64>(_begin) + s_gpuOffset, static_cast<GLint64>(_end) + s_gpuOffset};
+	if(s_gpuEvents.size() < EVENTS_PER_THREAD)
+		s_gpuEvents.push_back(std::move(event));
+	else
+		s_gpuEvents[s_nextGpuEvent] = std::move(event);
+	s_nextGpuEvent = (s_nextGpuEvent + 1) % EVENTS_PER_THREAD;
+}
+
+bool gpupro::Timeline::exportChromeTrace(const char* _fileName)
+{
+	FILE* file = fopen(_fileName, "wb");
+	if(!file)
+	{
+		std::cerr << "ERR: Cannot open " << _fileName << " for the timeline.\n";
+		return false;
+	}
+
+	// Times in the trace are in us.
+	fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"GPU\"}}", GPU_THREAD_ID);
+	size_t numEvents = 0;
+	const double usPerTick = nsPerTick() / 1000.0;
+	std::lock_guard<std::mutex> lock(s_threadsMutex);
+	for(auto& thread : s_threads)
+	{
+		fprintf(file, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", thread->id);
+		writeString(file, thread->name.c_str());
+		fprintf(file, "}}");
+
+		GLuint64 end = thread->numEvents.load(std::memory_order_acquire);
+		GLuint64 begin = std::max<GLuint64>(thread->firstEvent, end > EVENTS_PER_THREAD ? end - EVENTS_PER_THREAD : 0);
+		// Ends whose begin was overwritten (or not recorded) are skipped.
+		int depth = 0;
+		for(GLuint64 i = begin; i < end; ++i)
+		{
+			const Event& event = thread->events[i & EVENT_MASK];
+			double time = (event.time - s_startTicks) * usPerTick;
+			switch(event.type)
+			{
+			case EventType::BEGIN:
+				++depth;
+				fprintf(file, ",\n{\"name\":");
+				writeString(file, event.name);
+				fprintf(file, ",\"ph\":\"B\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}", thread->id, time);
+				break;
+			case EventType::END:
+				if(depth == 0) continue;
+				--depth;
+				fprintf(file, ",\n{\"ph\":\"E\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}", thread->id, time);
+				break;
+			case EventType::FRAME:
+				fprintf(file, ",\n{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}", thread->id, time);
+				break;
+			}
+			++numEvents;
+		}
+	}
+
+	// Complete events, nested by their times.
+	for(auto& event : s_gpuEvents)
+	{
+		fprintf(file, ",\n{\"name\":");
+		writeString(file, event.name.c_str());
+		fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", GPU_THREAD_ID, event.begin / 1000.0, (event.end - event.begin) / 1000.0);
+		++numEvents;
+	}
+	fprintf(file, "\n]}\n");
+	bool success = ferror(file) == 0;
+	fclose(file);
+	if(success)
+		std::cerr << "INF: Wrote " << numEvents << " timeline events to " << _fileName << '\n';
+	else
+		std::cerr << "ERR: Cannot write the timeline to " << _fileName << '\n';
+	return success;
+}
+
+void gpupro::Timeline::clear()
+{
+	// Only the owner may write numEvents. Skip everything recorded so far
+	// instead.
+	std::lock_guard<std::mutex> lock(s_threadsMutex);
+	for(auto& thread : s_threads)
+		thread->firstEvent = thread->numEvents.load(std::memory_order_acquire);
+	s_gpuEvents.clear();
+	s_nextGpuEvent = 0;
+}
@@ -1,4 +1,7 @@
 #include "vertexformat.hpp"
+#include "deletionqueue.hpp"
+#include <algorithm>
+#include <unordered_map>
 
 static bool isIntegerType(gpupro::VertexAttribute::Type _t)
 {
@@ -18,6 +21,29 @@ static bool isIntegerType(gpupro::VertexAttribute::Type _t)
 
 gpupro::VertexFormat::VertexFormat(const std::vector<VertexAttribute>& _attributes)
 {
+	if(hasDSA())
+	{
+		glCreateVertexArrays(1, &m_id);
+		for(auto& attr : _attributes)
+		{
+			glEnableVertexArrayAttrib(m_id, attr.attributIndex);
+			if(attr.type == VertexAttribute::Type::DOUBLE)
+				glVertexArrayAttribLFormat(m_id, attr.attributIndex, attr.numComponents, (GLenum)attr.type, attr.offset);
+			else if(!attr.normalized && isIntegerType(attr.type))
+				glVertexArrayAttribIFormat(m_id, attr.attributIndex, attr.numComponents, (GLenum)attr.type, attr.offset);
+			else
+				glVertexArrayAttribFormat(m_id, attr.attributIndex, attr.numComponents, (GLenum)attr.type, attr.normalized, attr.offset);
+			glVertexArrayAttribBinding(m_id, attr.attributIndex, attr.vboBindingIndex);
+			// The divisor is a property of the buffer binding point.
+			glVertexArrayBindingDivisor(m_id, attr.vboBindingIndex, attr.divisor);
+		}
+		return;
+	}
+
+	// Bind-to-edit: restore the previous binding afterwards, because the
+	// OGLContext does not expect the binding to change behind its back.
+	GLint previousVAO = 0;
+	glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &previousVAO);
 	glGenVertexArrays(1, &m_id);
 	glBindVertexArray(m_id);
 
@@ -35,11 +61,12 @@ gpupro::VertexFormat::VertexFormat(const std::vector<VertexAttribute>& _attribut
 		// Otherwise it is overwritten and expects attribIndex == vboIndex.
 		glVertexAttribBinding(attr.attributIndex, attr.vboBindingIndex);
 	}
+	glBindVertexArray(previousVAO);
 }
 
 gpupro::VertexFormat::~VertexFormat()
 {
-	glDeleteVertexArrays(1, &m_id);
+	DeletionQueue::release(DeletionQueue::ObjectType::VERTEX_ARRAY, m_id);
 }
 
 gpupro::VertexFormat::VertexFormat(VertexFormat&& _rhs) :
@@ -50,10 +77,85 @@ gpupro::VertexFormat::VertexFormat(VertexFormat&& _rhs) :
 
 gpupro::VertexFormat& gpupro::VertexFormat::operator=(VertexFormat&& _rhs)
 {
-	glDeleteVertexArrays(1, &m_id);
+	DeletionQueue::release(DeletionQueue::ObjectType::VERTEX_ARRAY, m_id);
 
 	m_id = _rhs.m_id;
 	_rhs.m_id = 0;
 
 	return *this;
 }
+
+
+// Attributes sorted by their index. Fields are compared one by one, such
+// that padding bytes do not matter.
+typedef std::vector<gpupro::VertexAttribute> AttributeList;
+
+struct AttributeListHash
+{
+	size_t operator()(const AttributeList& _attributes) const
+	{
+		// FNV-1a over all fields
+		GLuint64 hash = 0xcbf29ce484222325ull;
+		auto hashValue = [&hash](GLuint64 _value) {
+			for(int i = 0; i < 8; ++i)
+			{
+				hash ^= (_value >> (i * 8)) & 0xff;
+				hash *= 0x100000001b3ull;
+			}
+		};
+		for(auto& attr : _attributes)
+		{
+			hashValue(attr.attributIndex | (static_cast<GLuint64>(attr.vboBindingIndex) << 32));
+			hashValue(static_cast<GLuint>(attr.numComponents) | (static_cast<GLuint64>(attr.type) << 32));
+			hashValue(attr.normalized | (static_cast<GLuint64>(attr.offset) << 32));
+			hashValue(attr.divisor);
+		}
+		return static_cast<size_t>(hash);
+	}
+};
+
+struct AttributeListEqual
+{
+	bool operator()(const AttributeList& _lhs, const AttributeList& _rhs) const
+	{
+		return std::equal(_lhs.begin(), _lhs.end(), _rhs.begin(), _rhs.end(),
+			[](const gpupro::VertexAttribute& _a, const gpupro::VertexAttribute& _b) {
+				return _a.attributIndex == _b.attributIndex
+					&& _a.vboBindingIndex == _b.vboBindingIndex
+					&& _a.numComponents == _b.numComponents
+					&& _a.type == _b.type
+					&& _a.normalized == _b.normalized
+					&& _a.offset == _b.offset
+					&& _a.divisor == _b.divisor;
+			});
+	}
+};
+
+// Expired entries are replaced when the same layout is requested again.
+static std::unordered_map<AttributeList, std::weak_ptr<gpupro::VertexFormat>, AttributeListHash, AttributeListEqual> s_vertexFormatCache;
+
+std::shared_ptr<gpupro::VertexFormat> gpupro::VertexFormatCache::get(const std::vector<VertexAttribute>& _attributes)
+{
+	AttributeList key = _attributes;
+	std::stable_sort(key.begin(), key.end(), [](const VertexAttribute& _lhs, const VertexAttribute& _rhs) {
+		return _lhs.attributIndex < _rhs.attributIndex;
+	});
+
+	std::weak_ptr<VertexFormat>& entry = s_vertexFormatCache[key];
+	std::shared_ptr<VertexFormat> format = entry.lock();
+	if(!format)
+	{
+		format = std::make_shared<VertexFormat>(key);
+		entry = format;
+	}
+	return format;
+}
+
+size_t gpupro::VertexFormatCache::numFormats()
+{
+	size_t num = 0;
+	for(auto& it : s_vertexFormatCache)
+		if(!it.second.expired())
+			++num;
+	return num;
+}
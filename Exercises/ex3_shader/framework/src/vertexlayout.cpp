@@ -0,0 +1,258 @@
+#include "vertexlayout.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// SSE2 is part of every x64 CPU and the default of MSVC for 32 bit targets.
+#if defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define GPUPRO_SSE2
+#include <emmintrin.h>
+#endif
+
+// Scale, clamp and round to nearest. The vector paths use the same
+// rounding (cvtps rounds to nearest even in the default mode). NaN is
+// clamped to _min as by _mm_max_ps.
+template<typename T>
+static void packNormalizedScalar(const float* _in, T* _out, size_t _count, float _min, float _scale)
+{
+	for(size_t i = 0; i < _count; ++i)
+	{
+		float v = std::min(std::max(_min, _in[i]), 1.0f);
+		_out[i] = static_cast<T>(std::nearbyint(v * _scale));
+	}
+}
+
+#ifdef GPUPRO_SSE2
+// Convert 8 floats into 8 clamped, scaled and rounded 32 bit integers.
+static void quantize8(const float* _in, __m128 _min, __m128 _scale, __m128i& _lo, __m128i& _hi)
+{
+	const __m128 one = _mm_set1_ps(1.0f);
+	__m128 a = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(_in), _min), one);
+	__m128 b = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(_in + 4), _min), one);
+	_lo = _mm_cvtps_epi32(_mm_mul_ps(a, _scale));
+	_hi = _mm_cvtps_epi32(_mm_mul_ps(b, _scale));
+}
+#endif
+
+void gpupro::pack(const float* _in, GLbyte* _out, size_t _count)
+{
+	size_t i = 0;
+#ifdef GPUPRO_SSE2
+	const __m128 minV = _mm_set1_ps(-1.0f), scale = _mm_set1_ps(127.0f);
+	for(; i + 16 <= _count; i += 16)
+	{
+		__m128i a, b, c, d;
+		quantize8(_in + i, minV, scale, a, b);
+		quantize8(_in + i + 8, minV, scale, c, d);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(_out + i), _mm_packs_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+	}
+#endif
+	packNormalizedScalar(_in + i, _out + i, _count - i, -1.0f, 127.0f);
+}
+
+void gpupro::pack(const float* _in, GLubyte* _out, size_t _count)
+{
+	size_t i = 0;
+#ifdef GPUPRO_SSE2
+	const __m128 minV = _mm_setzero_ps(), scale = _mm_set1_ps(255.0f);
+	for(; i + 16 <= _count; i += 16)
+	{
+		__m128i a, b, c, d;
+		quantize8(_in + i, minV, scale, a, b);
+		quantize8(_in + i + 8, minV, scale, c, d);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(_out + i), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+	}
+#endif
+	packNormalizedScalar(_in + i, _out + i, _count - i, 0.0f, 255.0f);
+}
+
+void gpupro::pack(const float* _in, GLshort* _out, size_t _count)
+{
+	size_t i = 0;
+#ifdef GPUPRO_SSE2
+	const __m128 minV = _mm_set1_ps(-1.0f), scale = _mm_set1_ps(32767.0f);
+	for(; i + 8 <= _count; i += 8)
+	{
+		__m128i a, b;
+		quantize8(_in + i, minV, scale, a, b);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(_out + i), _mm_packs_epi32(a, b));
+	}
+#endif
+	packNormalizedScalar(_in + i, _out + i, _count - i, -1.0f, 32767.0f);
+}
+
+void gpupro::pack(const float* _in, GLushort* _out, size_t _count)
+{
+	size_t i = 0;
+#ifdef GPUPRO_SSE2
+	// There is no unsigned saturation from 32 to 16 bit in SSE2. Shift the
+	// range to signed, pack and flip the sign bit back.
+	const __m128 minV = _mm_setzero_ps(), scale = _mm_set1_ps(65535.0f);
+	const __m128i bias32 = _mm_set1_epi32(32768);
+	const __m128i bias16 = _mm_set1_epi16(-32768);
+	for(; i + 8 <= _count; i += 8)
+	{
+		__m128i a, b;
+		quantize8(_in + i, minV, scale, a, b);
+		__m128i packed = _mm_packs_epi32(_mm_sub_epi32(a, bias32), _mm_sub_epi32(b, bias32));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(_out + i), _mm_xor_si128(packed, bias16));
+	}
+#endif
+	packNormalizedScalar(_in + i, _out + i, _count - i, 0.0f, 65535.0f);
+}
+
+// Round to nearest even, overflow to infinity, NaN stays NaN.
+// Based on the well known branchless conversion by F. Giesen.
+static GLushort floatToHalf(float _value)
+{
+	const GLuint F16_MAX = (127 + 16) << 23;			// All values >= this are infinite
+	const GLuint MIN_NORMAL = (127 - 14) << 23;			// Smallest float which is a normal half
+	const GLuint SUBNORMAL_MAGIC = ((127 - 15) + (23 - 10) + 1) << 23;
+
+	GLuint bits;
+	memcpy(&bits, &_value, sizeof(bits));
+	GLuint sign = bits & 0x80000000u;
+	bits ^= sign;
+
+	GLuint result;
+	if(bits >= F16_MAX)
+		result = bits > 0x7f800000u ? 0x7e00 : 0x7c00;
+	else if(bits < MIN_NORMAL)
+	{
+		// The float addition rounds the mantissa.
+		float magic, tmp;
+		memcpy(&magic, &SUBNORMAL_MAGIC, sizeof(magic));
+		memcpy(&tmp, &bits, sizeof(tmp));
+		tmp += magic;
+		memcpy(&result, &tmp, sizeof(result));
+		result -= SUBNORMAL_MAGIC;
+	} else {
+		GLuint mantissaOdd = (bits >> 13) & 1;
+		bits += (static_cast<GLuint>(15 - 127) << 23) + 0xfff;
+		bits += mantissaOdd;
+		result = bits >> 13;
+	}
+	return static_cast<GLushort>(result | (sign >> 16));
+}
+
+static float halfToFloat(GLushort _value)
+{
+	GLuint sign = static_cast<GLuint>(_value & 0x8000) << 16;
+	GLuint exponent = (_value >> 10) & 0x1f;
+	GLuint mantissa = _value & 0x3ff;
+	GLuint bits;
+	if(exponent == 0x1f)
+		bits = sign | 0x7f800000u | (mantissa << 13);
+	else if(exponent != 0)
+		bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+	else {
+		// Zero or subnormal: mantissa * 2^-24
+		float v = static_cast<float>(mantissa) * (1.0f / 16777216.0f);
+		memcpy(&bits, &v, sizeof(bits));
+		bits |= sign;
+	}
+	float result;
+	memcpy(&result, &bits, sizeof(result));
+	return result;
+}
+
+void gpupro::packHalf(const float* _in, GLushort* _out, size_t _count)
+{
+	size_t i = 0;
+#ifdef GPUPRO_SSE2
+	// The same algorithm as floatToHalf() with masks instead of branches.
+	const __m128i f16Max = _mm_set1_epi32((127 + 16) << 23);
+	const __m128i minNormal = _mm_set1_epi32((127 - 14) << 23);
+	const __m128i subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+	const __m128i normalBias = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+	const __m128i nanBit = _mm_set1_epi32(0x200);
+	const __m128i infinity = _mm_set1_epi32(0x7c00);
+	const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)));
+	auto convert = [&](__m128 _f) {
+		__m128 sign = _mm_and_ps(_f, signMask);
+		__m128 absF = _mm_xor_ps(_f, sign);
+		__m128i absI = _mm_castps_si128(absF);
+		__m128i isNaN = _mm_castps_si128(_mm_cmpunord_ps(absF, absF));
+		__m128i isRegular = _mm_cmpgt_epi32(f16Max, absI);
+		__m128i special = _mm_or_si128(_mm_and_si128(isNaN, nanBit), infinity);
+		__m128i isSubnormal = _mm_cmpgt_epi32(minNormal, absI);
+		__m128i subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absF, _mm_castsi128_ps(subnormalMagic))), subnormalMagic);
+		__m128i mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absI, 31 - 13), 31);
+		__m128i normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absI, normalBias), mantissaOdd), 13);
+		__m128i regular = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+		__m128i result = _mm_or_si128(_mm_and_si128(isRegular, regular), _mm_andnot_si128(isRegular, special));
+		// The arithmetic shift fills the upper bits of negative values,
+		// such that the signed saturation of the pack keeps them.
+		return _mm_or_si128(result, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+	};
+	for(; i + 8 <= _count; i += 8)
+	{
+		__m128i a = convert(_mm_loadu_ps(_in + i));
+		__m128i b = convert(_mm_loadu_ps(_in + i + 4));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(_out + i), _mm_packs_epi32(a, b));
+	}
+#endif
+	for(; i < _count; ++i)
+		_out[i] = floatToHalf(_in[i]);
+}
+
+void gpupro::packNormal(const float* _in, GLuint* _out, size_t _count)
+{
+	for(size_t i = 0; i < _count; ++i, _in += 4)
+	{
+		GLuint bits = 0;
+		for(int c = 0; c < 4; ++c)
+		{
+			float maxV = c < 3 ? 511.0f : 1.0f;
+			GLuint mask = c < 3 ? 0x3ff : 0x3;
+			float v = std::min(std::max(-1.0f, _in[c]), 1.0f);
+			GLint q = static_cast<GLint>(std::nearbyint(v * maxV));
+			bits |= (static_cast<GLuint>(q) & mask) << (c * 10);
+		}
+		_out[i] = bits;
+	}
+}
+
+// Signed values use the GL 4.2 rule: -128 and -127 both map to -1.
+void gpupro::unpack(const GLbyte* _in, float* _out, size_t _count)
+{
+	for(size_t i = 0; i < _count; ++i)
+		_out[i] = std::max(_in[i] / 127.0f, -1.0f);
+}
+
+void gpupro::unpack(const GLubyte* _in, float* _out, size_t _count)
+{
+	for(size_t i = 0; i < _count; ++i)
+		_out[i] = _in[i] / 255.0f;
+}
+
+void gpupro::unpack(const GLshort* _in, float* _out, size_t _count)
+{
+	for(size_t i = 0; i < _count; ++i)
+		_out[i] = std::max(_in[i] / 32767.0f, -1.0f);
+}
+
+void gpupro::unpack(const GLushort* _in, float* _out, size_t _count)
+{
+	for(size_t i = 0; i < _count; ++i)
+		_out[i] = _in[i] / 65535.0f;
+}
+
+void gpupro::unpackHalf(const GLushort* _in, float* _out, size_t _count)
+{
+	for(size_t i = 0; i < _count; ++i)
+		_out[i] = halfToFloat(_in[i]);
+}
+
+void gpupro::unpackNormal(const GLuint* _in, float* _out, size_t _count)
+{
+	for(size_t i = 0; i < _count; ++i, _out += 4)
+	{
+		// Sign extend the fields by shifting them to the top.
+		GLuint bits = _in[i];
+		_out[0] = std::max(static_cast<float>(static_cast<GLint>(bits << 22) >> 22) / 511.0f, -1.0f);
+		_out[1] = std::max(static_cast<float>(static_cast<GLint>(bits << 12) >> 22) / 511.0f, -1.0f);
+		_out[2] = std::max(static_cast<float>(static_cast<GLint>(bits << 2) >> 22) / 511.0f, -1.0f);
+		_out[3] = std::max(static_cast<float>(static_cast<GLint>(bits) >> 30), -1.0f);
+	}
+}
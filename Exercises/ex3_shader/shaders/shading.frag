@@ -13,20 +13,12 @@ layout(binding = 0) uniform sampler2D tex_albedo;
 layout(binding = 1) uniform sampler2D tex_normal;
 layout(binding = 2) uniform sampler2D tex_specular;
 
-// *** Buffers and Uniforms ***
-layout(binding = 0, std140) uniform ubo_transform
-{
-	mat4 u_worldViewProjection;
-	mat4 u_world;
-	vec3 u_cameraPos;
-	float u_swirl;
-};
+#include "transform.glsl"
 
-layout(binding = 1) uniform ubo_shading
+layout(binding = 1, std140) uniform ubo_shading
 {
 	vec4 u_lightPosition[8];
 	vec4 u_lightColor[8];
-	bool u_normalMapping;
 };
 
 uniform vec3 LIGHT_DIR = vec3(0.267261242, 0.801783726, -0.534522484);
@@ -46,17 +38,18 @@ void main()
 {
 	// Normal mapping: load the local normal from the texture and transform
 	// it to global space.
-	// If u_normalMapping is false disable normal mapping.
+	// The program is compiled twice, NORMAL_MAPPING is only defined in the
+	// variant with normal mapping.
 	vec3 normal;
-	if(u_normalMapping)
-	{
-		// The normal map is loaded as signed texture. It is already in [-1,1]
-		// as required. The x and y components of the normal map align with
-		// in_tangent and in_bitangent and z with the original in_normal.
-		// TODO: Implement normal mapping here.
-		normal = in_normal;
-	} else
-		normal = in_normal;
+#ifdef NORMAL_MAPPING
+	// The normal map is loaded as signed texture. It is already in [-1,1]
+	// as required. The x and y components of the normal map align with
+	// in_tangent and in_bitangent and z with the original in_normal.
+	// TODO: Implement normal mapping here.
+	normal = in_normal;
+#else
+	normal = in_normal;
+#endif
 	normal = normalize(normal);
 	
 	// Compute and read properties which are required for lighting.
@@ -1,26 +1,6 @@
 #version 440 core
 
-// *** In and Outputs ***
-layout(location = 0) in vec3 in_position;
-layout(location = 1) in vec3 in_normal;
-layout(location = 2) in vec3 in_tangent;
-layout(location = 3) in vec3 in_bitangent;
-layout(location = 4) in vec2 in_texCoord;
-
-layout(location = 0) out vec3 out_position;
-layout(location = 1) out vec3 out_normal;
-// TODO: add tangent and bitanget output
-layout(location = 4) out vec2 out_texCoord;
-
-// *** Buffers and Uniforms ***
-layout(binding = 0, std140) uniform ubo_transform
-{
-	mat4 u_worldViewProjection;
-	mat4 u_world;
-	vec3 u_cameraPos;
-	float u_swirl;
-};
-
+#include "vertex.glsl"
 
 // *** Entry point ***
 void main()
@@ -0,0 +1,10 @@
+// Shared by all stages. Included by the ShaderPreprocessor.
+
+// *** Buffers and Uniforms ***
+layout(binding = 0, std140) uniform ubo_transform
+{
+	mat4 u_worldViewProjection;
+	mat4 u_world;
+	vec3 u_cameraPos;
+	float u_swirl;
+};
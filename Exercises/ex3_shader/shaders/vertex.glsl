@@ -0,0 +1,20 @@
+// In and outputs of all vertex shaders. Included by the ShaderPreprocessor.
+
+// *** In and Outputs ***
+layout(location = 0) in vec3 in_position;
+layout(location = 1) in vec3 in_normal;
+layout(location = 2) in vec3 in_tangent;
+layout(location = 3) in vec3 in_bitangent;
+layout(location = 4) in vec2 in_texCoord;
+
+layout(location = 0) out vec3 out_position;
+layout(location = 1) out vec3 out_normal;
+// TODO: add tangent and bitangent output
+layout(location = 4) out vec2 out_texCoord;
+// Separable programs must redeclare the used built-in outputs.
+out gl_PerVertex
+{
+	vec4 gl_Position;
+};
+
+#include "transform.glsl"
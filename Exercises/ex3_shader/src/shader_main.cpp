@@ -22,9 +22,31 @@ struct ShadingUniforms
 {
 	vec4 lightPosition[8];
 	vec4 lightColor[8];
-	unsigned normalMapping;
 };
 
+// The GLSL declarations of ubo_transform (transform.glsl) and ubo_shading
+// (shading.frag). The structs above are uploaded as they are, so they must
+// match. This does not compile otherwise.
+typedef BlockLayout<BlockStandard::STD140, mat4, mat4, vec3, float> TransformBlock;
+typedef BlockLayout<BlockStandard::STD140, vec4[8], vec4[8]> ShadingBlock;
+GPUPRO_STATIC_ASSERT_BLOCK_MEMBER(TransformBlock, 0, TransformUniforms, worldViewProjection);
+GPUPRO_STATIC_ASSERT_BLOCK_MEMBER(TransformBlock, 1, TransformUniforms, world);
+GPUPRO_STATIC_ASSERT_BLOCK_MEMBER(TransformBlock, 2, TransformUniforms, cameraPosition);
+GPUPRO_STATIC_ASSERT_BLOCK_MEMBER(TransformBlock, 3, TransformUniforms, swirl);
+GPUPRO_STATIC_ASSERT_BLOCK_SIZE(TransformBlock, TransformUniforms);
+GPUPRO_STATIC_ASSERT_BLOCK_MEMBER(ShadingBlock, 0, ShadingUniforms, lightPosition);
+GPUPRO_STATIC_ASSERT_BLOCK_MEMBER(ShadingBlock, 1, ShadingUniforms, lightColor);
+GPUPRO_STATIC_ASSERT_BLOCK_SIZE(ShadingBlock, ShadingUniforms);
+
+// The three vertex buffers of a Model (see Model::bind()).
+typedef VertexLayout<vec3, 0, 0, VertexMember<0, vec3, 0>> PositionLayout;
+typedef VertexLayout<OBJLoader::TangentSpace, 1, 0,
+	GPUPRO_VERTEX_MEMBER(1, OBJLoader::TangentSpace, normal),
+	GPUPRO_VERTEX_MEMBER(2, OBJLoader::TangentSpace, tangent),
+	GPUPRO_VERTEX_MEMBER(3, OBJLoader::TangentSpace, bitangent)
+> TangentSpaceLayout;
+typedef VertexLayout<vec2, 2, 0, VertexMember<4, vec2, 0>> TexCoordLayout;
+
 const vec3 lightColors[8] = {
 	vec3(1.0, 1.0, 1.0),
 	vec3(0.1, 0.1, 0.5),
@@ -39,6 +61,8 @@ const vec3 lightColors[8] = {
 
 static bool s_normalMapping = true;
 static bool s_swirl = false;
+static bool s_printProfile = false;
+static bool s_exportTimeline = false;
 static void keyFunc(GLFWwindow* _window, int _key, int, int _action, int)
 {
 	if(_action == GLFW_PRESS)
@@ -47,6 +71,8 @@ static void keyFunc(GLFWwindow* _window, int _key, int, int _action, int)
 		{
 			case GLFW_KEY_N: s_normalMapping = !s_normalMapping; break;
 			case GLFW_KEY_S: s_swirl = !s_swirl; break;
+			case GLFW_KEY_P: s_printProfile = true; break;
+			case GLFW_KEY_T: s_exportTimeline = true; break;
 			case GLFW_KEY_ESCAPE: glfwSetWindowShouldClose(_window, GLFW_TRUE);
 		}
 	}
@@ -88,11 +114,18 @@ int main()
 		<< "  Escape:     quit program\n"
 		<< "  N:          toggle normal map\n"
 		<< "  S:          toggle swirl transformation of the teapot\n"
+		<< "  P:          print GPU times and shader invocations\n"
+		<< "  T:          write the CPU/GPU timeline to timeline.json\n"
 		<< "  Mouse:      change camera rotation (press left button)\n"
 		<< "              zoom (wheel)\n\n";
 
+	// Record the startup and all frames. Open the exported file in
+	// chrome://tracing or ui.perfetto.dev.
+	Timeline::setEnabled(true);
 	try {
+		Timeline::beginZone("DemoWindow");
 		DemoWindow window(1024, 1024, "Ex3: Shaders and States");
+		Timeline::endZone();
 		OGLContext context(OGLContext::DebugSeverity::LOW);
 		window.setKeyCallback(keyFunc);
 		window.setMouseCallback(mouseFunc);
@@ -126,20 +159,26 @@ int main()
 		objectShadingWithSwirlMaskedPipe = objectShadingWithSwirlPipe;
 		// TODO: make the settings to the stencil buffer comparison and the face winding.
 
-		// glClear() uses the current state, which is a bad thing if some writes
-		// are disabled or masked. So use a simple default pipeline for that.
-		Pipeline clearState;
-
 		// Load shaders
-		Shader simpleVert(Shader::Type::VERTEX, "shaders/simple.vert");
-		Shader swirlVert(Shader::Type::VERTEX, "shaders/swirl.vert");
-		Shader shadingFrag(Shader::Type::FRAGMENT, "shaders/shading.frag");
-		Program standardShader(simpleVert, shadingFrag);
-		Program swirlShader(swirlVert, shadingFrag);
-		setStencilPipe.shader = &standardShader;
-		planeShadingPipe.shader = &standardShader;
-		objectShadingWithSwirlPipe.shader = &swirlShader;
-		objectShadingWithSwirlMaskedPipe.shader = &swirlShader;
+		// Linked programs are stored in the cache directory. Later starts
+		// load the binaries instead of compiling the sources again.
+		ProgramCache::setDirectory("shadercache");
+		// Normal mapping is a compile time feature of shading.frag. Each
+		// variant is a specialized program without a dynamic branch:
+		// [0] without and [1] with normal mapping.
+		const ShaderDefines normalMapping[2] = {ShaderDefines(), {{"NORMAL_MAPPING", ""}}};
+		// Every stage is a separable program. The ProgramPipelines below
+		// combine them, so each fragment shader variant is linked once and
+		// not again for every vertex shader.
+		ProgramVariants simpleVert({{Shader::Type::VERTEX, "shaders/simple.vert"}}, true);
+		ProgramVariants swirlVert({{Shader::Type::VERTEX, "shaders/swirl.vert"}}, true);
+		ProgramVariants shadingFrag({{Shader::Type::FRAGMENT, "shaders/shading.frag"}}, true);
+		// The driver compiles all variants in the background while the
+		// textures are loaded.
+		simpleVert.request(ShaderDefines());
+		swirlVert.request(ShaderDefines());
+		for(const ShaderDefines& defines : normalMapping)
+			shadingFrag.request(defines);
 
 		// Load the textures
 		Texture metalDiff(InternalFormat::RGB8, "model/brushed_metal_diff.png");
@@ -148,28 +187,68 @@ int main()
 		Texture cobbleDiff(InternalFormat::RGB8, "model/cobblestone_diff.png");
 		Texture cobbleNorm(InternalFormat::RGB8S, "model/cobblestone_norm.png");
 		Texture cobbleSpec(InternalFormat::RGB8, "model/cobblestone_spec.png");
-		// Create and set a sampler
-		SamplerState niceSampler(SamplerState::Filter::LINEAR, SamplerState::Filter::LINEAR, SamplerState::Filter::LINEAR, 8.0f);
+		// Get a shared sampler. Equal descriptors return the same object.
+		std::shared_ptr<SamplerState> niceSampler = SamplerCache::get(SamplerState::Filter::LINEAR, SamplerState::Filter::LINEAR, SamplerState::Filter::LINEAR, 8.0f);
 		for(int i = 0; i < 3; ++i)
 		{
-			planeShadingPipe.samplerState[i] = &niceSampler;
-			objectShadingWithSwirlPipe.samplerState[i] = &niceSampler;
-			objectShadingWithSwirlMaskedPipe.samplerState[i] = &niceSampler;
+			planeShadingPipe.samplerState[i] = niceSampler.get();
+			objectShadingWithSwirlPipe.samplerState[i] = niceSampler.get();
+			objectShadingWithSwirlMaskedPipe.samplerState[i] = niceSampler.get();
 		}
 
-		// Create the vertex format
-		std::vector<VertexAttribute> attributes({
-			{0, 0, 3, VertexAttribute::Type::FLOAT, GL_FALSE, 0, 0},	// Position
-			{1, 1, 3, VertexAttribute::Type::FLOAT, GL_FALSE, 0, 0},	// Normal
-			{2, 1, 3, VertexAttribute::Type::FLOAT, GL_FALSE, 12, 0},	// Tangent
-			{3, 1, 3, VertexAttribute::Type::FLOAT, GL_FALSE, 24, 0},	// Bitangent
-			{4, 2, 2, VertexAttribute::Type::FLOAT, GL_FALSE, 0, 0}		// TexCoord
+		// Create the vertex format from the buffer layouts of the Model.
+		std::shared_ptr<VertexFormat> vertexFormat = makeVertexFormat<PositionLayout, TangentSpaceLayout, TexCoordLayout>();
+		setStencilPipe.vertexFormat = vertexFormat.get();
+		planeShadingPipe.vertexFormat = vertexFormat.get();
+		objectShadingWithSwirlPipe.vertexFormat = vertexFormat.get();
+		objectShadingWithSwirlMaskedPipe.vertexFormat = vertexFormat.get();
+
+		// Wait for the programs (throws on compile errors).
+		ProgramPipeline standardShader[2];
+		ProgramPipeline swirlShader[2];
+		for(int i = 0; i < 2; ++i)
+		{
+			Program& fragmentShader = shadingFrag.get(normalMapping[i]);
+			standardShader[i].setStage(Shader::Type::VERTEX, &simpleVert.get(ShaderDefines()));
+			standardShader[i].setStage(Shader::Type::FRAGMENT, &fragmentShader);
+			swirlShader[i].setStage(Shader::Type::VERTEX, &swirlVert.get(ShaderDefines()));
+			swirlShader[i].setStage(Shader::Type::FRAGMENT, &fragmentShader);
+		}
+		// The uniform buffers are filled from the C++ structs. Check once
+		// that their layout matches the blocks in the shader.
+		const Program& shadingProgram = shadingFrag.get(normalMapping[1]);
+		shadingProgram.validateBlock<TransformUniforms>("ubo_transform", {
+			GPUPRO_BLOCK_MEMBER(TransformUniforms, worldViewProjection, "u_worldViewProjection"),
+			GPUPRO_BLOCK_MEMBER(TransformUniforms, world, "u_world"),
+			GPUPRO_BLOCK_MEMBER(TransformUniforms, cameraPosition, "u_cameraPos"),
+			GPUPRO_BLOCK_MEMBER(TransformUniforms, swirl, "u_swirl")
+		});
+		shadingProgram.validateBlock<ShadingUniforms>("ubo_shading", {
+			GPUPRO_BLOCK_MEMBER(ShadingUniforms, lightPosition, "u_lightPosition[0]"),
+			GPUPRO_BLOCK_MEMBER(ShadingUniforms, lightColor, "u_lightColor[0]")
 		});
-		VertexFormat vertexFormat(attributes);
-		setStencilPipe.vertexFormat = &vertexFormat;
-		planeShadingPipe.vertexFormat = &vertexFormat;
-		objectShadingWithSwirlPipe.vertexFormat = &vertexFormat;
-		objectShadingWithSwirlMaskedPipe.vertexFormat = &vertexFormat;
+		setStencilPipe.programs = &standardShader[0];
+		planeShadingPipe.programs = &standardShader[1];
+		objectShadingWithSwirlPipe.programs = &swirlShader[1];
+		objectShadingWithSwirlMaskedPipe.programs = &swirlShader[1];
+
+		// All pipelines are complete now. Compile them for faster switching,
+		// once per shader variant: [0] without and [1] with normal mapping.
+		// Changes to the Pipeline objects after this point have no effect on
+		// the compiled versions.
+		// Switching between them only exchanges the changed stages.
+		auto compileWithShader = [](Pipeline _pipeline, ProgramPipeline& _programs) -> CompiledPipeline {
+			_pipeline.programs = &_programs;
+			return CompiledPipeline(_pipeline);
+		};
+		CompiledPipeline objectShadingWithSwirl[2] = {
+			compileWithShader(objectShadingWithSwirlPipe, swirlShader[0]),
+			compileWithShader(objectShadingWithSwirlPipe, swirlShader[1])
+		};
+		CompiledPipeline planeShading[2] = {
+			compileWithShader(planeShadingPipe, standardShader[0]),
+			compileWithShader(planeShadingPipe, standardShader[1])
+		};
 
 		// Load objects
 		OBJLoader objloader;
@@ -181,14 +260,34 @@ int main()
 		// Create a uniform buffers
 		Buffer transformUBO(Buffer::Type::UNIFORM, sizeof(TransformUniforms), 1, Buffer::Usage::SUB_DATA_UPDATE);
 		Buffer shadingUBO(Buffer::Type::UNIFORM, sizeof(ShadingUniforms), 1, Buffer::Usage::SUB_DATA_UPDATE);
+
+		// Collect the resources of each material. Applying a table needs only
+		// a few multi-bind calls.
+		BindingTable metalMaterial;
+		BindingTable cobbleMaterial;
+		for(BindingTable* material : {&metalMaterial, &cobbleMaterial})
+		{
+			material->setUniformBuffer(0, &transformUBO);
+			material->setUniformBuffer(1, &shadingUBO);
+		}
+		metalMaterial.setTexture(0, &metalDiff);
+		metalMaterial.setTexture(1, &metalNorm);
+		metalMaterial.setTexture(2, &metalSpec);
+		cobbleMaterial.setTexture(0, &cobbleDiff);
+		cobbleMaterial.setTexture(1, &cobbleNorm);
+		cobbleMaterial.setTexture(2, &cobbleSpec);
 	
 		// Main loop
 		float animation = 0.0f;
+		RenderGraph graph;
+		// Every render graph pass is a GPU scope and counts its shader
+		// invocations (if the driver supports that).
+		GpuProfiler::setEnabled(true);
+		if(PipelineStatistics::isSupported())
+			PipelineStatistics::setEnabled(true);
 		while(window.isOpen())
 		{
-			context.setState(clearState);
-			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-
+			Timeline::beginZone("Record frame");
 			// Fill uniform buffers
 			TransformUniforms uniforms;
 			uniforms.cameraPosition = vec3(sin(s_camPhi) * cos(s_camTheta), sin(s_camTheta), cos(s_camPhi) * cos(s_camTheta)) * s_camZoom;
@@ -208,36 +307,64 @@ int main()
 				float intensity = sin(animation * 34.31f + i) * 0.2f + 2.5f;
 				lightUniforms.lightColor[i] = vec4(intensity * lightColors[i], 0.0f);
 			}
-			lightUniforms.normalMapping = s_normalMapping;
 			shadingUBO.subDataUpdate(0, sizeof(ShadingUniforms), &lightUniforms);
 
+			// Describe the frame. The first pass clears the backbuffer, so no
+			// extra clear pipeline is required.
+			graph.reset();
+			RenderGraph::ResourceHandle backbuffer = graph.importBackbuffer(1024, 1024);
+
 			// Draw the scene
-			transformUBO.bindAsUniformBuffer(0);
-			shadingUBO.bindAsUniformBuffer(1);
-			context.setState(objectShadingWithSwirlPipe);
-			teapot.bind(0, 1, 2);
-			metalDiff.bindAsTexture(0);
-			metalNorm.bindAsTexture(1);
-			metalSpec.bindAsTexture(2);
-			teapot.draw();
+			graph.addPass("Object", RenderGraph::PassType::GRAPHICS, [&]() {
+				context.setState(objectShadingWithSwirl[s_normalMapping]);
+				context.setBindings(metalMaterial);
+				teapot.bind(0, 1, 2);
+				teapot.draw();
+			}).colorTarget(backbuffer, 0, RenderGraph::LoadOp::CLEAR)
+				.depthStencilTarget(backbuffer, RenderGraph::LoadOp::CLEAR);
 
-			// TODO: Draw the mirror plane into the stencil buffer using setStencilPipe.
+			// TODO: Add a pass which draws the mirror plane into the stencil buffer using setStencilPipe.
 
 			// TODO: Mirror the camera at xz-plane. Therefore, you need to multiply
-			// the 'viewProjection' with a reflection matrix and update the transformUBO.
+			// the 'viewProjection' with a reflection matrix and update the transformUBO
+			// inside the next pass.
 
-			// TODO: Draw mirrored object using the objectShadingWithSwirlMaskedPipe.
+			// TODO: Add a pass which draws the mirrored object using the objectShadingWithSwirlMaskedPipe.
 
 			// Draw the plane itself
-			context.setState(planeShadingPipe);
-			plane.bind(0, 1, 2);
-			cobbleDiff.bindAsTexture(0);
-			cobbleNorm.bindAsTexture(1);
-			cobbleSpec.bindAsTexture(2);
-			plane.draw();
+			graph.addPass("Plane", RenderGraph::PassType::GRAPHICS, [&]() {
+				context.setState(planeShading[s_normalMapping]);
+				context.setBindings(cobbleMaterial);
+				plane.bind(0, 1, 2);
+				plane.draw();
+			}).colorTarget(backbuffer, 0)
+				.depthStencilTarget(backbuffer);
+
+			graph.compile();
+			{
+				GPU_SCOPE("Scene");
+				graph.execute(context);
+			}
+			Timeline::endZone();
 
 			// Input handling
-			window.handleEventsAndPresent();
+			context.endFrame();
+			if(s_printProfile)
+			{
+				GpuProfiler::printStatistics();
+				if(PipelineStatistics::isEnabled())
+					PipelineStatistics::printStatistics();
+				s_printProfile = false;
+			}
+			if(s_exportTimeline)
+			{
+				Timeline::exportChromeTrace("timeline.json");
+				s_exportTimeline = false;
+			}
+			{
+				CPU_ZONE("Present");
+				window.handleEventsAndPresent();
+			}
 			animation += 0.002f;
 		}
 	} catch(std::exception _ex) {
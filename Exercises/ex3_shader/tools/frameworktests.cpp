@@ -0,0 +1,748 @@
+// Checks parts of the framework on the NullGL backend, so no GPU and no
+// window are required. Each failed check is reported with its line; the
+// exit code is the number of failures.
+//
+// Usage: frameworktests [-benchmark]
+//	-benchmark	Also measure the CPU time of state changes
+#include <gpuproframework.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace gpupro;
+
+static int s_numChecks = 0;
+static int s_numFailures = 0;
+
+#define CHECK(_condition) check(_condition, #_condition, __LINE__)
+
+static void check(bool _condition, const char* _text, int _line)
+{
+	++s_numChecks;
+	if(!_condition)
+	{
+		++s_numFailures;
+		std::cerr << "ERR: Check failed in line " << _line << ": " << _text << '\n';
+	}
+}
+
+static bool rangesEqual(const IntervalSet& _set, std::initializer_list<IntervalSet::Range> _expected)
+{
+	if(_set.ranges().size() != _expected.size())
+		return false;
+	auto it = _set.ranges().begin();
+	for(auto& r : _expected)
+	{
+		if(it->begin != r.begin || it->end != r.end)
+			return false;
+		++it;
+	}
+	return true;
+}
+
+static void testIntervalSet()
+{
+	IntervalSet set;
+	set.insert(10, 10);		// Empty ranges are ignored
+	set.insert(12, 8);
+	CHECK(set.empty());
+
+	set.insert(10, 20);
+	set.insert(30, 40);
+	set.insert(0, 5);
+	CHECK(rangesEqual(set, {{0, 5}, {10, 20}, {30, 40}}));
+	// Adjacent on both sides
+	set.insert(5, 10);
+	CHECK(rangesEqual(set, {{0, 20}, {30, 40}}));
+	// Contained
+	set.insert(32, 35);
+	CHECK(rangesEqual(set, {{0, 20}, {30, 40}}));
+	// Overlapping the end of one and the begin of the next range
+	set.insert(50, 60);
+	set.insert(38, 52);
+	CHECK(rangesEqual(set, {{0, 20}, {30, 60}}));
+	// Gap of one byte stays
+	set.insert(61, 70);
+	CHECK(rangesEqual(set, {{0, 20}, {30, 60}, {61, 70}}));
+	// Covering everything
+	set.insert(0, 100);
+	CHECK(rangesEqual(set, {{0, 100}}));
+	CHECK(set.coveredSize() == 100);
+
+	set.clear();
+	set.insert(0, 4);
+	set.insert(8, 12);
+	set.insert(16, 20);
+	CHECK(set.coveredSize() == 12);
+	set.insert(2, 17);
+	CHECK(rangesEqual(set, {{0, 20}}));
+}
+
+// Replays the uploads of the buffer under test into a CPU copy, such that
+// the GPU content can be compared byte by byte.
+static GLuint s_uploadBuffer = 0;
+static std::vector<unsigned char> s_uploadedContent;
+static std::vector<IntervalSet::Range> s_uploads;
+static PFNGLNAMEDBUFFERSUBDATAPROC s_nullNamedBufferSubData = nullptr;
+
+static void APIENTRY recordNamedBufferSubData(GLuint _buffer, GLintptr _offset, GLsizeiptr _size, const void* _data)
+{
+	if(_buffer == s_uploadBuffer)
+	{
+		memcpy(s_uploadedContent.data() + _offset, _data, _size);
+		s_uploads.push_back(IntervalSet::Range{_offset, _offset + _size});
+	}
+	s_nullNamedBufferSubData(_buffer, _offset, _size, _data);
+}
+
+static void testShadowFlush()
+{
+	struct Element { float value[4]; };
+	const GLuint NUM_ELEMENTS = 64;
+	std::vector<Element> initial(NUM_ELEMENTS);
+	for(GLuint i = 0; i < NUM_ELEMENTS; ++i)
+		for(int c = 0; c < 4; ++c)
+			initial[i].value[c] = float(i * 4 + c);
+
+	Buffer buffer(Buffer::Type::SHADER_STORAGE, sizeof(Element), NUM_ELEMENTS, Buffer::Usage::SUB_DATA_UPDATE, initial.data());
+	buffer.enableShadow(0.5f, initial.data());
+	s_uploadBuffer = buffer.glID();
+	s_uploadedContent.assign(reinterpret_cast<unsigned char*>(initial.data()), reinterpret_cast<unsigned char*>(initial.data() + NUM_ELEMENTS));
+	s_uploads.clear();
+	s_nullNamedBufferSubData = glad_glNamedBufferSubData;
+	glad_glNamedBufferSubData = recordNamedBufferSubData;
+
+	// Scattered writes: adjacent elements, a write inside an element and
+	// one adjacent to its end.
+	Element e = {{-1.0f, -2.0f, -3.0f, -4.0f}};
+	buffer.write(3, e);
+	buffer.write(4, e);
+	buffer.write(10, e);
+	float partial = 42.0f;
+	buffer.write(10 * sizeof(Element) + 8, sizeof(float), &partial);
+	buffer.write(11 * sizeof(Element), sizeof(float), &partial);
+	buffer.flushShadow();
+	CHECK(s_uploads.size() == 2);
+	if(s_uploads.size() == 2)
+	{
+		CHECK(s_uploads[0].begin == 3 * sizeof(Element) && s_uploads[0].end == 5 * sizeof(Element));
+		CHECK(s_uploads[1].begin == 10 * sizeof(Element) && s_uploads[1].end == 11 * sizeof(Element) + 4);
+	}
+	CHECK(memcmp(s_uploadedContent.data(), &buffer.read<Element>(0), buffer.size()) == 0);
+	CHECK(buffer.read<Element>(10).value[2] == 42.0f);
+	CHECK(buffer.read<Element>(11).value[0] == 42.0f);
+	CHECK(buffer.shadowStats().numUploads == 2);
+	CHECK(buffer.shadowStats().bytesUploaded == 3 * sizeof(Element) + 4);
+
+	// Nothing dirty, nothing uploaded
+	s_uploads.clear();
+	buffer.flushShadow();
+	CHECK(s_uploads.empty());
+
+	// More than half of the buffer dirty: one full upload
+	for(GLuint i = 0; i < NUM_ELEMENTS; i += 2)
+		buffer.write(i, e);
+	buffer.write(NUM_ELEMENTS - 1, e);
+	buffer.flushShadow();
+	CHECK(s_uploads.size() == 1);
+	if(s_uploads.size() == 1)
+		CHECK(s_uploads[0].begin == 0 && s_uploads[0].end == buffer.size());
+	CHECK(memcmp(s_uploadedContent.data(), &buffer.read<Element>(0), buffer.size()) == 0);
+
+	// Invalid writes are rejected without touching the shadow copy.
+	s_uploads.clear();
+	const uint64_t numWrites = buffer.shadowStats().numWrites;
+	struct Large { Element a, b; } large = {};
+	buffer.write(0, large);
+	buffer.write(NUM_ELEMENTS, e);
+	buffer.write(buffer.size() - 4, 8, &partial);
+	buffer.write(16, -8, &partial);
+	buffer.write(16, 0, &partial);
+	buffer.flushShadow();
+	CHECK(s_uploads.empty());
+	CHECK(buffer.shadowStats().numWrites == numWrites);
+	CHECK(memcmp(s_uploadedContent.data(), &buffer.read<Element>(0), buffer.size()) == 0);
+
+	glad_glNamedBufferSubData = s_nullNamedBufferSubData;
+}
+
+// The std430 stride of a struct is not its sizeof; it must be given.
+struct Particle { glm::vec3 position; float mass; glm::vec3 velocity; };
+typedef BlockLayout<BlockStandard::STD430, glm::vec3, float, glm::vec3> ParticleLayout;
+namespace gpupro {
+	template<> struct Std430Stride<Particle> { static const size_t value = ParticleLayout::SIZE; };
+}
+static_assert(Std430Stride<float>::value == 4 && Std430Stride<glm::vec3>::value == 16 && Std430Stride<glm::vec4>::value == 16, "Vector stride");
+static_assert(Std430Stride<glm::mat3>::value == 48 && Std430Stride<glm::dvec3>::value == 32, "Matrix stride");
+static_assert(sizeof(Particle) == 28 && Std430Stride<Particle>::value == 32, "Struct stride");
+
+static void testGpuVector()
+{
+	GpuVector<glm::vec4> vector(Buffer::Type::SHADER_STORAGE, 2);
+	vector.push_back(glm::vec4(1.0f));
+	vector.push_back(glm::vec4(2.0f));
+	vector.push_back(glm::vec4(3.0f));
+	CHECK(vector.size() == 3 && vector.capacity() == 4);
+
+	NullGL::reset();
+	vector.set(2, glm::vec4(4.0f));
+	CHECK(NullGL::numCalls() == 1);
+	// Within the capacity but behind the end
+	NullGL::reset();
+	vector.set(3, glm::vec4(4.0f));
+	CHECK(NullGL::numCalls() == 0);
+}
+
+// Runs the vector path of a converter (whole blocks of 8) and the scalar
+// path (one value per call) and compares the results bit for bit.
+template<typename T, typename Converter>
+static bool vectorMatchesScalar(const std::vector<float>& _values, Converter _convert)
+{
+	std::vector<T> vectorResult(_values.size());
+	std::vector<T> scalarResult(_values.size());
+	_convert(_values.data(), vectorResult.data(), _values.size());
+	for(size_t i = 0; i < _values.size(); ++i)
+		_convert(&_values[i], &scalarResult[i], 1);
+	return memcmp(vectorResult.data(), scalarResult.data(), _values.size() * sizeof(T)) == 0;
+}
+
+static void testVertexPacking()
+{
+	const float inf = std::numeric_limits<float>::infinity();
+	const float nan = std::numeric_limits<float>::quiet_NaN();
+	const float denormal = std::numeric_limits<float>::denorm_min();
+	std::vector<float> values = {
+		0.0f, -0.0f, 1.0f, -1.0f, 0.5f, -0.5f, 0.25f, 0.75f,
+		// Clamping of normalized integers at both ends
+		1.0001f, -1.0001f, 2.0f, -2.0f, 1e30f, -1e30f, inf, -inf,
+		nan, -nan, denormal, -denormal, 1e-40f, -1e-40f, 1e-38f, 1.17549435e-38f,
+		// Ties of the integer rounding (x.5 after scaling)
+		0.5f / 127.0f, 1.5f / 127.0f, 0.5f / 255.0f, 2.5f / 255.0f, 0.5f / 32767.0f, 0.5f / 65535.0f, 1.0f / 3.0f, -1.0f / 3.0f,
+		// Half: largest finite, overflow, rounding to infinity, subnormals and ties
+		65504.0f, -65504.0f, 65519.0f, 65520.0f, 70000.0f, -1e10f, 6.1035156e-5f, 6.0975552e-5f,
+		5.9604645e-8f, 2.9802322e-8f, 2.9802326e-8f, -1e-8f, 1.00048828125f, 1.00146484375f, 2049.0f, -2051.0f,
+	};
+	// Every value in every lane
+	std::vector<float> shifted;
+	for(size_t offset = 0; offset < 8; ++offset)
+		for(size_t i = 0; i < values.size(); ++i)
+			shifted.push_back(values[(i + offset) % values.size()]);
+
+	CHECK(vectorMatchesScalar<GLbyte>(shifted, [](const float* _in, GLbyte* _out, size_t _count) { pack(_in, _out, _count); }));
+	CHECK(vectorMatchesScalar<GLubyte>(shifted, [](const float* _in, GLubyte* _out, size_t _count) { pack(_in, _out, _count); }));
+	CHECK(vectorMatchesScalar<GLshort>(shifted, [](const float* _in, GLshort* _out, size_t _count) { pack(_in, _out, _count); }));
+	CHECK(vectorMatchesScalar<GLushort>(shifted, [](const float* _in, GLushort* _out, size_t _count) { pack(_in, _out, _count); }));
+	CHECK(vectorMatchesScalar<GLushort>(shifted, packHalf));
+
+	// Spot checks of the expected values
+	GLbyte snorm[8];
+	pack(values.data() + 8, snorm, 8);
+	CHECK(snorm[0] == 127 && snorm[1] == -127 && snorm[6] == 127 && snorm[7] == -127);
+	GLushort unorm[8];
+	pack(values.data() + 8, unorm, 8);
+	CHECK(unorm[0] == 65535 && unorm[1] == 0 && unorm[6] == 65535 && unorm[7] == 0);
+	GLushort half[8];
+	packHalf(values.data() + 32, half, 8);
+	CHECK(half[0] == 0x7bff && half[1] == 0xfbff && half[2] == 0x7bff && half[3] == 0x7c00 && half[4] == 0x7c00 && half[5] == 0xfc00);
+	packHalf(values.data() + 16, half, 8);
+	CHECK((half[0] & 0x7fff) == 0x7e00 && (half[1] & 0x7fff) == 0x7e00 && half[2] == 0 && half[3] == 0x8000);
+}
+
+// GL calls of a typical load and frame, counted separately.
+struct CallCounts
+{
+	GLuint64 load;
+	GLuint64 loadBinds;			///< glBindBuffer/glBindTexture/glBindVertexArray while loading
+	GLuint64 frame;
+	GLuint64 frameBinds;
+	GLuint64 createdBuffers;
+	GLuint64 createdTextures;
+};
+
+static GLuint64 countBinds()
+{
+	return NullGL::numCalls(NullGL::Function::glBindBuffer)
+		+ NullGL::numCalls(NullGL::Function::glBindTexture)
+		+ NullGL::numCalls(NullGL::Function::glBindVertexArray);
+}
+
+static CallCounts countLoadAndFrame()
+{
+	CallCounts counts;
+	NullGL::reset();
+	const float vertices[4 * 5] = {0.0f};
+	const GLuint indices[6] = {0, 1, 2, 2, 1, 3};
+	std::vector<unsigned char> pixels(64 * 64 * 4, 128);
+	Buffer vertexBuffer(Buffer::Type::VERTEX, sizeof(float) * 5, 4, Buffer::Usage(), vertices);
+	Buffer indexBuffer(Buffer::Type::INDEX, sizeof(GLuint), 6, Buffer::Usage(), indices);
+	Buffer uniformBuffer(Buffer::Type::UNIFORM, 256, 1, Buffer::Usage::SUB_DATA_UPDATE);
+	Texture texture(Texture::Layout::TEX_2D, 64, 64, InternalFormat::RGBA8, 1);
+	texture.setData(0, 0, SetDataFormat::RGBA, SetDataType::UINT8, pixels.data());
+	VertexAttribute position = {0, 0, 3, VertexAttribute::Type::FLOAT, GL_FALSE, 0, 0};
+	VertexAttribute texCoord = {1, 0, 2, VertexAttribute::Type::FLOAT, GL_FALSE, sizeof(float) * 3, 0};
+	VertexFormat format({position, texCoord});
+	counts.load = NullGL::numCalls();
+	counts.loadBinds = countBinds();
+	counts.createdBuffers = NullGL::numCalls(NullGL::Function::glCreateBuffers) + NullGL::numCalls(NullGL::Function::glGenBuffers);
+	counts.createdTextures = NullGL::numCalls(NullGL::Function::glCreateTextures) + NullGL::numCalls(NullGL::Function::glGenTextures);
+
+	NullGL::reset();
+	float uniforms[64] = {1.0f};
+	uniformBuffer.subDataUpdate(0, sizeof(uniforms), uniforms);
+	glBindVertexArray(format.glID());
+	vertexBuffer.bindAsVertexBuffer(0);
+	indexBuffer.bindAsIndexBuffer();
+	uniformBuffer.bindAsUniformBuffer(0);
+	texture.bindAsTexture(0);
+	glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr);
+	counts.frame = NullGL::numCalls();
+	counts.frameBinds = countBinds();
+	return counts;
+}
+
+// The DSA path must issue no bind-to-edit calls and fewer calls than the
+// fallback, which must still create the same objects.
+static void testDirectStateAccess()
+{
+	CHECK(hasDSA());
+	const CallCounts dsa = countLoadAndFrame();
+	GLAD_GL_VERSION_4_5 = 0;
+	const CallCounts fallback = countLoadAndFrame();
+	GLAD_GL_VERSION_4_5 = 1;
+	std::cerr << "INF: GL calls with DSA (bind fallback): load " << dsa.load << " (" << fallback.load
+		<< "), frame " << dsa.frame << " (" << fallback.frame << ")\n";
+
+	CHECK(dsa.loadBinds == 0);
+	CHECK(fallback.loadBinds > 0);
+	CHECK(dsa.load < fallback.load);
+	CHECK(dsa.createdBuffers == 3 && fallback.createdBuffers == 3);
+	CHECK(dsa.createdTextures == 1 && fallback.createdTextures == 1);
+	// One VAO and one index buffer bind remain for drawing.
+	CHECK(dsa.frameBinds == 2);
+	CHECK(dsa.frame < fallback.frame);
+}
+
+// Tables are recorded without GL calls; applying one binds each range of
+// changed slots once.
+static void testBindingTable(OGLContext& _context)
+{
+	Buffer buffer(Buffer::Type::SHADER_STORAGE, 16, 4, Buffer::Usage());
+	BindingTable table;
+	NullGL::reset();
+	table.setShaderStorageBuffer(0, &buffer);
+	table.setShaderStorageBuffer(1, &buffer, 16, 16);
+	table.setUniformBuffer(BindingTable::MAX_BUFFERS - 1, &buffer);
+	CHECK(NullGL::numCalls() == 0);
+
+	_context.setBindings(table);
+	CHECK(NullGL::numCalls(NullGL::Function::glBindBuffersRange) == 2);
+	NullGL::reset();
+	_context.setBindings(table);
+	CHECK(NullGL::numCalls() == 0);
+	_context.setBindings(BindingTable());
+	CHECK(NullGL::numCalls(NullGL::Function::glBindBuffersRange) == 2);
+}
+
+// Four pipelines which differ in rasterizer, depth and blend state.
+static std::vector<Pipeline> benchmarkPipelines()
+{
+	std::vector<Pipeline> pipelines(4);
+	pipelines[0].depthStencil.depthTest = true;
+	pipelines[1].depthStencil.depthTest = true;
+	pipelines[1].rasterizer.cullMode = RasterizerState::CullMode::BACK;
+	pipelines[2].blendState.enableBlending = BlendState::BlendMode::BLEND;
+	pipelines[2].blendState.buf[0].srcColorFactor = BlendState::BlendFactor::SRC_ALPHA;
+	pipelines[2].blendState.buf[0].dstColorFactor = BlendState::BlendFactor::INV_SRC_ALPHA;
+	pipelines[2].depthStencil.depthWrite = false;
+	pipelines[3].rasterizer.colorWrite = false;
+	return pipelines;
+}
+
+// Switching between equal pipelines must not issue a single call, a switch
+// only the calls for the differing states.
+static void testStateFilter(OGLContext& _context)
+{
+	std::vector<Pipeline> pipelines = benchmarkPipelines();
+	CompiledPipeline first(pipelines[0]);
+	CompiledPipeline firstAgain(pipelines[0]);
+	CompiledPipeline second(pipelines[1]);
+	CHECK(first.hash() == firstAgain.hash());
+	CHECK(first.hash() != second.hash());
+
+	_context.setState(first);
+	NullGL::reset();
+	_context.setState(firstAgain);
+	CHECK(NullGL::numCalls() == 0);
+	_context.setState(second);
+	CHECK(NullGL::numCalls() == 2);
+	CHECK(NullGL::numCalls(NullGL::Function::glEnable) == 1);
+	CHECK(NullGL::numCalls(NullGL::Function::glCullFace) == 1);
+}
+
+struct RecordedCall
+{
+	NullGL::Function function;
+	std::vector<GLuint64> arguments;
+};
+
+static std::vector<RecordedCall> recordedCalls()
+{
+	std::vector<RecordedCall> calls;
+	for(auto& call : NullGL::calls())
+	{
+		const GLuint64* arguments = NullGL::arguments(call);
+		calls.push_back(RecordedCall{call.function, std::vector<GLuint64>(arguments, arguments + call.numArguments)});
+	}
+	return calls;
+}
+
+// Replaying a command buffer must issue the same calls as submitting the
+// commands directly. Only the uniform buffer (name and data pointer of the
+// upload) differs.
+static void testCommandBuffer(OGLContext& _context)
+{
+	const GLushort indices[6] = {0, 1, 2, 2, 1, 3};
+	Buffer vertexBuffer(Buffer::Type::VERTEX, sizeof(float) * 5, 16, Buffer::Usage());
+	Buffer indexBuffer(Buffer::Type::INDEX, sizeof(GLushort), 6, Buffer::Usage(), indices);
+	Buffer storageBuffer(Buffer::Type::SHADER_STORAGE, 16, 4, Buffer::Usage());
+	Buffer uniformBuffer(Buffer::Type::UNIFORM, 1, 512, Buffer::Usage::SUB_DATA_UPDATE);
+	std::vector<Pipeline> pipelines = benchmarkPipelines();
+	CompiledPipeline opaque(pipelines[1]);
+	CompiledPipeline blended(pipelines[2]);
+	BindingTable table;
+	table.setShaderStorageBuffer(2, &storageBuffer);
+	const glm::vec4 color(1.0f, 0.5f, 0.25f, 1.0f);
+	const glm::mat4 transform(2.0f);
+
+	CommandBuffer commands;
+	CHECK(commands.empty() && commands.size() == 0);
+	commands.draw(Model::DrawPrimitiveType::POINTS, 1);
+	// Header and the 20 bytes of arguments padded to 8 bytes
+	CHECK(commands.size() == 32);
+	commands.reset();
+	CHECK(commands.empty());
+
+	commands.setState(opaque);
+	commands.setBindings(table);
+	commands.bindVertexBuffer(0, vertexBuffer, 4);
+	commands.bindIndexBuffer(indexBuffer);
+	commands.setUniforms(0, transform);
+	commands.setUniforms(1, color);
+	commands.drawIndexed(Model::DrawPrimitiveType::TRIANGLES, 3, 3, 1, 2, 5);
+	commands.setState(blended);
+	commands.draw(Model::DrawPrimitiveType::LINES, 4, 2);
+
+	// The first execution creates the uniform buffer of the command buffer.
+	_context.setState(pipelines[0]);
+	_context.setBindings(BindingTable());
+	_context.execute(commands);
+
+	_context.setState(pipelines[0]);
+	_context.setBindings(BindingTable());
+	NullGL::reset();
+	_context.execute(commands);
+	const std::vector<RecordedCall> replayed = recordedCalls();
+
+	_context.setState(pipelines[0]);
+	_context.setBindings(BindingTable());
+	NullGL::reset();
+	unsigned char uniforms[256 + sizeof(color)];
+	memcpy(uniforms, &transform, sizeof(transform));
+	memcpy(uniforms + 256, &color, sizeof(color));
+	uniformBuffer.subDataUpdate(0, sizeof(uniforms), uniforms);
+	_context.setState(opaque);
+	_context.setBindings(table);
+	glBindVertexBuffer(0, vertexBuffer.glID(), 4 * vertexBuffer.elementSize(), vertexBuffer.elementSize());
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer.glID());
+	glBindBufferRange(GL_UNIFORM_BUFFER, 0, uniformBuffer.glID(), 0, sizeof(transform));
+	glBindBufferRange(GL_UNIFORM_BUFFER, 1, uniformBuffer.glID(), 256, sizeof(color));
+	glDrawElementsInstancedBaseVertexBaseInstance(GL_TRIANGLES, 3, GL_UNSIGNED_SHORT, reinterpret_cast<const void*>(3 * sizeof(GLushort)), 2, 1, 5);
+	_context.setState(blended);
+	glDrawArraysInstancedBaseInstance(GL_LINES, 2, 4, 1, 0);
+	const std::vector<RecordedCall> direct = recordedCalls();
+
+	CHECK(replayed.size() == direct.size());
+	if(replayed.size() != direct.size() || replayed.empty())
+		return;
+	CHECK(replayed[0].function == NullGL::Function::glNamedBufferSubData);
+	const GLuint64 replayedUniformBuffer = replayed[0].arguments[0];
+	for(size_t i = 0; i < replayed.size(); ++i)
+	{
+		CHECK(replayed[i].function == direct[i].function);
+		if(replayed[i].function != direct[i].function || replayed[i].arguments.size() != direct[i].arguments.size())
+			continue;
+		// The data pointer of the upload differs.
+		const size_t numArguments = replayed[i].function == NullGL::Function::glNamedBufferSubData ? 3 : replayed[i].arguments.size();
+		bool equal = true;
+		for(size_t a = 0; a < numArguments; ++a)
+		{
+			GLuint64 argument = replayed[i].arguments[a];
+			if(argument == replayedUniformBuffer && direct[i].arguments[a] == uniformBuffer.glID())
+				argument = uniformBuffer.glID();
+			equal = equal && argument == direct[i].arguments[a];
+		}
+		CHECK(equal);
+	}
+}
+
+// A pass without used results is culled, transient textures with disjoint
+// lifetimes share a texture and a storage write before a read emits
+// exactly one barrier.
+static void testRenderGraph(OGLContext& _context)
+{
+	Buffer particles(Buffer::Type::SHADER_STORAGE, 16, 64, Buffer::Usage());
+	Buffer histogram(Buffer::Type::SHADER_STORAGE, 4, 64, Buffer::Usage());
+	RenderGraph graph;
+	int numExecuted[5] = {0};
+	auto counter = [&numExecuted](int _pass) { return [&numExecuted, _pass]() { ++numExecuted[_pass]; }; };
+
+	RenderGraph::ResourceHandle particleBuffer = graph.importBuffer("Particles", particles);
+	RenderGraph::ResourceHandle histogramBuffer = graph.importBuffer("Histogram", histogram);
+	RenderGraph::ResourceHandle unused = graph.createTexture("Unused", 64, 64, InternalFormat::RGBA8);
+	graph.markOutput(histogramBuffer);
+	graph.addPass("Simulate", RenderGraph::PassType::COMPUTE, counter(0))
+		.writeBuffer(particleBuffer);
+	graph.addPass("Debug", RenderGraph::PassType::COMPUTE, counter(1))
+		.readBuffer(particleBuffer, RenderGraph::BufferAccess::STORAGE)
+		.writeImage(unused);
+	graph.addPass("Count", RenderGraph::PassType::COMPUTE, counter(2))
+		.readBuffer(particleBuffer, RenderGraph::BufferAccess::STORAGE)
+		.writeBuffer(histogramBuffer);
+	graph.addPass("Normalize", RenderGraph::PassType::COMPUTE, counter(3))
+		.readBuffer(particleBuffer, RenderGraph::BufferAccess::STORAGE)
+		.readBuffer(histogramBuffer, RenderGraph::BufferAccess::STORAGE)
+		.writeBuffer(histogramBuffer);
+	graph.compile();
+	CHECK(graph.stats().numPasses == 4 && graph.stats().numCulledPasses == 1);
+	NullGL::reset();
+	graph.execute(_context);
+	CHECK(numExecuted[0] == 1 && numExecuted[1] == 0 && numExecuted[2] == 1 && numExecuted[3] == 1);
+	// Simulate -> Count and Count -> Normalize need a barrier each. The
+	// particles read in Normalize are covered by the first one.
+	CHECK(graph.stats().numBarriers == 2);
+	CHECK(NullGL::numCalls(NullGL::Function::glMemoryBarrier) == 2);
+
+	graph.reset();
+	particleBuffer = graph.importBuffer("Particles", particles);
+	graph.addPass("Simulate", RenderGraph::PassType::COMPUTE, counter(0))
+		.writeBuffer(particleBuffer);
+	graph.addPass("Read", RenderGraph::PassType::COMPUTE, counter(1))
+		.readBuffer(particleBuffer, RenderGraph::BufferAccess::STORAGE)
+		.sideEffects();
+	graph.addPass("Read again", RenderGraph::PassType::COMPUTE, counter(2))
+		.readBuffer(particleBuffer, RenderGraph::BufferAccess::STORAGE)
+		.sideEffects();
+	graph.compile();
+	NullGL::reset();
+	graph.execute(_context);
+	CHECK(NullGL::numCalls(NullGL::Function::glMemoryBarrier) == 1);
+	for(auto& call : NullGL::calls())
+		if(call.function == NullGL::Function::glMemoryBarrier)
+			CHECK(NullGL::arguments(call)[0] == GL_SHADER_STORAGE_BARRIER_BIT);
+
+	// A lives in the passes 0-1, B in 1-2 and C in 2-3: A and C can share.
+	graph.reset();
+	RenderGraph::ResourceHandle a = graph.createTexture("A", 32, 32, InternalFormat::RGBA8);
+	RenderGraph::ResourceHandle b = graph.createTexture("B", 32, 32, InternalFormat::RGBA8);
+	RenderGraph::ResourceHandle c = graph.createTexture("C", 32, 32, InternalFormat::RGBA8);
+	RenderGraph::ResourceHandle backbuffer = graph.importBackbuffer(32, 32);
+	graph.addPass("Write A", RenderGraph::PassType::GRAPHICS, counter(0))
+		.colorTarget(a, 0, RenderGraph::LoadOp::CLEAR);
+	graph.addPass("A to B", RenderGraph::PassType::GRAPHICS, counter(1))
+		.sampleTexture(a)
+		.colorTarget(b, 0, RenderGraph::LoadOp::DONT_CARE);
+	graph.addPass("B to C", RenderGraph::PassType::GRAPHICS, counter(2))
+		.sampleTexture(b)
+		.colorTarget(c, 0, RenderGraph::LoadOp::DONT_CARE);
+	graph.addPass("C to backbuffer", RenderGraph::PassType::GRAPHICS, counter(3))
+		.sampleTexture(c)
+		.colorTarget(backbuffer, 0, RenderGraph::LoadOp::DONT_CARE);
+	graph.compile();
+	CHECK(graph.stats().numCulledPasses == 0);
+	CHECK(graph.stats().numTransientTextures == 3 && graph.stats().numPoolTextures == 2);
+	CHECK(graph.texture(a).glID() == graph.texture(c).glID());
+	CHECK(graph.texture(a).glID() != graph.texture(b).glID());
+	// Render targets are coherent, sampling them needs no barrier.
+	CHECK(graph.stats().numBarriers == 0);
+	graph.execute(_context);
+}
+
+// Draws with equal keys must keep their submission order, with one and
+// with several sorting threads.
+static void testDrawQueueOrder(OGLContext& _context)
+{
+	// Above the threshold for sorting in parallel.
+	const GLuint NUM_DRAWS = 40000;
+	CompiledPipeline pipeline((Pipeline()));
+	std::vector<GLuint64> keys(NUM_DRAWS);
+	for(GLuint i = 0; i < NUM_DRAWS; ++i)
+	{
+		// Few distinct values spread over the low, middle and high bytes.
+		GLuint hash = i * 2654435761u;
+		keys[i] = (GLuint64(hash % 7) << 60) | (GLuint64(hash % 13) << 30) | (hash % 5);
+	}
+	std::vector<GLuint> expected(NUM_DRAWS);
+	for(GLuint i = 0; i < NUM_DRAWS; ++i)
+		expected[i] = i;
+	std::stable_sort(expected.begin(), expected.end(), [&keys](GLuint _a, GLuint _b) { return keys[_a] < keys[_b]; });
+
+	for(GLuint numThreads : {1u, 4u})
+	{
+		DrawQueue queue(numThreads);
+		std::vector<GLuint> order;
+		order.reserve(NUM_DRAWS);
+		for(GLuint i = 0; i < NUM_DRAWS; ++i)
+			queue.submit(DrawQueue::Bucket::SOLID, keys[i], pipeline, nullptr, [&order, i]() { order.push_back(i); });
+		queue.execute(_context);
+		CHECK(order == expected);
+	}
+}
+
+// Occlusion query results of the culler test. Queries which are in
+// neither set have no result yet.
+static std::vector<GLuint> s_hiddenQueries;
+static std::vector<GLuint> s_visibleQueries;
+
+static void APIENTRY answerQuery(GLuint _id, GLenum _pname, GLuint* _params)
+{
+	const bool hidden = std::find(s_hiddenQueries.begin(), s_hiddenQueries.end(), _id) != s_hiddenQueries.end();
+	const bool visible = std::find(s_visibleQueries.begin(), s_visibleQueries.end(), _id) != s_visibleQueries.end();
+	if(_pname == GL_QUERY_RESULT_AVAILABLE)
+		*_params = hidden || visible ? GL_TRUE : GL_FALSE;
+	else if(hidden || visible)
+		*_params = visible ? 1 : 0;
+}
+
+static std::vector<GLuint> beginQueryNames()
+{
+	std::vector<GLuint> names;
+	for(auto& call : NullGL::calls())
+		if(call.function == NullGL::Function::glBeginQuery)
+			names.push_back(static_cast<GLuint>(NullGL::arguments(call)[1]));
+	return names;
+}
+
+// The three phases of the occlusion culler: objects known to be hidden are
+// drawn under glBeginConditionalRender, boxes which cross the near plane
+// are never tested and objects without a result are drawn unconditionally.
+static void testOcclusionCuller(OGLContext& _context)
+{
+	PFNGLGETQUERYOBJECTUIVPROC nullGetQueryObjectuiv = glad_glGetQueryObjectuiv;
+	glad_glGetQueryObjectuiv = answerQuery;
+	s_hiddenQueries.clear();
+	s_visibleQueries.clear();
+
+	const glm::mat4 viewProjection = glm::perspective(0.8f, 1.0f, 0.1f, 100.0f)
+		* glm::lookAt(glm::vec3(0.0f, 0.0f, 5.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	OcclusionCuller culler;
+	const GLuint hidden = culler.addObject(glm::vec3(-0.5f), glm::vec3(0.5f));
+	const GLuint atCamera = culler.addObject(glm::vec3(-1.0f, -1.0f, 4.0f), glm::vec3(1.0f, 1.0f, 6.0f));
+	const GLuint unknown = culler.addObject(glm::vec3(1.5f, -0.5f, -0.5f), glm::vec3(2.5f, 0.5f, 0.5f));
+	CompiledPipeline pipeline(benchmarkPipelines()[1]);
+
+	// Records for each draw whether it ran inside a conditional render.
+	bool conditional[3];
+	int numDraws[3];
+	auto frame = [&]() {
+		for(GLuint object : {hidden, atCamera, unknown})
+		{
+			numDraws[object] = 0;
+			culler.submit(object, glm::mat4(1.0f), pipeline, nullptr, [&conditional, &numDraws, object]() {
+				conditional[object] = NullGL::numCalls(NullGL::Function::glBeginConditionalRender)
+					> NullGL::numCalls(NullGL::Function::glEndConditionalRender);
+				++numDraws[object];
+			});
+		}
+		NullGL::reset();
+		culler.execute(_context, viewProjection);
+	};
+
+	// First frame: nothing is known, everything is drawn directly.
+	frame();
+	CHECK(numDraws[hidden] == 1 && !conditional[hidden]);
+	CHECK(numDraws[atCamera] == 1 && !conditional[atCamera]);
+	CHECK(numDraws[unknown] == 1 && !conditional[unknown]);
+	CHECK(culler.stats().numTested == 2 && culler.stats().numConditional == 0);
+	std::vector<GLuint> queries = beginQueryNames();
+	CHECK(queries.size() == 2);
+	if(queries.size() == 2)
+		s_hiddenQueries.push_back(queries[0]);
+
+	// Second frame: the first object was hidden, the third has no result.
+	frame();
+	CHECK(numDraws[hidden] == 1 && conditional[hidden]);
+	CHECK(numDraws[atCamera] == 1 && !conditional[atCamera]);
+	CHECK(numDraws[unknown] == 1 && !conditional[unknown]);
+	CHECK(culler.stats().numTested == 2 && culler.stats().numConditional == 1);
+	CHECK(culler.stats().numHiddenLastFrame == 1);
+	CHECK(NullGL::numCalls(NullGL::Function::glBeginConditionalRender) == 1);
+	CHECK(NullGL::numCalls(NullGL::Function::glBeginQuery) == 2);
+
+	// The query of the second frame says visible: drawn directly again.
+	queries = beginQueryNames();
+	if(queries.size() == 2)
+		s_visibleQueries.push_back(queries[0]);
+	frame();
+	CHECK(numDraws[hidden] == 1 && !conditional[hidden]);
+	CHECK(numDraws[unknown] == 1 && !conditional[unknown]);
+	CHECK(culler.stats().numConditional == 0);
+
+	glad_glGetQueryObjectuiv = nullGetQueryObjectuiv;
+}
+
+// Average CPU time of setState() per switch, with precompiled pipelines
+// and with pipelines compiled on the fly.
+static void benchmarkSetState(OGLContext& _context)
+{
+	const int NUM_SWITCHES = 1 << 20;
+	std::vector<Pipeline> pipelines = benchmarkPipelines();
+	std::vector<CompiledPipeline> compiled;
+	for(auto& pipeline : pipelines)
+		compiled.emplace_back(pipeline);
+
+	// Measure the framework, not the recording.
+	NullGL::setRecording(false);
+	auto start = std::chrono::high_resolution_clock::now();
+	for(int i = 0; i < NUM_SWITCHES; ++i)
+		_context.setState(compiled[i & 3]);
+	auto middle = std::chrono::high_resolution_clock::now();
+	for(int i = 0; i < NUM_SWITCHES; ++i)
+		_context.setState(pipelines[i & 3]);
+	auto end = std::chrono::high_resolution_clock::now();
+	NullGL::setRecording(true);
+
+	std::cerr << "INF: setState() per switch: CompiledPipeline "
+		<< std::chrono::duration<double, std::nano>(middle - start).count() / NUM_SWITCHES << " ns, Pipeline "
+		<< std::chrono::duration<double, std::nano>(end - middle).count() / NUM_SWITCHES << " ns\n";
+}
+
+int main(int _argc, char** _argv)
+{
+	try {
+		OGLContext context(OGLContext::DebugSeverity::HIGH, OGLContext::Backend::NULL_RECORDING);
+
+		testIntervalSet();
+		testShadowFlush();
+		testGpuVector();
+		testVertexPacking();
+		testDirectStateAccess();
+		testBindingTable(context);
+		testStateFilter(context);
+		testCommandBuffer(context);
+		testRenderGraph(context);
+		testDrawQueueOrder(context);
+		testOcclusionCuller(context);
+		if(_argc > 1 && strcmp(_argv[1], "-benchmark") == 0)
+			benchmarkSetState(context);
+	} catch(const std::exception& _e) {
+		std::cerr << "ERR: " << _e.what() << '\n';
+		return 1;
+	}
+
+	std::cerr << "INF: " << s_numChecks - s_numFailures << " of " << s_numChecks << " checks passed.\n";
+	return s_numFailures;
+}
@@ -0,0 +1,90 @@
+#!/usr/bin/env python3
+# Generates framework/include/glfunctions.inl from glad.h.
+#
+# Usage (from Exercises/ex3_shader):
+#   python3 tools/glfunctions.py ../dependencies/glad/include/glad/glad.h > framework/include/glfunctions.inl
+#
+# Each line is GL_FUNCTION(glad pointer, PFN type, parameter classes). The
+# classes are one character for the return value followed by one per
+# parameter (see glfunctions.hpp).
+import re
+import sys
+
+NAME_PARAMS = {
+	'buffer': 'b', 'buffers': 'b', 'readBuffer': 'b', 'writeBuffer': 'b',
+	'texture': 't', 'textures': 't', 'origtexture': 't',
+	'sampler': 's', 'samplers': 's',
+	'framebuffer': 'f', 'framebuffers': 'f', 'readFramebuffer': 'f', 'drawFramebuffer': 'f',
+	'renderbuffer': 'r', 'renderbuffers': 'r',
+	'array': 'v', 'arrays': 'v', 'vaobj': 'v',
+	'pipeline': 'P', 'pipelines': 'P',
+	'program': 'p',
+	'shader': 'h', 'shaders': 'h',
+	'xfb': 'x',
+}
+COUNT_PARAMS = {'n', 'count', 'numAttachments', 'propCount'}
+OFFSET_PARAMS = {'indices', 'indirect', 'pointer'}
+RETURNS = {
+	'glCreateProgram': 'p', 'glCreateShaderProgramv': 'p', 'glCreateShader': 'h',
+	'glFenceSync': 'y',
+	'glMapBuffer': 'm', 'glMapBufferRange': 'm', 'glMapNamedBuffer': 'm', 'glMapNamedBufferRange': 'm',
+}
+
+def classify(func, ptype, pname):
+	pointer = ptype.count('*')
+	const = ptype.startswith('const')
+	base = ptype.replace('const', '').replace('*', '').strip()
+	if base == 'GLsync':
+		return 'y'
+	if base.startswith('GLDEBUGPROC'):
+		return 'n'
+	if base == 'GLuint' and pointer <= 1:
+		if pname in ('id', 'ids'):
+			if 'TransformFeedback' in func: return 'x'
+			if 'Quer' in func: return 'q'
+		if pname in NAME_PARAMS:
+			return NAME_PARAMS[pname]
+	if pointer == 0:
+		if pname in COUNT_PARAMS and base == 'GLsizei': return '#'
+		if pname == 'length' and base == 'GLsizei': return 'l'
+		if pname in ('size', 'imageSize', 'bufSize') and base in ('GLsizeiptr', 'GLsizei'): return 'z'
+		if pname == 'width' and base == 'GLsizei': return 'W'
+		if pname == 'height' and base == 'GLsizei': return 'H'
+		if pname == 'depth' and base == 'GLsizei': return 'D'
+		if pname == 'format' and base == 'GLenum': return 'F'
+		if pname == 'type' and base == 'GLenum': return 'T'
+		return '-'
+	if not const:
+		return '*'
+	if base == 'GLchar':
+		return 'S' if pointer == 2 else 'c'
+	if pname in OFFSET_PARAMS and base == 'void':
+		return 'o'
+	return 'd'
+
+def main():
+	text = open(sys.argv[1]).read()
+	types = {}
+	for m in re.finditer(r'typedef (.+?) \(APIENTRYP (PFN\w+)\)\((.*?)\);', text):
+		types[m.group(2)] = (m.group(1).strip(), m.group(3))
+	print('// Generated by tools/glfunctions.py from glad.h (do not edit).')
+	print('')
+	for m in re.finditer(r'^GLAPI (PFN\w+) (glad_(\w+));', text, re.M):
+		ptype, glad, func = m.groups()
+		ret, params = types[ptype]
+		classes = RETURNS.get(func, '-')
+		plist = [p.strip() for p in params.split(',')] if params.strip() not in ('', 'void') else []
+		has_count = False
+		pclasses = []
+		for p in plist:
+			pm = re.match(r'(.*?)([A-Za-z_]\w*)$', p)
+			c = classify(func, pm.group(1).replace(' *', '*').strip(), pm.group(2))
+			pclasses.append(c)
+			has_count = has_count or c == '#'
+		# Constant arrays of plain values with a count parameter
+		for i, p in enumerate(plist):
+			if pclasses[i] == 'd' and has_count and 'Uniform' not in func and 'void' not in p:
+				pclasses[i] = 'a'
+		print('GL_FUNCTION(%s, %s, "%s")' % (glad, ptype, classes + ''.join(pclasses)))
+
+main()
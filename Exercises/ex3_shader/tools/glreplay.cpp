@@ -0,0 +1,108 @@
+// Replays a trace captured with gpupro::GLTrace and reports per-frame and
+// per-function timings.
+//
+// Usage: glreplay <trace> [-loops N] [-finish] [-calls] [-top N]
+//	-loops N	Repeat all frames after the loading frame N times (default 1)
+//	-finish		Call glFinish() after each frame to include the GPU time
+//	-calls		Measure every single call (adds overhead)
+//	-top N		Number of functions in the report (default 20)
+#include "../../shared/demowindow.hpp"
+#include <gltrace.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+int main(int _argc, char** _argv)
+{
+	if(_argc < 2) {
+		std::cerr << "Usage: glreplay <trace> [-loops N] [-finish] [-calls] [-top N]\n";
+		return 1;
+	}
+	int loops = 1;
+	int top = 20;
+	bool finish = false;
+	bool callTiming = false;
+	for(int i = 2; i < _argc; ++i)
+	{
+		if(strcmp(_argv[i], "-loops") == 0 && i + 1 < _argc) loops = std::max(1, atoi(_argv[++i]));
+		else if(strcmp(_argv[i], "-top") == 0 && i + 1 < _argc) top = atoi(_argv[++i]);
+		else if(strcmp(_argv[i], "-finish") == 0) finish = true;
+		else if(strcmp(_argv[i], "-calls") == 0) callTiming = true;
+		else std::cerr << "WAR: Unknown option " << _argv[i] << '\n';
+	}
+
+	try {
+		// The trace is loaded first to create a window of the captured size.
+		gpupro::GLTraceReplayer trace(_argv[1]);
+		if(!trace.isValid()) return 1;
+		{
+			DemoWindow window(std::max(1, trace.width()), std::max(1, trace.height()), "GL trace replay");
+			if(!gladLoadGL()) {
+				std::cerr << "ERR: Cannot load the GL functions.\n";
+				return 1;
+			}
+			std::cerr << "INF: Replaying on " << glGetString(GL_RENDERER) << " (" << glGetString(GL_VERSION) << ")\n";
+			// Do not measure V-Sync
+			glfwSwapInterval(0);
+
+			trace.setCallTiming(callTiming);
+			const GLuint numFrames = trace.numFrames();
+			std::cerr << "INF: " << numFrames << " frames (frame 0 is the loading)\n";
+
+			double loadTime = trace.replayFrame(0);
+			if(loadTime < 0.0) return 1;
+			if(finish) glFinish();
+			window.handleEventsAndPresent();
+			trace.resetStats();
+
+			std::vector<double> frameTimes;
+			for(int l = 0; l < loops && window.isOpen(); ++l)
+				for(GLuint f = 1; f < numFrames && window.isOpen(); ++f)
+				{
+					double time = trace.replayFrame(f);
+					if(time < 0.0) return 1;
+					if(finish) {
+						auto start = std::chrono::high_resolution_clock::now();
+						glFinish();
+						time += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+					}
+					frameTimes.push_back(time);
+					window.handleEventsAndPresent();
+				}
+
+			std::cout << std::fixed << std::setprecision(3);
+			std::cout << "Loading: " << loadTime << " ms\n";
+			if(!frameTimes.empty())
+			{
+				double sum = 0.0;
+				for(double t : frameTimes) sum += t;
+				std::sort(frameTimes.begin(), frameTimes.end());
+				std::cout << "Frames: " << frameTimes.size()
+					<< "  avg " << sum / frameTimes.size() << " ms"
+					<< "  min " << frameTimes.front() << " ms"
+					<< "  median " << frameTimes[frameTimes.size() / 2] << " ms"
+					<< "  max " << frameTimes.back() << " ms\n";
+			}
+
+			auto stats = trace.callStats();
+			std::cout << "\n" << std::setw(40) << std::left << "Function" << std::right
+				<< std::setw(12) << "calls" << std::setw(14) << "total ms" << std::setw(12) << "avg us" << std::setw(12) << "max us" << '\n';
+			for(size_t i = 0; i < stats.size() && int(i) < top; ++i)
+			{
+				std::cout << std::setw(40) << std::left << gpupro::glFunctionName(stats[i].function) << std::right
+					<< std::setw(12) << stats[i].numCalls
+					<< std::setw(14) << stats[i].totalTime
+					<< std::setw(12) << stats[i].totalTime * 1000.0 / stats[i].numCalls
+					<< std::setw(12) << stats[i].maxTime * 1000.0 << '\n';
+			}
+		}
+	} catch(const std::exception& _e) {
+		std::cerr << "ERR: " << _e.what() << '\n';
+		return 1;
+	}
+	return 0;
+}